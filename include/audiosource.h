@@ -0,0 +1,136 @@
+//+--------------------------------------------------------------------------
+//
+// File:        audiosource.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Something other than the microphone for the sound analyzer to
+//    listen to.  Normally it reads from I2S, but given an AudioSource
+//    (see SoundAnalyzer::SetAudioSource) it takes its samples from that
+//    instead, and everything after the read is the same.  The native
+//    build uses this to replay recordings through the analyzer, and
+//    ToneAudioSource makes a known test signal on the chip or off it.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+class AudioSource
+{
+  public:
+
+    virtual ~AudioSource() = default;
+
+    // Read
+    //
+    // Up to cSamples samples, at the analyzer's sampling rate and as the I2S driver would deliver them, waiting for
+    // them if need be.  Returns how many there were, which is fewer only once the source has run dry.
+
+    virtual size_t Read(int16_t * pSamples, size_t cSamples) = 0;
+};
+
+// ToneAudioSource
+//
+// A mix of sine waves and noise that never runs out, optionally pulsed so that it has a beat: at each beat the
+// level jumps to full and then dies away.
+
+class ToneAudioSource : public AudioSource
+{
+    struct Tone
+    {
+        double hz;
+        double amplitude;
+        double phase;
+    };
+
+    const double      _sampleRate;
+    std::vector<Tone> _tones;
+    double            _noise = 0.0;
+    double            _beatSeconds = 0.0;
+    double            _decayPerSecond = 0.0;
+    uint64_t          _iSample = 0;
+    uint32_t          _seed = 1337;
+
+    // Noise from its own generator, so the signal is the same from run to run whatever else uses random()
+
+    double Noise()
+    {
+        _seed = _seed * 1664525 + 1013904223;
+        return (int32_t) _seed / 2147483648.0;
+    }
+
+  public:
+
+    explicit ToneAudioSource(double sampleRate)
+        : _sampleRate(sampleRate)
+    {
+    }
+
+    // Amplitudes are fractions of full scale, and all of them together shouldn't add up to more than 1
+
+    ToneAudioSource & AddTone(double hz, double amplitude)
+    {
+        _tones.push_back({ hz, amplitude, 0.0 });
+        return *this;
+    }
+
+    ToneAudioSource & SetNoise(double amplitude)
+    {
+        _noise = amplitude;
+        return *this;
+    }
+
+    // Beats per minute, and how quickly each beat dies away; a bpm of 0 leaves the level steady
+
+    ToneAudioSource & SetPulse(double bpm, double decayPerSecond = 8.0)
+    {
+        _beatSeconds = bpm > 0.0 ? 60.0 / bpm : 0.0;
+        _decayPerSecond = decayPerSecond;
+        return *this;
+    }
+
+    size_t Read(int16_t * pSamples, size_t cSamples) override
+    {
+        for (size_t i = 0; i < cSamples; i++, _iSample++)
+        {
+            double sample = _noise * Noise();
+            for (auto & tone : _tones)
+            {
+                sample += tone.amplitude * sin(tone.phase);
+                tone.phase = fmod(tone.phase + 2 * M_PI * tone.hz / _sampleRate, 2 * M_PI);
+            }
+
+            if (_beatSeconds > 0.0)
+                sample *= exp(-fmod(_iSample / _sampleRate, _beatSeconds) * _decayPerSecond);
+
+            pSamples[i] = (int16_t) std::max(-32768.0, std::min(32767.0, sample * 32767.0));
+        }
+        return cSamples;
+    }
+};
@@ -0,0 +1,247 @@
+//+--------------------------------------------------------------------------
+//
+// File:        colorkernels.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Color operations on whole runs of CRGB at a time: scale, saturating
+//    add, blend, palette lookup and blur.  Each gives exactly the same
+//    bytes as doing the same to one pixel at a time with FastLED's
+//    CRGB::nscale8, +=, nblend and friends (with FastLED's default
+//    FASTLED_SCALE8_FIXED and FASTLED_BLEND_FIXED).
+//
+//    Scale, add and blend do the same thing to every byte, so they
+//    don't care where one pixel ends and the next begins, and work four
+//    bytes at a time in 32-bit words: the even and odd bytes of a word
+//    are multiplied in separate 16-bit lanes, and saturating adds handle
+//    the carry out of each byte by hand.  Any bytes before the first
+//    word boundary or after the last are done one at a time.  A span and
+//    its source must be equally aligned for the word loop to run, which
+//    rows of the same buffer, or of two buffers the same shape, are.
+//
+//    The native build's --kernelbench checks every kernel against the
+//    scalar FastLED operations and times both.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+
+namespace ColorKernel
+{
+    constexpr uint32_t kEvenBytes = 0x00FF00FF;
+    constexpr uint32_t kLow7Bits  = 0x7F7F7F7F;
+    constexpr uint32_t kHighBits  = 0x80808080;
+
+    inline uint32_t LoadWord(const uint8_t * p)
+    {
+        uint32_t w;
+        memcpy(&w, __builtin_assume_aligned(p, 4), sizeof(w));
+        return w;
+    }
+
+    inline void StoreWord(uint8_t * p, uint32_t w)
+    {
+        memcpy(__builtin_assume_aligned(p, 4), &w, sizeof(w));
+    }
+
+    // Scale8, QAdd8 and Blend8 are scale8, qadd8 and blend8 as FastLED defines them; the Word versions do the same
+    // to each of the four bytes in a word
+
+    inline uint8_t Scale8(uint8_t b, uint16_t scalePlusOne)
+    {
+        return (b * scalePlusOne) >> 8;
+    }
+
+    inline uint32_t Scale8Word(uint32_t w, uint16_t scalePlusOne)
+    {
+        return (((w & kEvenBytes) * scalePlusOne) >> 8 & kEvenBytes) | (((w >> 8) & kEvenBytes) * scalePlusOne & ~kEvenBytes);
+    }
+
+    inline uint8_t QAdd8(uint8_t a, uint8_t b)
+    {
+        unsigned sum = a + b;
+        return sum > 255 ? 255 : sum;
+    }
+
+    inline uint32_t QAdd8Word(uint32_t a, uint32_t b)
+    {
+        uint32_t sum      = (a & kLow7Bits) + (b & kLow7Bits);
+        uint32_t overflow = ((a & b) | ((a | b) & sum)) & kHighBits;
+        return (sum ^ ((a ^ b) & kHighBits)) | ((overflow >> 7) * 0xFF);
+    }
+
+    // blend8 is (a * 256 + b + (b - a) * amount) / 256, which is the two products below, and neither their sum
+    // nor either of them can be more than 255 * 257, so each fits its 16-bit lane
+
+    inline uint8_t Blend8(uint8_t a, uint8_t b, uint16_t amountOfA, uint16_t amountOfB)
+    {
+        return (a * amountOfA + b * amountOfB) >> 8;
+    }
+
+    inline uint32_t Blend8Word(uint32_t a, uint32_t b, uint16_t amountOfA, uint16_t amountOfB)
+    {
+        uint32_t even = ((a & kEvenBytes) * amountOfA + (b & kEvenBytes) * amountOfB) >> 8 & kEvenBytes;
+        uint32_t odd  = (((a >> 8) & kEvenBytes) * amountOfA + ((b >> 8) & kEvenBytes) * amountOfB) & ~kEvenBytes;
+        return even | odd;
+    }
+
+    // ForEachByte
+    //
+    // Runs byteOp(dst, src) on each of cb bytes, or wordOp on whole words of them where it can
+
+    template <typename ByteOp, typename WordOp>
+    inline void ForEachByte(uint8_t * pDst, const uint8_t * pSrc, size_t cb, ByteOp byteOp, WordOp wordOp)
+    {
+        if ((((uintptr_t) pDst ^ (uintptr_t) pSrc) & 3) == 0)
+        {
+            for (; cb && ((uintptr_t) pDst & 3); cb--, pDst++, pSrc++)
+                *pDst = byteOp(*pDst, *pSrc);
+
+            for (; cb >= 4; cb -= 4, pDst += 4, pSrc += 4)
+                StoreWord(pDst, wordOp(LoadWord(pDst), LoadWord(pSrc)));
+        }
+
+        for (; cb; cb--, pDst++, pSrc++)
+            *pDst = byteOp(*pDst, *pSrc);
+    }
+}
+
+// ScaleSpan
+//
+// CRGB::nscale8(scale) on count pixels, in place or from src into dst
+
+inline void ScaleSpan(CRGB * dst, const CRGB * src, size_t count, uint8_t scale)
+{
+    using namespace ColorKernel;
+    const uint16_t scalePlusOne = scale + 1;
+
+    if (dst != src)
+        memcpy(dst, src, count * sizeof(CRGB));
+
+    ForEachByte((uint8_t *) dst, (const uint8_t *) dst, count * sizeof(CRGB),
+                [scalePlusOne](uint8_t d, uint8_t)   { return Scale8(d, scalePlusOne);     },
+                [scalePlusOne](uint32_t d, uint32_t) { return Scale8Word(d, scalePlusOne); });
+}
+
+inline void ScaleSpan(CRGB * pixels, size_t count, uint8_t scale)
+{
+    ScaleSpan(pixels, pixels, count, scale);
+}
+
+// FadeSpanToBlackBy
+//
+// CRGB::fadeToBlackBy(fade) on count pixels
+
+inline void FadeSpanToBlackBy(CRGB * pixels, size_t count, uint8_t fade)
+{
+    ScaleSpan(pixels, count, 255 - fade);
+}
+
+// AddSpan
+//
+// dst[i] += src[i], saturating each channel at 255 like CRGB's operator+=
+
+inline void AddSpan(CRGB * dst, const CRGB * src, size_t count)
+{
+    using namespace ColorKernel;
+
+    ForEachByte((uint8_t *) dst, (const uint8_t *) src, count * sizeof(CRGB),
+                [](uint8_t d, uint8_t s)   { return QAdd8(d, s);     },
+                [](uint32_t d, uint32_t s) { return QAdd8Word(d, s); });
+}
+
+// BlendSpan
+//
+// nblend(dst[i], src[i], amountOfSrc) on count pixels
+
+inline void BlendSpan(CRGB * dst, const CRGB * src, size_t count, fract8 amountOfSrc)
+{
+    using namespace ColorKernel;
+
+    if (amountOfSrc == 0)
+        return;
+    if (amountOfSrc == 255)
+    {
+        memmove(dst, src, count * sizeof(CRGB));
+        return;
+    }
+
+    const uint16_t amountOfDst = 256 - amountOfSrc;
+    const uint16_t amountOfSrcPlusOne = amountOfSrc + 1;
+
+    ForEachByte((uint8_t *) dst, (const uint8_t *) src, count * sizeof(CRGB),
+                [=](uint8_t d, uint8_t s)   { return Blend8(d, s, amountOfDst, amountOfSrcPlusOne);     },
+                [=](uint32_t d, uint32_t s) { return Blend8Word(d, s, amountOfDst, amountOfSrcPlusOne); });
+}
+
+// dst[i] = blend(src1[i], src2[i], amountOfSrc2), like FastLED's blend() for arrays
+
+inline void BlendSpan(CRGB * dst, const CRGB * src1, const CRGB * src2, size_t count, fract8 amountOfSrc2)
+{
+    if (dst != src1)
+        memmove(dst, src1, count * sizeof(CRGB));
+    BlendSpan(dst, src2, count, amountOfSrc2);
+}
+
+// MapSpan
+//
+// dst[i] = colors[indices[i * indexStride]], for a 256 entry table of colors such as a CRGBPalette256, or a
+// CRGBPalette16 expanded into one, which then gives what ColorFromPalette(palette16, index) does
+
+inline void MapSpan(CRGB * dst, const uint8_t * indices, size_t count, const CRGB * colors, size_t indexStride = 1)
+{
+    for (size_t i = 0; i < count; i++, indices += indexStride)
+        dst[i] = colors[*indices];
+}
+
+// BlurLines
+//
+// Does what blur1d does along each column of a cLines by cPixels block of pixels, whose lines are stride pixels
+// apart, starting from line first.  Rather than walking down each column in turn it works a whole line at a time
+// with the span kernels above, so it wants room for two lines of cPixels in pScratch.
+
+inline void BlurLines(CRGB * pLines, size_t cLines, size_t cPixels, size_t stride, size_t first, fract8 amount, CRGB * pScratch)
+{
+    const uint8_t keep = 255 - amount;
+    const uint8_t seep = amount >> 1;
+
+    CRGB * pCarry = pScratch;
+    CRGB * pPart  = pScratch + cPixels;
+
+    for (size_t i = first; i < cLines; i++)
+    {
+        CRGB * pLine = pLines + i * stride;
+
+        ScaleSpan(pPart, pLine, cPixels, seep);
+        ScaleSpan(pLine, cPixels, keep);
+        if (i > first)
+            AddSpan(pLine, pCarry, cPixels);
+        if (i)
+            AddSpan(pLine - stride, pPart, cPixels);
+        std::swap(pCarry, pPart);
+    }
+}
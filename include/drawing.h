@@ -28,4 +28,6 @@
 //
 //---------------------------------------------------------------------------
 
-void IRAM_ATTR DrawLoopTaskEntry(void *);
\ No newline at end of file
+void IRAM_ATTR DrawLoopTaskEntry(void *);
+void PrepareDrawLoop();
+void DrawLoopPass();
\ No newline at end of file
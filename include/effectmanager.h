@@ -77,9 +77,114 @@ class EffectManager
     std::unique_ptr<bool[]> _abEffectEnabled;
     std::shared_ptr<GFXTYPE> * _gfx;
     std::shared_ptr<LEDStripEffect> _ptrRemoteEffect = nullptr;
+    LEDStripEffect * _pDrawnEffect = nullptr;               // The one effect that drew the last frame, if only one did
+
+    // DrawEffect
+    //
+    // Has an effect draw a frame, on both cores if split rendering is on and the effect can be split
+
+    void DrawEffect(LEDStripEffect * pEffect)
+    {
+        #if USE_SPLIT_RENDER
+            g_SplitRenderer.Draw(pEffect);
+        #else
+            pEffect->Draw();
+        #endif
+    }
+
+#if USE_CROSS_FADE_COMPOSITOR
+    // While a cross-fade is under way, each effect draws into its own copy of the channels so that it carries on
+    // from its own last frame, and the output is a blend of the two
+
+    std::unique_ptr<CRGB[]> _apOutgoing[NUM_CHANNELS];
+    std::unique_ptr<CRGB[]> _apIncoming[NUM_CHANNELS];
+    LEDStripEffect *        _pOutgoingEffect = nullptr;
+    uint32_t                _usOutgoingDraw = 0;                 // How long the outgoing effect's Draw last took
+
+    // BeginCrossFade
+    //
+    // Called just before the current effect changes.  The outgoing effect picks up from whatever is showing
+    // now, unless we were already part way through a cross-fade, in which case it picks up from its own frame.
+
+    void BeginCrossFade()
+    {
+        if (_ptrRemoteEffect || !_apOutgoing[0])
+            return;
+
+        for (int i = 0; i < NUM_CHANNELS; i++)
+        {
+            size_t cLEDs = _gfx[i]->GetLEDCount();
+            memcpy(_apOutgoing[i].get(), _pOutgoingEffect ? _apIncoming[i].get() : _gfx[i]->leds, cLEDs * sizeof(CRGB));
+            memcpy(_apIncoming[i].get(), _gfx[i]->leds, cLEDs * sizeof(CRGB));
+        }
+
+        _pOutgoingEffect = _ppEffects[_iCurrentEffect];
+        _usOutgoingDraw  = 0;
+    }
+
+    // EndCrossFade
+    //
+    // Hands the channels back to the incoming effect, with its own last frame in them
+
+    void EndCrossFade()
+    {
+        if (!_ptrRemoteEffect)
+            for (int i = 0; i < NUM_CHANNELS; i++)
+                memcpy(_gfx[i]->leds, _apIncoming[i].get(), _gfx[i]->GetLEDCount() * sizeof(CRGB));
+
+        _pOutgoingEffect = nullptr;
+    }
+
+    // DrawInto
+    //
+    // Has an effect draw a frame on top of its previous one in apBuffers, and returns how long it took
+
+    uint32_t DrawInto(LEDStripEffect * pEffect, std::unique_ptr<CRGB[]> (&apBuffers)[NUM_CHANNELS])
+    {
+        int64_t usStart = esp_timer_get_time();
+
+        for (int i = 0; i < NUM_CHANNELS; i++)
+            memcpy(_gfx[i]->leds, apBuffers[i].get(), _gfx[i]->GetLEDCount() * sizeof(CRGB));
+
+        DrawEffect(pEffect);
+
+        for (int i = 0; i < NUM_CHANNELS; i++)
+            memcpy(apBuffers[i].get(), _gfx[i]->leds, _gfx[i]->GetLEDCount() * sizeof(CRGB));
+
+        return (uint32_t)(esp_timer_get_time() - usStart);
+    }
+
+    // UpdateCrossFade
+    //
+    // Draws both effects and blends them, fraction of the way from the outgoing to the incoming one.  If drawing
+    // both would blow the incoming effect's frame budget, the outgoing one is held on its last frame instead; its
+    // last time is decayed each time that happens so that it gets another try now and then.
+
+    void UpdateCrossFade(float fraction)
+    {
+        LEDStripEffect * pIncoming = _ppEffects[_iCurrentEffect];
+
+        uint32_t usBudget   = MICROS_PER_SECOND / std::max<size_t>(1, pIncoming->DesiredFramesPerSecond());
+        uint32_t usIncoming = DrawInto(pIncoming, _apIncoming);
+
+        if (usIncoming + _usOutgoingDraw <= usBudget)
+            _usOutgoingDraw = DrawInto(_pOutgoingEffect, _apOutgoing);
+        else
+            _usOutgoingDraw -= _usOutgoingDraw / 4;
+
+        fract8 amount = (fract8) constrain(fraction * 256, 0, 255);
+        for (int i = 0; i < NUM_CHANNELS; i++)
+            BlendSpan(_gfx[i]->leds, _apOutgoing[i].get(), _apIncoming[i].get(), _gfx[i]->GetLEDCount(), amount);
+    }
+#endif
 
 public:
     static const uint csFadeButtonSpeed = 15 * 1000;
+
+    // What Init will allocate for the cross-fade, which setup() leaves out of the memory it gives the LED buffers
+
+    static constexpr uint32_t CrossFadeBufferBytes = USE_CROSS_FADE_COMPOSITOR ? 2 * NUM_CHANNELS * NUM_LEDS * sizeof(CRGB) : 0;
+
     static const uint csSmoothButtonSpeed = 60 * 1000;
 
     EffectManager(LEDStripEffect **pEffects, size_t cEffects, std::shared_ptr<GFXTYPE> *gfx)
@@ -310,6 +415,16 @@ public:
         return _ppEffects[_iCurrentEffect];
     }
 
+    // FrameSums
+    //
+    // The pixel totals the effect kept while drawing the last frame on a channel, if it keeps them.  Never during
+    // a cross-fade, since then the frame is a blend of two effects.
+
+    bool FrameSums(int iChannel, PixelSums & sums) const
+    {
+        return _pDrawnEffect && _pDrawnEffect->FrameSums(iChannel, sums);
+    }
+
     const String & GetCurrentEffectName() const
     {
         if (_ptrRemoteEffect)
@@ -327,6 +442,11 @@ public:
             debugW("Invalid index for SetCurrentEffectIndex");
             return;
         }
+
+        #if USE_CROSS_FADE_COMPOSITOR
+            BeginCrossFade();
+        #endif
+
         _iCurrentEffect = i;
         _effectStartTime = millis();
         StartEffect();
@@ -377,6 +497,10 @@ public:
 
     void NextEffect()
     {
+        #if USE_CROSS_FADE_COMPOSITOR
+            BeginCrossFade();
+        #endif
+
         do
         {
             _iCurrentEffect++; //   ... if so advance to next effect
@@ -390,6 +514,10 @@ public:
 
     void PreviousEffect()
     {
+        #if USE_CROSS_FADE_COMPOSITOR
+            BeginCrossFade();
+        #endif
+
         do
         {
             if (_iCurrentEffect == 0)
@@ -418,6 +546,27 @@ public:
 
             //_ppEffects[i]->setAll(0,0,0);
         }
+
+        #if USE_CROSS_FADE_COMPOSITOR
+            for (int i = 0; i < NUM_CHANNELS; i++)
+            {
+                _apOutgoing[i].reset(new (std::nothrow) CRGB[_gfx[i]->GetLEDCount()]);
+                _apIncoming[i].reset(new (std::nothrow) CRGB[_gfx[i]->GetLEDCount()]);
+                if (!_apOutgoing[i] || !_apIncoming[i])
+                {
+                    // BeginCrossFade checks for these, so without them effects just cut from one to the next
+
+                    debugW("Not enough memory for the cross-fade buffers, so effects will change without one");
+                    for (int j = 0; j <= i; j++)
+                    {
+                        _apOutgoing[j].reset();
+                        _apIncoming[j].reset();
+                    }
+                    break;
+                }
+            }
+        #endif
+
         debugV("First Effect: %s", GetCurrentEffectName());
         return true;
     }
@@ -428,50 +577,79 @@ public:
 
     void Update()
     {
+        _pDrawnEffect = nullptr;
+
         if ((_gfx[0])->GetLEDCount() == 0)
             return;
 
+        // Whatever an effect borrowed from frame scratch last frame is free again
+
+        for (int i = 0; i < NUM_CHANNELS; i++)
+            _gfx[i]->Scratch().Reset();
+
         const float msFadeTime = EFFECT_CROSS_FADE_TIME;
 
         CheckEffectTimerExpired();
 
-        // If a remote control effect is set, we draw that, otherwise we draw the regular effect
+        // With the compositor, effect changes blend from one effect to the next at full brightness rather than
+        // going through black, so the fader is left alone
 
-        if (_ptrRemoteEffect)
-            _ptrRemoteEffect->Draw();
-        else
-            _ppEffects[_iCurrentEffect]->Draw(); // Draw the currently active effect
+        #if USE_CROSS_FADE_COMPOSITOR
+            if (_pOutgoingEffect)
+            {
+                uint e = GetTimeUsedByCurrentEffect();
+                if (_ptrRemoteEffect || e >= msFadeTime)
+                {
+                    EndCrossFade();
+                }
+                else
+                {
+                    UpdateCrossFade(e / msFadeTime);
+                    g_Fader = 255;
+                    return;
+                }
+            }
+        #endif
 
-        // If we do indeed have multiple effects (BUGBUG what if only a single enabled?) then we
-        // fade in and out at the appropriate time based on the time remaining/used by the effect
+        // If a remote control effect is set, we draw that, otherwise we draw the regular effect
 
-        if (EffectCount() < 2)
-        {
-            g_Fader = 255;
-            return;
-        }
+        _pDrawnEffect = _ptrRemoteEffect ? _ptrRemoteEffect.get() : _ppEffects[_iCurrentEffect];
+        DrawEffect(_pDrawnEffect);              // Draw the remote control effect if one is set, else the current one
 
-        if (_effectInterval == 0)
-        {
+        #if USE_CROSS_FADE_COMPOSITOR
             g_Fader = 255;
-            return;
-        }
+        #else
+            // If we do indeed have multiple effects (BUGBUG what if only a single enabled?) then we
+            // fade in and out at the appropriate time based on the time remaining/used by the effect
 
-        int r = GetTimeRemainingForCurrentEffect();
-        int e = GetTimeUsedByCurrentEffect();
+            if (EffectCount() < 2)
+            {
+                g_Fader = 255;
+                return;
+            }
 
-        if (e < msFadeTime)
-        {
-            g_Fader = 255 * (e / msFadeTime); // Fade in
-        }
-        else if (r < msFadeTime)
-        {
-            g_Fader = 255 * (r / msFadeTime); // Fade out
-        }
-        else
-        {
-            g_Fader = 255; // No fade, not at start or end
-        }
+            if (_effectInterval == 0)
+            {
+                g_Fader = 255;
+                return;
+            }
+
+            int r = GetTimeRemainingForCurrentEffect();
+            int e = GetTimeUsedByCurrentEffect();
+
+            if (e < msFadeTime)
+            {
+                g_Fader = 255 * (e / msFadeTime); // Fade in
+            }
+            else if (r < msFadeTime)
+            {
+                g_Fader = 255 * (r / msFadeTime); // Fade out
+            }
+            else
+            {
+                g_Fader = 255; // No fade, not at start or end
+            }
+        #endif
     }
 };
 
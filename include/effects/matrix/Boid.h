@@ -66,8 +66,69 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
 #include "Vector.h"
 
+class Boid;
+
+// BoidGrid
+//
+// Uniform grid of the flock by location, with cells the size of the separation radius, so that a boid only has to
+// look at the boids in the cells around it rather than at every boid in the flock.  Boid::flockAll rebuilds it once
+// per frame, before any boid moves.  Its arrays only ever grow, so after the first frame building it doesn't allocate.
+//
+// None of the effects in the table flock today (PatternBounce and PatternFlowField only use the boids' physics), so
+// for now only the native --boidbench calls flock and flockAll.  A flocking effect should use flockAll.
+
+class BoidGrid {
+  public:
+
+    BoidGrid(float cellSize, int width = MATRIX_WIDTH, int height = MATRIX_HEIGHT)
+      : _invCellSize(1.0f / cellSize),
+        _columns(std::max(1, (int) ceilf(width / cellSize))),
+        _rows(std::max(1, (int) ceilf(height / cellSize))),
+        _cellStart(_columns * _rows + 1, 0) {
+    }
+
+    // Sorts the enabled boids by cell (a counting sort, so it's linear in the number of boids)
+    void build(const Boid boids [], uint16_t boidCount);
+
+    // Calls visit(i) for every enabled boid i in the cells that overlap the square of the given radius around
+    // location.  That's a superset of the boids within radius of it, including the boid at location itself.
+    template <typename Visitor>
+    void forEachNear(const PVector & location, float radius, Visitor visit) const {
+      int c0 = column(location.x - radius), c1 = column(location.x + radius);
+      int r0 = row(location.y - radius),    r1 = row(location.y + radius);
+
+      // The cells of one row are adjacent in _order, so each row is a single run
+      for (int r = r0; r <= r1; r++) {
+        uint16_t end = _cellStart[r * _columns + c1 + 1];
+        for (uint16_t k = _cellStart[r * _columns + c0]; k < end; k++)
+          visit(_order[k]);
+      }
+    }
+
+  private:
+
+    float _invCellSize;
+    int _columns;
+    int _rows;
+    std::vector<uint16_t> _cellStart;   // Where each cell's boids start in _order, plus the total at the end
+    std::vector<uint16_t> _order;       // Indices of the enabled boids, sorted by cell
+    std::vector<uint16_t> _cellOf;      // Cell of each boid as of the last build
+
+    // Boids off the edge of the grid go in the nearest edge cell.  Clamping never moves two boids further apart,
+    // so it can't hide a neighbor, it just makes the edge cells a little busier.
+    int column(float x) const {
+      return std::min(_columns - 1, std::max(0, (int) floorf(x * _invCellSize)));
+    }
+
+    int row(float y) const {
+      return std::min(_rows - 1, std::max(0, (int) floorf(y * _invCellSize)));
+    }
+};
+
 class Boid 
 {
   public:
@@ -103,7 +164,7 @@ class Boid
       return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
     }
 
-    void run(Boid boids [], uint8_t boidCount) {
+    void run(Boid boids [], uint16_t boidCount) {
       flock(boids, boidCount);
       update();
       // wrapAroundBorders();
@@ -148,16 +209,91 @@ class Boid
       }
     }
 
-    // We accumulate a new acceleration each time based on three rules
-    void flock(Boid boids [], uint8_t boidCount) {
-      PVector sep = separate(boids, boidCount);   // Separation
-      PVector ali = align(boids, boidCount);      // Alignment
-      PVector coh = cohesion(boids, boidCount);   // Cohesion
+    // We accumulate a new acceleration each time based on three rules, all worked out in one pass over the flock
+    void flock(const Boid boids [], uint16_t boidCount) {
+      flockWith(boids, [boidCount](auto visit) {
+        for (uint16_t i = 0; i < boidCount; i++)
+          visit(i);
+      });
+    }
+
+    // The same, but only looking at the boids in the grid cells near this one
+    void flock(const Boid boids [], const BoidGrid & grid) {
+      float radius = std::max(desiredseparation, neighbordist);
+      flockWith(boids, [this, &grid, radius](auto visit) {
+        grid.forEachNear(location, radius, visit);
+      });
+    }
+
+    // Flocks every boid against the same snapshot of the flock, through a grid rebuilt from it.  None of them
+    // moves, so the grid stays exact throughout; call update() (and any border handling) on each afterwards.
+    static void flockAll(Boid boids [], uint16_t boidCount, BoidGrid & grid) {
+      grid.build(boids, boidCount);
+      for (uint16_t i = 0; i < boidCount; i++)
+        if (boids[i].enabled)
+          boids[i].flock(boids, grid);
+    }
+
+    // Separation, alignment and cohesion from a single visit to each neighbor.  forEachCandidate(visit) has to
+    // call visit(i) for every boid that might be within range; anything further away is ignored.
+    template <typename ForEachCandidate>
+    void flockWith(const Boid boids [], ForEachCandidate forEachCandidate) {
+      const float separationSq = desiredseparation * desiredseparation;
+      const float neighborSq = neighbordist * neighbordist;
+
+      float sepX = 0, sepY = 0;
+      float aliX = 0, aliY = 0;
+      float cohX = 0, cohY = 0;
+      int sepCount = 0;
+      int neighborCount = 0;
+
+      forEachCandidate([&](uint16_t i) {
+        const Boid & other = boids[i];
+        if (!other.enabled)
+          return;
+        float dx = location.x - other.location.x;
+        float dy = location.y - other.location.y;
+        float dSq = dx * dx + dy * dy;
+        if (dSq == 0)                       // Ourselves, or as good as
+          return;
+        if (dSq < separationSq) {
+          // Unit vector away from the neighbor, weighted by 1/distance
+          sepX += dx / dSq;
+          sepY += dy / dSq;
+          sepCount++;
+        }
+        if (dSq < neighborSq) {
+          aliX += other.velocity.x;
+          aliY += other.velocity.y;
+          cohX += other.location.x;
+          cohY += other.location.y;
+          neighborCount++;
+        }
+      });
+
+      PVector sep = PVector(sepX, sepY);
+      if (sepCount > 0)
+        sep /= (float) sepCount;
+      if (sep.mag() > 0) {
+        sep.normalize();
+        sep *= maxspeed;
+        sep -= velocity;
+        sep.limit(maxforce);
+      }
+
+      PVector ali = PVector(0, 0);
+      PVector coh = PVector(0, 0);
+      if (neighborCount > 0) {
+        ali = PVector(aliX / neighborCount, aliY / neighborCount);
+        ali.normalize();
+        ali *= maxspeed;
+        ali -= velocity;
+        ali.limit(maxforce);
+        coh = seek(PVector(cohX / neighborCount, cohY / neighborCount));
+      }
+
       // Arbitrarily weight these forces
       sep *= 1.5;
-      ali *= 1.0;
-      coh *= 1.0;
-      // Add the force vectors to acceleration
       applyForce(sep);
       applyForce(ali);
       applyForce(coh);
@@ -165,12 +301,12 @@ class Boid
 
     // Separation
     // Method checks for nearby boids and steers away
-    PVector separate(Boid boids [], uint8_t boidCount) {
+    PVector separate(const Boid boids [], uint16_t boidCount) {
       PVector steer = PVector(0, 0);
       int count = 0;
       // For every boid in the system, check if it's too close
       for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
+        const Boid & other = boids[i];
         if (!other.enabled)
           continue;
         float d = location.dist(other.location);
@@ -202,11 +338,11 @@ class Boid
 
     // Alignment
     // For every nearby boid in the system, calculate the average velocity
-    PVector align(Boid boids [], uint8_t boidCount) {
+    PVector align(const Boid boids [], uint16_t boidCount) {
       PVector sum = PVector(0, 0);
       int count = 0;
       for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
+        const Boid & other = boids[i];
         if (!other.enabled)
           continue;
         float d = location.dist(other.location);
@@ -230,11 +366,11 @@ class Boid
 
     // Cohesion
     // For the average location (i.e. center) of all nearby boids, calculate steering vector towards that location
-    PVector cohesion(Boid boids [], uint8_t boidCount) {
+    PVector cohesion(const Boid boids [], uint16_t boidCount) {
       PVector sum = PVector(0, 0);   // Start with empty vector to accumulate all locations
       int count = 0;
       for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
+        const Boid & other = boids[i];
         if (!other.enabled)
           continue;
         float d = location.dist(other.location);
@@ -359,3 +495,32 @@ class Boid
       //matrix.drawBackgroundPixelRGB888(location.x, location.y, CRGB::Blue);
     }
 };
+
+inline void BoidGrid::build(const Boid boids [], uint16_t boidCount) {
+  const int cells = _columns * _rows;
+  const uint16_t none = cells;
+
+  if (_order.size() < boidCount) {
+    _order.resize(boidCount);
+    _cellOf.resize(boidCount);
+  }
+
+  // Count the boids in each cell, then turn the counts into where each cell ends
+  std::fill(_cellStart.begin(), _cellStart.end(), 0);
+  for (uint16_t i = 0; i < boidCount; i++) {
+    if (!boids[i].enabled) {
+      _cellOf[i] = none;
+      continue;
+    }
+    _cellOf[i] = row(boids[i].location.y) * _columns + column(boids[i].location.x);
+    _cellStart[_cellOf[i]]++;
+  }
+  for (int c = 1; c < cells; c++)
+    _cellStart[c] += _cellStart[c - 1];
+  _cellStart[cells] = _cellStart[cells - 1];
+
+  // Walking back from each cell's end leaves it pointing at the cell's start, and the boids in index order
+  for (int i = boidCount - 1; i >= 0; i--)
+    if (_cellOf[i] != none)
+      _order[--_cellStart[_cellOf[i]]] = i;
+}
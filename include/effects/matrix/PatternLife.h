@@ -24,10 +24,11 @@
 // Description:
 //
 //   Effect code ported from Aurora to Mesmerizer's draw routines
-//   and added the cycle detection CRC stuff
+//   and added the cycle detection stuff
 //
 // History:     Jun-25-2022         Davepl      Based on Aurora
 //              Jul-08-2022         Davepl      Added loop checks
+//              Oct-16-2026         Davepl      Bit-packed world, hashed as it steps
 //
 //---------------------------------------------------------------------------
 
@@ -64,29 +65,36 @@
 
 #include <bitset>
 
-extern "C" 
-{
-    #include "uzlib/src/uzlib.h"
-}
+#define LOOP_CHECK_DEPTH 130                     // Depth of loop check buffer
 
-class Cell 
-{
-public:
-  uint8_t alive : 1;
-  uint8_t prev  : 1;
-  uint8_t hue;  
-  uint8_t brightness;
-};
+// The world is kept as bits, one row of the matrix after another, with each row taking as many 32-bit words
+// as it needs.  Bit i of word w in a row is the cell at x = 32 * w + i.
 
-#define CRC_LENGTH 130                           // Depth of loop check buffer
+static constexpr int LIFE_WORD_BITS = 32;
+static constexpr int LIFE_ROW_WORDS = (MATRIX_WIDTH + LIFE_WORD_BITS - 1) / LIFE_WORD_BITS;
+static constexpr int LIFE_TAIL_BITS = MATRIX_WIDTH - (LIFE_ROW_WORDS - 1) * LIFE_WORD_BITS;      // Cells in a row's last word
+static constexpr uint32_t LIFE_TAIL_MASK = LIFE_TAIL_BITS == LIFE_WORD_BITS ? 0xFFFFFFFF : (1u << LIFE_TAIL_BITS) - 1;
+static constexpr uint64_t LIFE_HASH_SEED = 0xCBF29CE484222325ull;
 
 class PatternLife : public LEDStripEffect 
 {
 private:
     
-    Cell (*world)[MATRIX_HEIGHT];
-    uint32_t * checksums;
-    int iChecksum = 0;
+    typedef uint32_t Row[LIFE_ROW_WORDS];
+
+    Row   generations[2][MATRIX_HEIGHT] = { };
+    Row * cells = generations[0];               // The generation on screen
+    Row * next  = generations[1];               // Where the step builds the one after it
+
+    // Color lives in planes of its own, [y][x], so the step only has to touch it where something changed
+
+    uint8_t (*hue)[MATRIX_WIDTH];
+    uint8_t (*brightness)[MATRIX_WIDTH];
+
+    uint64_t * hashes;
+    int iHash = 0;
+    int cHashes = 0;
+    uint64_t hash = 0;                          // Hash of the generation in cells
     uint32_t bStuckInLoop = 0;
     unsigned int density = 50;
     int cGeneration = 0;
@@ -97,12 +105,12 @@ private:
     {
         LEDStripEffect::Init(gfx);
 
-        // BUGBUG (Davepl)  Although this saves us on base mem, access to the PSRAM is fairly random which is
-        //                  not ideal and slows this down to about 23 fps.  If you need more, you'll need to go
-        //                  to regular RAM.
+        // The color planes are walked in order, row by row, so they're happy enough in PSRAM.  The cells
+        // themselves only take a couple of hundred bytes and stay in the object.
         
-        world =  (Cell (*)[MATRIX_HEIGHT]) PreferPSRAMAlloc( sizeof(Cell) * MATRIX_WIDTH * MATRIX_HEIGHT);        
-        checksums = (uint32_t *) PreferPSRAMAlloc( CRC_LENGTH * sizeof(uint32_t) );
+        hue        = (uint8_t (*)[MATRIX_WIDTH]) PreferPSRAMAlloc(MATRIX_WIDTH * MATRIX_HEIGHT);
+        brightness = (uint8_t (*)[MATRIX_WIDTH]) PreferPSRAMAlloc(MATRIX_WIDTH * MATRIX_HEIGHT);
+        hashes     = (uint64_t *) PreferPSRAMAlloc((LOOP_CHECK_DEPTH - 1) * sizeof(uint64_t));
         return true;
     }
     
@@ -139,6 +147,33 @@ private:
         555109764,      // 4470
     };
 
+    static bool isAlive(const Row * world, int x, int y)
+    {
+        return (world[y][x / LIFE_WORD_BITS] >> (x % LIFE_WORD_BITS)) & 1;
+    }
+
+    // A word's worth of the western (x - 1) and eastern (x + 1) neighbors of the cells in word w of a row,
+    // wrapping around at the ends of the row like the rest of the world does
+
+    static uint32_t westOf(const Row & row, int w)
+    {
+        uint32_t carry = w > 0 ? row[w - 1] >> (LIFE_WORD_BITS - 1)
+                               : row[LIFE_ROW_WORDS - 1] >> (LIFE_TAIL_BITS - 1);
+        return (row[w] << 1) | carry;
+    }
+
+    static uint32_t eastOf(const Row & row, int w)
+    {
+        return w < LIFE_ROW_WORDS - 1 ? (row[w] >> 1) | (row[w + 1] << (LIFE_WORD_BITS - 1))
+                                      : (row[w] >> 1) | ((row[0] & 1) << (LIFE_TAIL_BITS - 1));
+    }
+
+    // FNV-1a over whole words, which is plenty to tell a few hundred generations apart
+
+    static uint64_t hashWord(uint64_t h, uint32_t word)
+    {
+        return (h ^ word) * 0x100000001B3ull;
+    }
 
     void randomFillWorld() 
     {
@@ -157,35 +192,127 @@ private:
             debugI("Randomized Seed: %lu", seed);
         }
 
+        // Filled a column at a time, in the same order as always, so the baked in seeds still grow the same worlds
+
+        memset(generations[0], 0, sizeof(generations[0]));
+        cells = generations[0];
+        next  = generations[1];
+
         srand(seed);
         for (int i = 0; i < MATRIX_WIDTH; i++) {
             for (int j = 0; j < MATRIX_HEIGHT; j++) {
                 if ((rand() % 100) < density) {
-                    world[i][j].alive = 1;
-                    world[i][j].brightness = 128;
+                    cells[j][i / LIFE_WORD_BITS] |= 1u << (i % LIFE_WORD_BITS);
+                    brightness[j][i] = 128;
                 }
                 else {
-                    world[i][j].alive = 0;
-                    world[i][j].brightness = 0;
+                    brightness[j][i] = 0;
                 }
-                world[i][j].prev = world[i][j].alive;
-                world[i][j].hue = 0;
+                hue[j][i] = 0;
             }
         }
 
-        for (int i = 0; i < CRC_LENGTH; i++)
-            checksums[i] = 0xFFFFFFF;
+        hash = LIFE_HASH_SEED;
+        for (int y = 0; y < MATRIX_HEIGHT; y++)
+            for (int w = 0; w < LIFE_ROW_WORDS; w++)
+                hash = hashWord(hash, cells[y][w]);
     }
 
-    int neighbours(int x, int y) {
-        return (world[(x + 1) % MATRIX_WIDTH][y].prev) +
-            (world[x][(y + 1) % MATRIX_HEIGHT].prev) +
-            (world[(x + MATRIX_WIDTH - 1) % MATRIX_WIDTH][y].prev) +
-            (world[x][(y + MATRIX_HEIGHT - 1) % MATRIX_HEIGHT].prev) +
-            (world[(x + 1) % MATRIX_WIDTH][(y + 1) % MATRIX_HEIGHT].prev) +
-            (world[(x + MATRIX_WIDTH - 1) % MATRIX_WIDTH][(y + 1) % MATRIX_HEIGHT].prev) +
-            (world[(x + MATRIX_WIDTH - 1) % MATRIX_WIDTH][(y + MATRIX_HEIGHT - 1) % MATRIX_HEIGHT].prev) +
-            (world[(x + 1) % MATRIX_WIDTH][(y + MATRIX_HEIGHT - 1) % MATRIX_HEIGHT].prev);
+    // stepGeneration
+    //
+    // Works out the next generation into next, 32 cells at a time.  The eight neighbor words of each word are
+    // added up bit by bit with full adders, giving every cell's neighbor count as separate ones, twos and
+    // fours bit planes (a count of 8 wraps to 0, which dies just the same).  A cell is alive next time if
+    // the count is 3, or if it's 2 and the cell is alive now.  Returns the hash of the new generation.
+
+    uint64_t stepGeneration()
+    {
+        auto fullAdd = [](uint32_t a, uint32_t b, uint32_t c, uint32_t & carry)
+        {
+            uint32_t ab = a ^ b;
+            carry = (a & b) | (c & ab);
+            return ab ^ c;
+        };
+
+        uint64_t h = LIFE_HASH_SEED;
+
+        for (int y = 0; y < MATRIX_HEIGHT; y++)
+        {
+            const Row & above = cells[(y + MATRIX_HEIGHT - 1) % MATRIX_HEIGHT];
+            const Row & row   = cells[y];
+            const Row & below = cells[(y + 1) % MATRIX_HEIGHT];
+
+            for (int w = 0; w < LIFE_ROW_WORDS; w++)
+            {
+                uint32_t c0, c1, c2, c3, c4, c5;
+                uint32_t s0 = fullAdd(westOf(above, w), above[w], eastOf(above, w), c0);
+                uint32_t s1 = fullAdd(westOf(below, w), below[w], eastOf(below, w), c1);
+                uint32_t w2 = westOf(row, w), e2 = eastOf(row, w);
+                uint32_t s2 = w2 ^ e2;
+                c2 = w2 & e2;
+
+                uint32_t ones  = fullAdd(s0, s1, s2, c3);
+                uint32_t t     = fullAdd(c0, c1, c2, c4);
+                uint32_t twos  = t ^ c3;
+                c5 = t & c3;
+                uint32_t fours = c4 ^ c5;
+
+                uint32_t alive = twos & ~fours & (ones | row[w]);
+                if (w == LIFE_ROW_WORDS - 1)
+                    alive &= LIFE_TAIL_MASK;
+
+                next[y][w] = alive;
+                h = hashWord(h, alive);
+            }
+        }
+        return h;
+    }
+
+    // updateColors
+    //
+    // Births get the next hue at full brightness, deaths go dark, and cells that were already dead fade
+
+    void updateColors()
+    {
+        for (int y = 0; y < MATRIX_HEIGHT; y++)
+        {
+            for (int w = 0; w < LIFE_ROW_WORDS; w++)
+            {
+                uint32_t was  = cells[y][w];
+                uint32_t born = next[y][w] & ~was;
+                uint32_t died = was & ~next[y][w];
+                int cBits = w == LIFE_ROW_WORDS - 1 ? LIFE_TAIL_BITS : LIFE_WORD_BITS;
+
+                for (int i = 0; i < cBits; i++)
+                {
+                    int x = w * LIFE_WORD_BITS + i;
+                    uint32_t bit = 1u << i;
+                    if (born & bit)
+                    {
+                        hue[y][x] += 1;
+                        brightness[y][x] = 255;
+                    }
+                    else if (died & bit)
+                        brightness[y][x] = 0;
+                    else if (!(was & bit))
+                        brightness[y][x] = brightness[y][x] * 3 / 4;
+                }
+            }
+        }
+    }
+
+    // Records the hash of the generation on screen and returns true if it's one of the last few before it
+
+    bool seenBefore(uint64_t h)
+    {
+        bool bSeen = false;
+        for (int i = 0; i < cHashes && !bSeen; i++)
+            bSeen = hashes[i] == h;
+
+        hashes[iHash] = h;
+        iHash = (iHash + 1) % (LOOP_CHECK_DEPTH - 1);
+        cHashes = std::min(cHashes + 1, LOOP_CHECK_DEPTH - 1);
+        return bSeen;
     }
 
 public:
@@ -197,8 +324,8 @@ public:
     void Reset()
     {
         randomFillWorld();
-        for (int i = 0; i < CRC_LENGTH; i++)
-            checksums[i] = 0xFFFFFFF;
+        iHash = 0;
+        cHashes = 0;
         cGeneration = 0;
         bStuckInLoop = 0;
     }
@@ -216,32 +343,18 @@ public:
         {
             for (int i = 0; i < MATRIX_WIDTH; i++) {
                 for (int j = 0; j < MATRIX_HEIGHT; j++) {
-                    if (world[i][j].brightness > 0)
-                        graphics->leds[graphics->xy(i, j)] += graphics->ColorFromCurrentPalette(world[i][j].hue * 4, world[i][j].brightness);
+                    if (brightness[j][i] > 0)
+                        graphics->leds[graphics->xy(i, j)] += graphics->ColorFromCurrentPalette(hue[j][i] * 4, brightness[j][i]);
                     else
                         graphics->leds[graphics->xy(i, j)] = CRGB::Black;
                 }
             }
         }
 
-        // We maintain a scrolling window of the last N crcs and if the current crc makes it all
-        // the way down to the bototm half we assume we're stuck in a loop and restart.
-        // We have to first extract the alive bits alone because we don't want the hue and brightness 
-        // data to mess with the CRC.
-
-        bool alive[MATRIX_WIDTH][MATRIX_HEIGHT];
-        for (int i = 0; i < MATRIX_WIDTH; i++) 
-            for (int j = 0; j < MATRIX_HEIGHT; j++) 
-                alive[i][j] = world[i][j].alive;
-
-        auto crc = uzlib_crc32(alive, sizeof(alive), 0xffffffff);
-        for (int i = 0; i < CRC_LENGTH - 1; i++)
-            checksums[i] = checksums[i+1];
-        checksums[CRC_LENGTH - 1] = crc;
-
+        // We keep a window of the hashes of the last N generations, which the step works out as it goes, and
+        // if the current one turns up in it we assume we're stuck in a loop and restart.
 
-        // Look for any occurance of the current CRC in the first half of the window, which would mean
-        // a loop has occured.  If 
+        bool bLooped = seenBefore(hash);
 
         if (bStuckInLoop)
         {
@@ -256,58 +369,23 @@ public:
             }
             graphics->DimAll(255 - 255*elapsed/resetTime);
 
-            for (int x = 0; x < MATRIX_WIDTH; x++) 
-                for (int y = 0; y < MATRIX_HEIGHT; y++) 
-                        world[x][y].brightness *= 0.9;
+            for (int y = 0; y < MATRIX_HEIGHT; y++) 
+                for (int x = 0; x < MATRIX_WIDTH; x++) 
+                    brightness[y][x] = brightness[y][x] * 9 / 10;
             if (elapsed > resetTime)
                 Reset();
         }
-        else
+        else if (bLooped)
         {
-            for (int i = CRC_LENGTH - 2; i >= 0; i--)
-            {
-                if (checksums[i] == crc)
-                {
-                    bStuckInLoop = millis();
-                    debugW("Seed: %10lu, Generations: %5d, %s", seed, cGeneration, cGeneration > 3000 ? "Y" : "N");
-                }
-                if (checksums[i] == 0xFFFFFFF)
-                    break;
-            }
+            bStuckInLoop = millis();
+            debugW("Seed: %10lu, Generations: %5d, %s", seed, cGeneration, cGeneration > 3000 ? "Y" : "N");
         }
 
         // Birth and death cycle
-        for (int x = 0; x < MATRIX_WIDTH; x++) {
-            for (int y = 0; y < MATRIX_HEIGHT; y++) {
-                // Default is for cell to stay the same
-                if (world[x][y].brightness > 0 && world[x][y].prev == 0)
-                  world[x][y].brightness *= 0.75;
-                  
-                int count = neighbours(x, y);
-                if (count == 3 && world[x][y].prev == 0) {
-                    // A new cell is born
-                    world[x][y].alive = 1;
-                    world[x][y].hue += 1;
-                    world[x][y].brightness = 255;
-                } else if ((count < 2 || count > 3) && world[x][y].prev == 1) {
-                    // Cell dies
-                    world[x][y].alive = 0;
-                    world[x][y].brightness = 0;
-                }
-            }
-        }
 
-        // Copy next generation into place
-
-        int cCount = 0;
-
-        for (int x = 0; x < MATRIX_WIDTH; x++) {
-            for (int y = 0; y < MATRIX_HEIGHT; y++) {
-                if (world[x][y].prev != world[x][y].alive)
-                    cCount++;
-                world[x][y].prev = world[x][y].alive;
-            }
-        }
+        hash = stepGeneration();
+        updateColors();
+        std::swap(cells, next);
 
         cGeneration++;
     }
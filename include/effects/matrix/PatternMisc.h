@@ -240,6 +240,11 @@ private:
     uint8_t flip = 0;
     uint8_t generation = 0;
 
+    // What this frame is drawn with, since the above have moved on to the next frame's by the time it's drawn
+    uint8_t drawCount = 0;
+    uint8_t drawFlip = 0;
+    uint8_t drawGeneration = 0;
+
 public:
     PatternMunch() : LEDStripEffect("Munch")
     {
@@ -250,21 +255,40 @@ public:
         return 16;
     }
 
+    // Each pixel only depends on where it is, so the rows can be drawn in any order, by either core
+
+    virtual bool CanDrawSplit() const
+    {
+        return true;
+    }
+
     virtual void Draw()
     {
-       
+        PrepareFrame();
+        DrawPart(WholeFrame());
+    }
+
+    virtual void DrawPart(const FramePart & part)
+    {
         for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-            for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
+            for (uint8_t y = part.rowBegin; y < part.rowEnd; y++) {
                 graphics()->leds[graphics()->xy(x, y)] = 
-                  (x ^ y ^ flip) < count ? 
-                      graphics()->ColorFromCurrentPalette(((x ^ y) << 2) + generation) 
+                  (x ^ y ^ drawFlip) < drawCount ? 
+                      graphics()->ColorFromCurrentPalette(((x ^ y) << 2) + drawGeneration) 
                     : CRGB::Black;
 
                 // The below is more pleasant
                // effects.leds[XY(x, y)] = effects.ColorFromCurrentPalette(((x ^ y) << 2) + generation) ;
             }
         }
-        
+    }
+
+    virtual void PrepareFrame()
+    {
+        drawCount = count;
+        drawFlip = flip;
+        drawGeneration = generation;
+
         count += dir;
         
         if (count <= 0 || count >= MATRIX_WIDTH) {
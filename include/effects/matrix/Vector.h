@@ -75,27 +75,27 @@ public:
         return x == 0 && y == 0;
     }
 
-    bool operator==(Vector2& v) {
+    bool operator==(const Vector2& v) const {
         return x == v.x && y == v.y;
     }
 
-    bool operator!=(Vector2& v) {
-        return !(x == y);
+    bool operator!=(const Vector2& v) const {
+        return !(*this == v);
     }
 
-    Vector2 operator+(Vector2& v) {
+    Vector2 operator+(const Vector2& v) const {
         return Vector2(x + v.x, y + v.y);
     }
-    Vector2 operator-(Vector2& v) {
+    Vector2 operator-(const Vector2& v) const {
         return Vector2(x - v.x, y - v.y);
     }
 
-    Vector2& operator+=(Vector2& v) {
+    Vector2& operator+=(const Vector2& v) {
         x += v.x;
         y += v.y;
         return *this;
     }
-    Vector2& operator-=(Vector2& v) {
+    Vector2& operator-=(const Vector2& v) {
         x -= v.x;
         y -= v.y;
         return *this;
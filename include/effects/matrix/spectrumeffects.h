@@ -59,14 +59,14 @@ class InsulatorSpectrumEffect : public LEDStripEffect, public BeatEffectBase, pu
 
     virtual void Draw()
     {
-        auto peaks = g_Analyzer.GetPeakData();
+        const AudioFrame frame = g_Analyzer.GetAudioFrame();
 
         for (int band = 0; band < min(NUM_BANDS, NUM_FANS); band++) 
         {
             CRGB color = ColorFromPalette(_Palette, ::map(band, 0, min(NUM_BANDS, NUM_FANS), 0, 255) + beatsin8(1) );
-            color = color.fadeToBlackBy(255 - 255 * peaks[band]);
-            color = color.fadeToBlackBy((2.0 - g_Analyzer._VURatio) * 228);
-            DrawRingPixels(0, FAN_SIZE * peaks[band], color, NUM_FANS-1-band, 0);
+            color = color.fadeToBlackBy(255 - 255 * frame.peaks[band]);
+            color = color.fadeToBlackBy((2.0 - frame.vuRatio) * 228);
+            DrawRingPixels(0, FAN_SIZE * frame.peaks[band], color, NUM_FANS-1-band, 0);
         }
 
         ProcessAudio();
@@ -193,7 +193,7 @@ class SpectrumAnalyzerEffect : public LEDStripEffect, virtual public VUMeterEffe
     // Draws the bar graph rectangle for a bar and then the white line on top of it.  Interpolates odd bars when you
     // have twice as many bars as bands.
 
-    void DrawBar(const uint8_t iBar, CRGB baseColor)
+    void DrawBar(const AudioFrame & frame, const uint8_t iBar, CRGB baseColor)
     {
         auto pGFXChannel = _GFX[0];
         int value, value2;
@@ -209,39 +209,39 @@ class SpectrumAnalyzerEffect : public LEDStripEffect, virtual public VUMeterEffe
 
             if (iBar % 4 == 0)
             {
-                value  = g_Analyzer.g_peak1Decay[iBand] * (pGFXChannel->height() - 1);
-                value2 = g_Analyzer.g_peak2Decay[iBand] *  pGFXChannel->height();            
+                value  = frame.peak1Decay[iBand] * (pGFXChannel->height() - 1);
+                value2 = frame.peak2Decay[iBand] *  pGFXChannel->height();            
             }
             else if (iBar % 4 == 1)
             {
-                value  = (g_Analyzer.g_peak1Decay[iBand] * 3 + g_Analyzer.g_peak1Decay[iNextBand] * 1 ) / 4 * (pGFXChannel->height() - 1);
-                value2 = (g_Analyzer.g_peak2Decay[iBand] * 3 + g_Analyzer.g_peak2Decay[iNextBand] * 1 ) / 4 *  pGFXChannel->height();            
+                value  = (frame.peak1Decay[iBand] * 3 + frame.peak1Decay[iNextBand] * 1 ) / 4 * (pGFXChannel->height() - 1);
+                value2 = (frame.peak2Decay[iBand] * 3 + frame.peak2Decay[iNextBand] * 1 ) / 4 *  pGFXChannel->height();            
             }
             else if (iBar % 4 == 2)
             {
-                value  = (g_Analyzer.g_peak1Decay[iBand] * 2 + g_Analyzer.g_peak1Decay[iNextBand] * 2 ) / 4 * (pGFXChannel->height() - 1);
-                value2 = (g_Analyzer.g_peak2Decay[iBand] * 2 + g_Analyzer.g_peak2Decay[iNextBand] * 2 ) / 4 *  pGFXChannel->height();            
+                value  = (frame.peak1Decay[iBand] * 2 + frame.peak1Decay[iNextBand] * 2 ) / 4 * (pGFXChannel->height() - 1);
+                value2 = (frame.peak2Decay[iBand] * 2 + frame.peak2Decay[iNextBand] * 2 ) / 4 *  pGFXChannel->height();            
             }
             else if (iBar % 4 == 3)
             {
-                value  = (g_Analyzer.g_peak1Decay[iBand] * 1 + g_Analyzer.g_peak1Decay[iNextBand] * 3) / 4 * (pGFXChannel->height() - 1);
-                value2 = (g_Analyzer.g_peak2Decay[iBand] * 1 + g_Analyzer.g_peak2Decay[iNextBand] * 3) / 4 *  pGFXChannel->height();            
+                value  = (frame.peak1Decay[iBand] * 1 + frame.peak1Decay[iNextBand] * 3) / 4 * (pGFXChannel->height() - 1);
+                value2 = (frame.peak2Decay[iBand] * 1 + frame.peak2Decay[iNextBand] * 3) / 4 *  pGFXChannel->height();            
             }
         }
         else if ((_numBars > NUM_BANDS) && (iBar % 2 == 1))
         {   
             // For odd bars, average the bars to the left and right of this one 
-            value  = ((g_Analyzer.g_peak1Decay[iBand] + g_Analyzer.g_peak1Decay[iNextBand]) / 2) * (pGFXChannel->height() - 1);
-            value2 = ((g_Analyzer.g_peak2Decay[iBand] + g_Analyzer.g_peak2Decay[iNextBand]) / 2) *  pGFXChannel->height();            
+            value  = ((frame.peak1Decay[iBand] + frame.peak1Decay[iNextBand]) / 2) * (pGFXChannel->height() - 1);
+            value2 = ((frame.peak2Decay[iBand] + frame.peak2Decay[iNextBand]) / 2) *  pGFXChannel->height();            
         }
         else
         {
             // One to one case
-            value  = g_Analyzer.g_peak1Decay[iBand] * (pGFXChannel->height() - 1);
-            value2 = g_Analyzer.g_peak2Decay[iBand] *  pGFXChannel->height();            
+            value  = frame.peak1Decay[iBand] * (pGFXChannel->height() - 1);
+            value2 = frame.peak2Decay[iBand] *  pGFXChannel->height();            
         }
 
-        debugV("Band: %d, Value: %f\n", iBar, g_Analyzer.g_peak1Decay[iBar] );
+        debugV("Band: %d, Value: %f\n", iBar, frame.peak1Decay[iBar] );
 
         if (value > pGFXChannel->height())
             value = pGFXChannel->height();
@@ -261,7 +261,7 @@ class SpectrumAnalyzerEffect : public LEDStripEffect, virtual public VUMeterEffe
         const int PeakFadeTime_ms = 1000;
 
         CRGB colorHighlight = CRGB(CRGB::White);
-        unsigned long msPeakAge = millis() - g_Analyzer.g_lastPeak1Time[iBand];
+        unsigned long msPeakAge = millis() - frame.lastPeak1Time[iBand];
         if (msPeakAge > PeakFadeTime_ms)
             msPeakAge = PeakFadeTime_ms;
         
@@ -348,6 +348,10 @@ class SpectrumAnalyzerEffect : public LEDStripEffect, virtual public VUMeterEffe
 
         if (_bShowVU)
             DrawVUMeter(pGFXChannel, 0);
+
+        // All the bars come from the same sampler pass
+
+        const AudioFrame frame = g_Analyzer.GetAudioFrame();
         
         for (int i = 0; i < _numBars; i++)
         {
@@ -355,12 +359,12 @@ class SpectrumAnalyzerEffect : public LEDStripEffect, virtual public VUMeterEffe
             if (pGFXChannel->IsPalettePaused())
             {
                 int q = ::map(i, 0, _numBars, 0, 255) + _colorOffset;
-                DrawBar(i, pGFXChannel->ColorFromCurrentPalette(q % 255, 255, NOBLEND));
+                DrawBar(frame, i, pGFXChannel->ColorFromCurrentPalette(q % 255, 255, NOBLEND));
             }
             else
             {
                 int q = ::map(i, 0, _numBars, 0, 255) + _colorOffset;
-                DrawBar(i, ColorFromPalette(_palette, (q) % 255, 255, NOBLEND));
+                DrawBar(frame, i, ColorFromPalette(_palette, (q) % 255, 255, NOBLEND));
             }
         }
     }
@@ -48,6 +48,7 @@ class FireEffect : public LEDStripEffect
     bool    bMirrored;          // If mirrored we split and duplicate the drawing
 
     std::unique_ptr<uint8_t []> heat;
+    std::unique_ptr<CRGB []>    heatColors;     // GetBlackBodyHeatColor for every heat, made on the first draw
 
     // When diffusing the fire upwards, these control how much to blend in from the cells below (ie: downward neighbors)
     // You can tune these coefficients to control how quickly and smoothly the fire spreads
@@ -157,20 +158,35 @@ class FireEffect : public LEDStripEffect
             GenerateSparks(1.0);
         }
 
-        // Finally, convert heat to a color
+        // Finally, convert heat to a color.  Heat is a byte, so every color it can map to is worked out once up front
+        // and then looked up a chunk of LEDs at a time
 
-        for (int i = 0; i < LEDCount; i++)
+        if (!heatColors)
+        {
+            heatColors = std::make_unique<CRGB []>(256);
+            for (int h = 0; h < 256; h++)
+                heatColors[h] = GetBlackBodyHeatColor(h/(double)std::numeric_limits<uint8_t>::max());
+        }
+
+        constexpr int kChunk = 32;
+        CRGB colors[kChunk];
+
+        for (int iChunk = 0; iChunk < LEDCount; iChunk += kChunk)
         {
+            int cColors = std::min(kChunk, LEDCount - iChunk);
+            MapSpan(colors, &heat[iChunk*CellsPerLED], cColors, heatColors.get(), CellsPerLED);
 
-            CRGB color = GetBlackBodyHeatColor(heat[i*CellsPerLED]/(double)std::numeric_limits<uint8_t>::max());
+            for (int k = 0; k < cColors; k++)
+            {
+                int i = iChunk + k;
 
-            // If we're reversed, we work from the end back.  We don't reverse the bonus pixels
+                // If we're reversed, we work from the end back.  We don't reverse the bonus pixels
 
-            
-            int j = (!bReversed) ? i : LEDCount - 1 - i;
-            setPixelsOnAllChannels(j, 1, color, false);
-            //if (bMirrored)
-            //    setPixelsOnAllChannels(!bReversed ? (2 * LEDCount - 1 - i) : LEDCount + i, 1, color, false);
+                int j = (!bReversed) ? i : LEDCount - 1 - i;
+                setPixelsOnAllChannels(j, 1, colors[k], false);
+                //if (bMirrored)
+                //    setPixelsOnAllChannels(!bReversed ? (2 * LEDCount - 1 - i) : LEDCount + i, 1, colors[k], false);
+            }
         }
     }
 };
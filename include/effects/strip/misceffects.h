@@ -165,6 +165,15 @@ protected:
           fillSolidOnAllChannels(CRGB::Black);                    
         fillSolidOnAllChannels(_color);
     }
+
+    // Every LED on every channel is _color, so there's nothing to add up
+
+    virtual bool FrameSums(int iChannel, PixelSums & sums) const
+    {
+        sums = PixelSums();
+        sums.Add(_color, _cLEDs);
+        return true;
+    }
 };
 
 class StatusEffect : public LEDStripEffect
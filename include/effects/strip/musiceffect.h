@@ -34,6 +34,100 @@
 
 extern DRAM_ATTR AppTime g_AppTime;
 
+// BeatDetector
+//
+// The audio side of beat detection, done once per audio frame and shared by every BeatEffectBase rather than each
+// of them keeping and searching its own history.  It keeps the last kWindow VU ratios in a SlidingMinMax, so an
+// effect can ask for the swing since its own last beat, and with audio, the spectral flux of each frame: how much
+// the bands rose since the frame before, added up.  A frame whose flux stands well above the recent average is an
+// onset, which finds drum hits that barely move the overall VU.
+//
+// Draw task only.
+
+class BeatDetector
+{
+  public:
+
+    static constexpr size_t kWindow     = 60;           // Audio frames of history
+    static constexpr float  kOnsetRatio = 1.5f;         // How many times the average flux makes an onset
+    static constexpr float  kOnsetFloor = 0.05f;        // and by how much it must beat it, so silence has none
+
+  private:
+
+    SlidingMinMax<float, kWindow> _vuRatios;
+    uint32_t _lastSequence = 0;
+    uint32_t _lastOnset    = UINT32_MAX;                // Serial number, in _vuRatios, of the last onset
+
+#if ENABLE_AUDIO
+    float    _lastPeaks[NUM_BANDS] = { };
+    float    _fluxes[kWindow]      = { };
+    double   _fluxTotal            = 0;
+
+    void UpdateFlux(const AudioFrame & frame, uint32_t serial)
+    {
+        float flux = 0;
+        for (int i = 0; i < NUM_BANDS; i++)
+        {
+            flux += std::max(0.0f, frame.peaks[i] - _lastPeaks[i]);
+            _lastPeaks[i] = frame.peaks[i];
+        }
+
+        size_t cFluxes = std::min<size_t>(serial, kWindow);
+        float average = cFluxes ? _fluxTotal / cFluxes : 0;
+        if (flux > average * kOnsetRatio + kOnsetFloor)
+            _lastOnset = serial;
+
+        float & oldest = _fluxes[serial % kWindow];
+        _fluxTotal += flux - oldest;
+        oldest = flux;
+    }
+#endif
+
+  public:
+
+    // Update
+    //
+    // Takes in the latest audio frame if it hasn't been seen already, so any number of effects can call it each
+    // time they draw
+
+    void Update()
+    {
+        AudioFrame frame = g_Analyzer.GetAudioFrame();
+        if (frame.sequence == _lastSequence)
+            return;
+        _lastSequence = frame.sequence;
+
+        uint32_t serial = _vuRatios.Next();
+        _vuRatios.Push(frame.vuRatio);
+
+#if ENABLE_AUDIO
+        UpdateFlux(frame, serial);
+#else
+        (void) serial;
+#endif
+    }
+
+    // Where the frames an effect has seen so far end, to pass to VURange and OnsetSince later
+
+    uint32_t Next() const
+    {
+        return _vuRatios.Next();
+    }
+
+    // How far the VU ratio has swung over the frames since serial number since, no further back than kWindow
+
+    float VURange(uint32_t since) const
+    {
+        float minimum, maximum;
+        return _vuRatios.MinMax(minimum, maximum, since) ? maximum - minimum : 0.0f;
+    }
+
+    bool OnsetSince(uint32_t since) const
+    {
+        return _lastOnset != UINT32_MAX && _lastOnset >= since;
+    }
+};
+
 // BeatEffectBase
 //
 // A specialization of LEDStripEffect, adds a HandleBeat function that allows apps to 
@@ -43,23 +137,38 @@ extern DRAM_ATTR AppTime g_AppTime;
 // The constructor allows you to specify the sensitivity by where the latch points are/
 // For a highly sensitive (defaults), keep them both close to 1.0.  For a wider beat 
 // detection you could use 0.25 and 1.75 for example.
+//
+// By default a beat is a big enough swing in the VU; BeatMode::SpectralFlux instead waits for an onset, as the
+// BeatDetector finds them, and still passes the VU swing along as the span.
 
+enum class BeatMode
+{
+    VURange,
+    SpectralFlux
+};
 
 class BeatEffectBase
 {
   protected:
-    const int _maxSamples = 60;
-    std::deque<double> _samples;
+    uint32_t _windowStart = 0;                          // First audio frame, in the detector, since the last beat
     double _lastBeat = 0;
     double _minRange = 0;
     double _minElapsed = 0;
+    BeatMode _mode = BeatMode::VURange;
+
+    static BeatDetector & Detector()
+    {
+        static BeatDetector detector;
+        return detector;
+    }
 
   public:
    
-    BeatEffectBase(double minRange = 0, double minElapsed = 0)      
+    BeatEffectBase(double minRange = 0, double minElapsed = 0, BeatMode mode = BeatMode::VURange)
      :
        _minRange(minRange),
-       _minElapsed(minElapsed)
+       _minElapsed(minElapsed),
+       _mode(mode)
     {
     }
 
@@ -83,30 +192,28 @@ class BeatEffectBase
     {
         debugV("BeatEffectBase2::Draw");
         double elapsed = SecondsSinceLastBeat();
-    
-        _samples.push_back(g_Analyzer._VURatio);
-        double minimum = *min_element(_samples.begin(), _samples.end());
-        double maximum = *max_element(_samples.begin(), _samples.end());
 
-        // debugI("Samples: %d, max: %0.2lf, min: %0.2lf, span: %0.2lf\n", _samples.size(), maximum, minimum, maximum-minimum);
+        BeatDetector & detector = Detector();
+        detector.Update();
+        double span = detector.VURange(_windowStart);
 
-        if (_samples.size() >= _maxSamples)
-          _samples.pop_front();
+        // debugI("Since: %u, span: %0.2lf\n", detector.Next() - _windowStart, span);
 
-        if (maximum - minimum > _minRange)
+        bool bBeat = _mode == BeatMode::SpectralFlux ? detector.OnsetSince(_windowStart) : span > _minRange;
+        if (bBeat)
         {
             if (elapsed < _minElapsed)
             {
-                // False beat too early, clear data but don't reset lastBeat
-                 _samples.clear();
+                // False beat too early, start the window over but don't reset lastBeat
+                _windowStart = detector.Next();
             }
             else
             {
-              debugV("Beat: elapsed: %0.2lf, range: %0.2lf\n", elapsed, maximum - minimum);
+              debugV("Beat: elapsed: %0.2lf, range: %0.2lf\n", elapsed, span);
 
-              HandleBeat(false, elapsed, maximum - minimum);
+              HandleBeat(false, elapsed, span);
               _lastBeat = g_AppTime.CurrentTime();
-              _samples.clear();
+              _windowStart = detector.Next();
             }
         }
     }
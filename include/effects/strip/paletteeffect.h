@@ -79,11 +79,27 @@ class PaletteEffect : public LEDStripEffect
     {
     }
     
-      virtual void Draw() 
+    // Every channel shows the same thing, so the frame can be split across channels, but the light and gap sizes
+    // mean any one pixel can depend on the ones before it, so each channel is drawn whole
+
+    virtual bool CanDrawSplit() const
     {
-        if (_bErase)
-          setAllOnAllChannels(0,0,0);
+        return true;
+    }
+
+    virtual FramePart WholeFrame() const
+    {
+        return FramePart { 0, NUM_CHANNELS, 0, 1 };
+    }
+
+    virtual void Draw() 
+    {
+        PrepareFrame();
+        DrawPart(WholeFrame());
+    }
 
+    virtual void PrepareFrame()
+    {
         float deltaTime = g_AppTime.DeltaTime();
         float increment = (deltaTime * _LEDSPerSecond);      
         const int totalSize = _gapSize + _lightSize + 1;
@@ -93,7 +109,21 @@ class PaletteEffect : public LEDStripEffect
         // scaling yields a color rotation of "one full palette per meter" by default.  We go backwards (-1) to match pixel scrolling direction.
 
         _paletteIndex = _paletteIndex - deltaTime * _paletteSpeed * 32 * _density * 256/144.0;    
+    }
+
+    virtual void DrawPart(const FramePart & part)
+    {
+        for (int channel = part.channelBegin; channel < part.channelEnd; channel++)
+            DrawChannel(_GFX[channel].get());
+    }
 
+    void DrawChannel(GFXBase * pGFX) const
+    {
+        if (_bErase)
+          for (int i = 0; i < _cLEDs; i++)
+            pGFX->setPixel(i, 0, 0, 0);
+
+        const int totalSize = _gapSize + _lightSize + 1;
         float iColor = fmodf(_paletteIndex + _startIndex * _density, 256);
 
         if (_gapSize == 0)
@@ -101,7 +131,7 @@ class PaletteEffect : public LEDStripEffect
           for (int i = 0; i < _cLEDs; i+=_lightSize)
           {
             iColor = fmodf(iColor + _density, 256);
-            setPixelsOnAllChannels(i, _lightSize, ColorFromPalette(_palette, iColor, 255 * _brightness, _blend), false);
+            pGFX->setPixelsF(i, _lightSize, ColorFromPalette(_palette, iColor, 255 * _brightness, _blend), false);
           }
         }
         else
@@ -119,7 +149,7 @@ class PaletteEffect : public LEDStripEffect
               if (index == 0)
               {
                   CRGB c = ColorFromPalette(_palette, iColor, 255 * _brightness, _blend);
-                  setPixelsOnAllChannels(i+_startIndex, _lightSize, c,false);
+                  pGFX->setPixelsF(i+_startIndex, _lightSize, c,false);
               }
           }
         }
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include "particlepool.h"
+
 extern AppTime g_AppTime;
 
 // Lifespan
@@ -295,13 +297,14 @@ template <typename Type = DrawableParticle> class ParticleSystem
 {
   protected:
 
-    std::deque<Type> _allParticles;
+    ParticlePool<Type> _allParticles;
 
     // Once per frame we are called to update all particles, which includes aging out old ones
 
   public:
     
-    ParticleSystem<Type>() 
+    ParticleSystem<Type>(size_t maxParticles = NUM_LEDS) 
+      : _allParticles(maxParticles)
     {
     }
 
@@ -388,8 +391,7 @@ class ColorBeatWithFlash : public BeatEffectBase, public ParticleSystem<RingPart
     {
       debugV("MusicalInsulatorEffect2 LightInsulator for Insulator %d", iInsulator);
 
-      RingParticle newparticle(iInsulator, iRing, color, !bMajor ? 0.05 : 0.0, 0.75);
-      _allParticles.push_back(newparticle);
+      _allParticles.emplace_back(iInsulator, iRing, color, !bMajor ? 0.05 : 0.0, 0.75);
     }
 
     virtual void HandleBeat(bool bMajor, float elapsed, double span)
@@ -452,7 +454,7 @@ class ColorBeatOverRed : public LEDStripEffect, public virtual BeatEffectBase, p
         float fadetime = min(5.0, elapsed * 1.5);   // Cap it at 5 seconds so we don't get ultra-long beats resulting from delays
         float flashtime = 0;
 
-        _allParticles.push_back(RingParticle(iInsulator, 0, RandomSaturatedColor(), flashtime, fadetime));
+        _allParticles.emplace_back(iInsulator, 0, RandomSaturatedColor(), flashtime, fadetime);
     }
 
     virtual void Draw()
@@ -709,26 +711,26 @@ class MoltenGlassOnVioletBkgnd : public LEDStripEffect, public virtual BeatEffec
         switch (random(10))
         {
           case 0:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 0, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 2, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 4, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 0, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 2, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 4, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
 
           case 1:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 1, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 3, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 1, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 3, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
 
           case 2:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 0, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 1, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 2, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 3, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 4, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 0, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 1, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 2, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 3, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 4, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
             break;
         
           default:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, iInsulator, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, iInsulator, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
         }
     }
@@ -778,26 +780,26 @@ class NewMoltenGlassOnVioletBkgnd : public LEDStripEffect, public BeatEffectBase
         switch (random(10))
         {
           case 0:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 0, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 2, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 4, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 0, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 2, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 4, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
 
           case 1:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 1, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 3, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 1, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 3, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
 
           case 2:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 0, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 1, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 2, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 3, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, 4, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, 0, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 1, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 2, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 3, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
+            _allParticles.emplace_back(_GFX, 4, 0, _Palette, 2, 50, -0.5, 1, 0, LINEARBLEND, true, 1.0, 0);
             break;
         
           default:
-            _allParticles.push_back(SpinningPaletteRingParticle(_GFX, iInsulator, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0));
+            _allParticles.emplace_back(_GFX, iInsulator, 0, _Palette, 256.0/FAN_SIZE, 0, -0.5, RING_SIZE_0, 0, LINEARBLEND, true, 1.0, 0);
             break;
         }
     }
@@ -842,7 +844,7 @@ class SparklySpinningMusicEffect : public LEDStripEffect, public BeatEffectBase,
         } while (NUM_FANS > 3 && iInsulator == _iLastInsulator);  
         _iLastInsulator = iInsulator;
 
-        _allParticles.push_back(SpinningPaletteRingParticle(_GFX, iInsulator, 0, _Palette, 1, 1.0, 1.0, 1, 0, NOBLEND, true, 1.0, min(0.15f, elapsed/2)));
+        _allParticles.emplace_back(_GFX, iInsulator, 0, _Palette, 1, 1.0, 1.0, 1, 0, NOBLEND, true, 1.0, min(0.15f, elapsed/2));
     }
 
     virtual void Draw()
@@ -884,7 +886,7 @@ class MusicalHotWhiteInsulatorEffect : public LEDStripEffect, public BeatEffectB
         } while (NUM_FANS > 3 && iInsulator == _iLastInsulator);  
         _iLastInsulator = iInsulator;
 
-        _allParticles.push_back(HotWhiteRingParticle(_GFX, iInsulator, 0, 0.25, 0.75));
+        _allParticles.emplace_back(_GFX, iInsulator, 0, 0.25, 0.75);
     }
 
     virtual void Draw()
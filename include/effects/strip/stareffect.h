@@ -359,7 +359,7 @@ template <typename ObjectType> class BeatStarterEffect : public BeatEffectBase
 template <typename StarType> class StarryNightEffect : public LEDStripEffect
 {
   protected:
-    std::deque<StarType>         _allParticles;
+    ParticlePool<StarType>       _allParticles;
     const CRGBPalette256         _palette;
     float                        _newStarProbability;
     float                        _starSize;
@@ -382,6 +382,7 @@ template <typename StarType> class StarryNightEffect : public LEDStripEffect
                                 double musicFactor = 1.0,
                                 CRGB skyColor = CRGB::Black)
       : LEDStripEffect(strName),
+        _allParticles(cMaxStars),
         _palette(palette),
         _newStarProbability(probability),
         _starSize(starSize),
@@ -448,10 +449,12 @@ template <typename StarType> class StarryNightEffect : public LEDStripEffect
             if (randomDouble(0, 1.0) < g_AppTime.DeltaTime() * prob * (float) _cLEDs / 5000.0f)
             {
                 //Serial.printf("Creating star with speed = %lf and factor = %lfn", _maxSpeed, _musicFactor);
-                StarType newstar(_palette, _blendType, _maxSpeed * _musicFactor, _starSize);
+                // Once the pool is full this retires the oldest star to make room
+
+                StarType & newstar = _allParticles.emplace_back(_palette, _blendType, _maxSpeed * _musicFactor, _starSize);
+
                 // This always starts stars on even pixel boundaries so they look like the desired width if not moving
                 newstar._iPos = (int) randomDouble(0, _cLEDs-1-starWidth);
-                _allParticles.push_back(newstar);
             }
         }
     }
@@ -468,9 +471,6 @@ template <typename StarType> class StarryNightEffect : public LEDStripEffect
 
         while (_allParticles.size() > 0 && _allParticles.front().Age() >= _allParticles.front().TotalLifetime())
             _allParticles.pop_front();
-
-        while (_allParticles.size() > cMaxStars)
-            _allParticles.pop_front();
     }
 
 };
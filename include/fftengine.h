@@ -0,0 +1,201 @@
+//+--------------------------------------------------------------------------
+//
+// File:        fftengine.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Single precision, real-input FFT for the sound analyzer.  It produces
+//    the same magnitudes as the arduinoFFT sequence the analyzer used to
+//    run (DCRemoval, flat top Windowing, Compute, ComplexToMagnitude) but
+//    is a good deal cheaper on the ESP32:
+//
+//    - It's all float.  The ESP32 has a single precision FPU, but doubles
+//      are done in software.
+//    - The window, twiddle factors and bit reversal order are computed
+//      once, up front, rather than on every pass.
+//    - The N real samples are packed into an N/2 point complex FFT and the
+//      two halves separated afterwards, which is half the butterflies, and
+//      there's no imaginary array to clear before every pass.
+//    - DC removal, windowing and packing happen in one pass over the input.
+//
+//    Nothing here depends on Arduino, so the native build can benchmark it
+//    against arduinoFFT directly.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <stdexcept>
+
+// RealFFT
+//
+// Magnitude spectrum of cSamples real samples, where cSamples is a power of two of at least 4
+
+class RealFFT
+{
+    const size_t                _cSamples;
+    const size_t                _cHalf;
+    std::unique_ptr<float []>   _window;            // Flat top, cSamples long
+    std::unique_ptr<float []>   _cos;               // cos(2 pi k / cSamples) for k < cSamples / 2
+    std::unique_ptr<float []>   _sin;               // sin(2 pi k / cSamples) for k < cSamples / 2
+    std::unique_ptr<uint16_t []> _bitReverse;       // Bit reversal order for the cSamples / 2 point complex FFT
+    std::unique_ptr<float []>   _re;                // Work buffers for the complex FFT
+    std::unique_ptr<float []>   _im;
+
+    // ComplexFFT
+    //
+    // In-place radix-2 decimation in time FFT of _re/_im, which are already in bit reversed order.  Its twiddles
+    // are every other entry of the full size table, which is exactly what the stride below steps by.
+
+    void ComplexFFT()
+    {
+        for (size_t len = 2; len <= _cHalf; len <<= 1)
+        {
+            const size_t half   = len >> 1;
+            const size_t stride = _cSamples / len;
+
+            for (size_t start = 0; start < _cHalf; start += len)
+            {
+                for (size_t j = 0; j < half; j++)
+                {
+                    const float wr =  _cos[j * stride];
+                    const float wi = -_sin[j * stride];
+
+                    const size_t a = start + j;
+                    const size_t b = a + half;
+
+                    const float tr = _re[b] * wr - _im[b] * wi;
+                    const float ti = _re[b] * wi + _im[b] * wr;
+
+                    _re[b] = _re[a] - tr;
+                    _im[b] = _im[a] - ti;
+                    _re[a] += tr;
+                    _im[a] += ti;
+                }
+            }
+        }
+    }
+
+public:
+
+    RealFFT(size_t cSamples)
+      : _cSamples(cSamples),
+        _cHalf(cSamples / 2)
+    {
+        if (cSamples < 4 || (cSamples & (cSamples - 1)) || cSamples / 2 > UINT16_MAX)
+            throw std::runtime_error("RealFFT size must be a power of two");
+
+        _window     = std::make_unique<float []>(_cSamples);
+        _cos        = std::make_unique<float []>(_cHalf);
+        _sin        = std::make_unique<float []>(_cHalf);
+        _bitReverse = std::make_unique<uint16_t []>(_cHalf);
+        _re         = std::make_unique<float []>(_cHalf);
+        _im         = std::make_unique<float []>(_cHalf);
+
+        // Same coefficients and symmetry as arduinoFFT's FFT_WIN_TYP_FLT_TOP, so the output levels match
+
+        for (size_t i = 0; i < _cHalf; i++)
+        {
+            double ratio = i / (double)(_cSamples - 1);
+            double w = 0.2810639 - 0.5208972 * cos(2 * M_PI * ratio) + 0.1980399 * cos(4 * M_PI * ratio);
+            _window[i] = _window[_cSamples - 1 - i] = (float) w;
+        }
+
+        for (size_t k = 0; k < _cHalf; k++)
+        {
+            _cos[k] = (float) cos(2 * M_PI * k / _cSamples);
+            _sin[k] = (float) sin(2 * M_PI * k / _cSamples);
+        }
+
+        int bits = 0;
+        while ((1u << bits) < _cHalf)
+            bits++;
+
+        for (size_t i = 0; i < _cHalf; i++)
+        {
+            size_t r = 0;
+            for (int b = 0; b < bits; b++)
+                if (i & (1u << b))
+                    r |= 1u << (bits - 1 - b);
+            _bitReverse[i] = (uint16_t) r;
+        }
+    }
+
+    size_t SampleCount() const
+    {
+        return _cSamples;
+    }
+
+    // Magnitudes
+    //
+    // Removes the DC offset from cSamples samples, applies the window and writes the magnitudes of the first
+    // cSamples / 2 bins to pOutput.  The input is consumed before any output is written, so pOutput may be
+    // the input array itself.
+
+    template <typename T>
+    void Magnitudes(const T * pSamples, float * pOutput)
+    {
+        float sum = 0.0f;
+        for (size_t i = 0; i < _cSamples; i++)
+            sum += (float) pSamples[i];
+        const float mean = sum / _cSamples;
+
+        // Even samples become the real parts and odd samples the imaginary parts, stored in bit reversed order
+
+        for (size_t i = 0; i < _cHalf; i++)
+        {
+            const size_t r = _bitReverse[i];
+            _re[r] = ((float) pSamples[2 * i]     - mean) * _window[2 * i];
+            _im[r] = ((float) pSamples[2 * i + 1] - mean) * _window[2 * i + 1];
+        }
+
+        ComplexFFT();
+
+        // Split the packed result back into the spectrum of the real input: with Z the half size transform,
+        // X[k] = (Z[k] + conj(Z[N/2-k])) / 2  +  W^k (Z[k] - conj(Z[N/2-k])) / 2i
+
+        pOutput[0] = fabsf(_re[0] + _im[0]);
+
+        for (size_t k = 1; k < _cHalf; k++)
+        {
+            const size_t m = _cHalf - k;
+
+            const float evenRe = 0.5f * (_re[k] + _re[m]);
+            const float evenIm = 0.5f * (_im[k] - _im[m]);
+            const float oddRe  = 0.5f * (_im[k] + _im[m]);
+            const float oddIm  = 0.5f * (_re[m] - _re[k]);
+
+            const float wr =  _cos[k];
+            const float wi = -_sin[k];
+
+            const float xr = evenRe + wr * oddRe - wi * oddIm;
+            const float xi = evenIm + wr * oddIm + wi * oddRe;
+
+            pOutput[k] = sqrtf(xr * xr + xi * xi);
+        }
+    }
+};
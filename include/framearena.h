@@ -0,0 +1,162 @@
+//+--------------------------------------------------------------------------
+//
+// File:        framearena.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Scratch memory for buffers that only have to last until the end of
+//    the frame, like the copy of the matrix MoveFractionalNoiseX works
+//    from.  Each GFXBase device owns one, allocated once at startup, and
+//    the effect manager resets it at the start of every frame; borrowing
+//    from it is just bumping an offset, so the draw task doesn't go to
+//    the heap for them.
+//
+//    A request that doesn't fit still gets memory, from the heap, but it
+//    is counted as a spill and the arena grows to that frame's peak when
+//    it's next reset, so it only happens until the arena has seen the
+//    most any frame needs.  So the draw task is only off the heap once
+//    FRAME_ARENA_SIZE, or the arena's growth, covers the biggest frame.
+//    Helpers that have another way to do their work borrow with
+//    TryAllocate instead, which never goes to the heap.  The high-water
+//    mark and spill count are served by /getTaskStatistics.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class FrameArena
+{
+    std::unique_ptr<uint8_t[]>                  _block;
+    std::atomic<size_t>                         _capacity;
+    size_t                                      _used = 0;
+    size_t                                      _requested = 0;     // This frame, including anything that spilled
+    std::atomic<size_t>                         _highWater { 0 };
+    std::atomic<uint32_t>                       _cSpills { 0 };
+    std::vector<std::unique_ptr<uint8_t[]>>     _spilled;
+
+  public:
+
+    // Scope
+    //
+    // Hands back everything borrowed while it was alive when it goes out of scope, so that a helper that only
+    // needs its scratch for the length of a call leaves the room for whoever borrows next
+
+    class Scope
+    {
+        FrameArena & _arena;
+        size_t       _used;
+        size_t       _requested;
+
+      public:
+
+        explicit Scope(FrameArena & arena) : _arena(arena), _used(arena._used), _requested(arena._requested) {}
+
+        ~Scope()
+        {
+            _arena._used      = _used;
+            _arena._requested = _requested;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+    };
+
+    explicit FrameArena(size_t capacity) : _block(capacity ? new uint8_t[capacity] : nullptr), _capacity(capacity)
+    {
+        _spilled.reserve(4);
+    }
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena & operator=(const FrameArena &) = delete;
+
+    // Allocate
+    //
+    // Draw task only.  Uninitialized room for count Ts, good until the next Reset() (or the end of the
+    // enclosing Scope).  Nothing borrowed is ever destructed, hence the restriction on T.
+
+    template <typename T> T * Allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Scratch memory is never destructed");
+        return static_cast<T *>(AllocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    // TryAllocate
+    //
+    // Draw task only.  Like Allocate, for callers that can manage without: if there isn't room it returns nullptr
+    // rather than spilling to the heap.  The request still counts toward the high-water mark.
+
+    template <typename T> T * TryAllocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Scratch memory is never destructed");
+        return static_cast<T *>(AllocateBytes(count * sizeof(T), alignof(T), false));
+    }
+
+    void * AllocateBytes(size_t cb, size_t alignment, bool bSpill = true)
+    {
+        size_t offset = (_used + alignment - 1) & ~(alignment - 1);
+
+        _requested += (offset - _used) + cb;
+        if (_requested > _highWater)
+            _highWater = _requested;
+
+        if (offset + cb <= _capacity)
+        {
+            _used = offset + cb;
+            return _block.get() + offset;
+        }
+
+        if (!bSpill)
+            return nullptr;
+
+        _cSpills++;
+        _spilled.emplace_back(new uint8_t[cb]);
+        return _spilled.back().get();
+    }
+
+    // Reset
+    //
+    // Draw task only, between frames.  Takes everything back, and if anything had to spill since last time,
+    // regrows the arena to the most any frame has asked for so it fits from now on.
+
+    void Reset()
+    {
+        if (!_spilled.empty())
+        {
+            _spilled.clear();
+            _block.reset(new uint8_t[_highWater]);
+            _capacity = _highWater.load();
+            debugW("Frame scratch arena grown to %zu bytes; raise FRAME_ARENA_SIZE to avoid this", _capacity.load());
+        }
+        _used = 0;
+        _requested = 0;
+    }
+
+    size_t   Capacity() const       { return _capacity;     }
+    size_t   HighWater() const      { return _highWater;    }
+    uint32_t Spills() const         { return _cSpills;      }
+};
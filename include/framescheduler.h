@@ -0,0 +1,194 @@
+//+--------------------------------------------------------------------------
+//
+// File:        framescheduler.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Paces the draw loop.  Rather than delay() for a whole number of
+//    milliseconds, the draw task blocks on a task notification that is
+//    given either by a one-shot esp_timer set for the exact microsecond
+//    the next frame is due, or by the network code when a new frame
+//    arrives (which may be due sooner than whatever we were waiting on).
+//
+//    It also keeps a histogram of how far from its due time each frame
+//    was actually presented, which /getStatistics reports.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <esp_timer.h>
+
+class FrameScheduler
+{
+  public:
+
+    // Presentation error histogram buckets, in microseconds.  Negative is early, positive is late; bucket i
+    // counts errors below BucketLimits[i] (and at or above the limit before it), the last one everything else.
+
+    static constexpr size_t  BucketCount = 9;
+    static constexpr int32_t BucketLimits[BucketCount - 1] = { -10000, -1000, -100, -10, 11, 101, 1001, 10001 };
+
+  private:
+
+    std::atomic<TaskHandle_t>   _task { nullptr };
+    esp_timer_handle_t          _timer = nullptr;
+    int64_t                     _usNextLocalFrame = 0;
+    int64_t                     _usLocalFrameDue = 0;           // Due time of the local frame not yet shown, or 0
+
+    std::atomic<uint32_t>       _aBuckets[BucketCount] = { };
+    std::atomic<uint32_t>       _cFrames { 0 };
+    std::atomic<int32_t>        _usMaxEarly { 0 };
+    std::atomic<int32_t>        _usMaxLate { 0 };
+
+    static void OnTimer(void * pThis)
+    {
+        ((FrameScheduler *) pThis)->Wake();
+    }
+
+    void Wake()
+    {
+        TaskHandle_t task = _task;
+        if (task)
+            xTaskNotifyGive(task);
+    }
+
+  public:
+
+    // WaitUntil
+    //
+    // Draw task only.  Blocks until esp_timer_get_time() reaches usDue or, if bWakeOnArrival, until a new frame
+    // comes in.  Returns right away if usDue has already passed.
+
+    void WaitUntil(int64_t usDue, bool bWakeOnArrival)
+    {
+        if (!_timer)
+        {
+            _task = xTaskGetCurrentTaskHandle();
+
+            esp_timer_create_args_t args = { };
+            args.callback        = OnTimer;
+            args.arg             = this;
+            args.dispatch_method = ESP_TIMER_TASK;
+            args.name            = "FrameScheduler";
+            ESP_ERROR_CHECK(esp_timer_create(&args, &_timer));
+        }
+
+        // A notification left over from a frame that arrived while we were drawing just costs an extra pass
+        // through the draw loop, whereas clearing it here could lose one that arrived after the caller looked
+
+        for (int64_t usLeft = usDue - esp_timer_get_time(); usLeft > 0; usLeft = usDue - esp_timer_get_time())
+        {
+            esp_timer_stop(_timer);
+            esp_timer_start_once(_timer, usLeft);
+
+            // The tick timeout is only a backstop in case the timer notification is somehow lost
+
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(usLeft / MICROS_PER_MILLI) + 2);
+
+            if (bWakeOnArrival)
+                break;
+        }
+
+        esp_timer_stop(_timer);
+    }
+
+    // NotifyFrameArrived
+    //
+    // Called by whichever task just queued a frame, to wake the draw task if it's waiting
+
+    void NotifyFrameArrived()
+    {
+        Wake();
+    }
+
+    // NextLocalFrame
+    //
+    // Draw task only.  When the next locally rendered frame is due, at usPeriod after the last one.  Advancing
+    // from the last due time rather than from when the frame happened to start keeps the rate from drifting;
+    // if we've fallen more than a frame behind (or the rate changed), it starts over from now.
+
+    int64_t NextLocalFrame(int64_t usPeriod)
+    {
+        int64_t usNow = esp_timer_get_time();
+        _usNextLocalFrame += usPeriod;
+        if (_usNextLocalFrame < usNow - usPeriod || _usNextLocalFrame > usNow + usPeriod)
+            _usNextLocalFrame = usNow + usPeriod;
+        _usLocalFrameDue = _usNextLocalFrame;
+        return _usNextLocalFrame;
+    }
+
+    // RecordPresentation
+    //
+    // Adds a frame to the histogram, given how many microseconds after its due time it was drawn
+
+    void RecordPresentation(int64_t usLate)
+    {
+        int32_t us = (int32_t) std::max<int64_t>(INT32_MIN, std::min<int64_t>(INT32_MAX, usLate));
+
+        size_t iBucket = 0;
+        while (iBucket < BucketCount - 1 && us >= BucketLimits[iBucket])
+            iBucket++;
+
+        _aBuckets[iBucket]++;
+        _cFrames++;
+
+        if (us < _usMaxEarly)
+            _usMaxEarly = us;
+        if (us > _usMaxLate)
+            _usMaxLate = us;
+    }
+
+    // CancelLocalFrame
+    //
+    // Draw task only.  Forgets the local frame NextLocalFrame scheduled, for when the loop goes back to waiting on
+    // WiFi instead of drawing it
+
+    void CancelLocalFrame()
+    {
+        _usLocalFrameDue = 0;
+    }
+
+    // RecordLocalPresentation
+    //
+    // Draw task only.  Records the local frame that FastLED.show() started clocking out at usShown against the due
+    // time NextLocalFrame last handed out.  Does nothing if nothing was shown (usShown is 0), or if no local frame
+    // is scheduled, as with the first one after WiFi frames.
+
+    void RecordLocalPresentation(int64_t usShown)
+    {
+        if (usShown == 0 || _usLocalFrameDue == 0)
+            return;
+
+        RecordPresentation(usShown - _usLocalFrameDue);
+        _usLocalFrameDue = 0;
+    }
+
+    uint32_t FrameCount() const                 { return _cFrames;             }
+    uint32_t BucketValue(size_t iBucket) const  { return _aBuckets[iBucket];   }
+    int32_t  MaxEarly() const                   { return -_usMaxEarly;         }
+    int32_t  MaxLate() const                    { return _usMaxLate;           }
+};
+
+extern FrameScheduler g_FrameScheduler;
@@ -0,0 +1,187 @@
+//+--------------------------------------------------------------------------
+//
+// File:        frametimings.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Records how long each stage of the draw loop took for the last
+//    Capacity frames that were shown.  The draw task fills in a record
+//    as it goes and publishes it into a ring; readers (the web server,
+//    the debug console) copy frames out without ever blocking it.
+//
+//    Each slot carries a sequence number that is odd while the draw task
+//    is writing it, so a reader that raced with a write can tell and
+//    skip that frame instead of reporting a torn one.  The timings in a
+//    slot are an AtomicCopy (see seqlock.h), so that racing read is
+//    still well defined.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <esp_timer.h>
+
+class FrameTimings
+{
+  public:
+
+    enum Stage
+    {
+        MatrixPreDraw,
+        WiFiDraw,
+        LocalDraw,
+        ShowStrip,
+        FastLEDShow,                // Part of ShowStrip, so also counted in it
+        StageCount
+    };
+
+    static constexpr const char * StageNames[StageCount] = { "MatrixPreDraw", "WiFiDraw", "LocalDraw", "ShowStrip", "FastLED.show" };
+
+    static constexpr size_t Capacity = 64;
+
+    struct FrameTiming
+    {
+        uint32_t frame;
+        uint32_t usTotal;
+        uint32_t usStage[StageCount];
+    };
+
+    struct StageSummary
+    {
+        uint32_t usMean;
+        uint32_t usMax;
+    };
+
+  private:
+
+    struct Slot
+    {
+        std::atomic<uint32_t>    sequence { 0 };
+        AtomicCopy<FrameTiming>  timing;
+    };
+
+    Slot                    _aSlots[Capacity];
+    std::atomic<uint32_t>   _cFrames { 0 };
+    FrameTiming             _current = { };
+
+  public:
+
+    // Lap
+    //
+    // Draw task only.  Adds the time since usStart to the given stage of the frame being drawn, and returns the
+    // current time so that the caller can chain one stage into the next.
+
+    int64_t Lap(Stage stage, int64_t usStart)
+    {
+        int64_t usNow = esp_timer_get_time();
+        _current.usStage[stage] += (uint32_t)(usNow - usStart);
+        return usNow;
+    }
+
+    // EndFrame
+    //
+    // Draw task only.  Publishes the frame being drawn, given its total time, and starts a new one.  Passes that
+    // didn't show anything are dropped with bPublish false, so the waits between frames don't water down the numbers.
+
+    void EndFrame(uint32_t usTotal, bool bPublish)
+    {
+        if (bPublish)
+        {
+            uint32_t iFrame = _cFrames.load(std::memory_order_relaxed);
+            Slot & slot = _aSlots[iFrame % Capacity];
+
+            _current.frame   = iFrame;
+            _current.usTotal = usTotal;
+
+            slot.sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.timing.Store(_current);
+            slot.sequence.fetch_add(1, std::memory_order_release);
+
+            _cFrames.store(iFrame + 1, std::memory_order_release);
+        }
+        _current = { };
+    }
+
+    // Snapshot
+    //
+    // Copies up to cMax of the most recent frames, oldest first, into pOut and returns how many it copied.  Frames
+    // the draw task was overwriting at the time are left out.
+
+    size_t Snapshot(FrameTiming * pOut, size_t cMax) const
+    {
+        uint32_t cFrames = _cFrames.load(std::memory_order_acquire);
+        uint32_t cWanted = std::min<uint32_t>(std::min<uint32_t>(cFrames, Capacity), cMax);
+
+        size_t cCopied = 0;
+        for (uint32_t iFrame = cFrames - cWanted; iFrame != cFrames; iFrame++)
+        {
+            const Slot & slot = _aSlots[iFrame % Capacity];
+
+            uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence & 1)
+                continue;
+
+            FrameTiming timing;
+            slot.timing.Load(timing);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || timing.frame != iFrame)
+                continue;
+
+            pOut[cCopied++] = timing;
+        }
+        return cCopied;
+    }
+
+    // Summarize
+    //
+    // Mean and worst time of each stage, with the whole frame as the last entry, over the frames in the ring.
+    // Returns how many frames that was.
+
+    size_t Summarize(StageSummary (&summary)[StageCount + 1]) const
+    {
+        FrameTiming aFrames[Capacity];
+        size_t cFrames = Snapshot(aFrames, Capacity);
+
+        for (int iStage = 0; iStage <= StageCount; iStage++)
+        {
+            uint64_t usSum = 0;
+            uint32_t usMax = 0;
+            for (size_t i = 0; i < cFrames; i++)
+            {
+                uint32_t us = iStage < StageCount ? aFrames[i].usStage[iStage] : aFrames[i].usTotal;
+                usSum += us;
+                usMax = std::max(usMax, us);
+            }
+            summary[iStage].usMean = cFrames ? (uint32_t)(usSum / cFrames) : 0;
+            summary[iStage].usMax  = usMax;
+        }
+        return cFrames;
+    }
+
+    uint32_t FrameCount() const     { return _cFrames;  }
+};
+
+extern FrameTimings g_FrameTimings;
@@ -64,6 +64,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <stdexcept>
 #include "Adafruit_GFX.h"
 #include "pixeltypes.h"
@@ -88,6 +89,14 @@ protected:
     size_t _width;
     size_t _height;
 
+    // True when xy(x, y) is simply y * _width + x, as it is on the HUB75 matrix (and trivially on a single
+    // row of LEDs).  The bulk helpers below then walk whole rows of leds directly instead of going through
+    // the virtual xy() for every pixel.
+
+    bool   _rowMajor;
+
+    FrameArena _scratch { FRAME_ARENA_SIZE };
+
     static const uint8_t gamma5[];
     static const uint8_t gamma6[];
 
@@ -126,7 +135,8 @@ public:
 
     GFXBase(int w, int h) : Adafruit_GFX(w, h),
                             _width(w),
-                            _height(h)
+                            _height(h),
+                            _rowMajor(h == 1)
     {
     }
 
@@ -134,6 +144,15 @@ public:
     {
     }
 
+    // Scratch
+    //
+    // Memory for buffers that only need to last the frame; see framearena.h
+
+    FrameArena & Scratch()
+    {
+        return _scratch;
+    }
+
 #if USE_MATRIX
     Noise & GetNoise()
     {
@@ -395,6 +414,28 @@ public:
     }
 
 
+    // blurLine
+    //
+    // blur1d along one row or column, from first to count - 1, where pixel(i) returns the i'th pixel of it
+
+    template <typename PixelAt>
+    static inline void blurLine(uint8_t first, uint8_t count, uint8_t keep, uint8_t seep, PixelAt pixel)
+    {
+        CRGB carryover = CRGB::Black;
+        for (uint8_t i = first; i < count; i++)
+        {
+            CRGB cur = pixel(i);
+            CRGB part = cur;
+            part.nscale8(seep);
+            cur.nscale8(keep);
+            cur += carryover;
+            if (i)
+                pixel(i - 1) += part;
+            pixel(i) = cur;
+            carryover = part;
+        }
+    }
+
     inline void blurRows(CRGB *leds, uint8_t width, uint8_t height, uint8_t first, fract8 blur_amount)
     {
         // blur rows same as columns, for irregular matrix
@@ -402,43 +443,39 @@ public:
         uint8_t seep = blur_amount >> 1;
         for (uint8_t row = 0; row < height; row++)
         {
-            CRGB carryover = CRGB::Black;
-            for (uint8_t i = first; i < width; i++)
+            if (_rowMajor)
             {
-                CRGB cur = leds[xy(i, row)];
-                CRGB part = cur;
-                part.nscale8(seep);
-                cur.nscale8(keep);
-                cur += carryover;
-                if (i)
-                    leds[xy(i - 1, row)] += part;
-                leds[xy(i, row)] = cur;
-                carryover = part;
+                CRGB * pRow = leds + row * _width;
+                blurLine(first, width, keep, seep, [pRow](uint8_t i) -> CRGB & { return pRow[i]; });
             }
+            else
+                blurLine(first, width, keep, seep, [&](uint8_t i) -> CRGB & { return leds[xy(i, row)]; });
         }
     }
 
     // blurColumns: perform a blur1d on each column of a rectangular matrix
     inline void blurColumns(CRGB *leds, uint8_t width, uint8_t height, uint8_t first, fract8 blur_amount)
     {
+        // On a row-major layout each row is contiguous, so all the columns can be blurred at once, a row at a time,
+        // given scratch for two rows.  Without it we fall back to a column at a time rather than go to the heap.
+
+        if (_rowMajor)
+        {
+            FrameArena::Scope scope(_scratch);
+            CRGB * pRows = _scratch.TryAllocate<CRGB>(2 * width);
+            if (pRows)
+            {
+                BlurLines(leds, height, width, _width, first, blur_amount, pRows);
+                return;
+            }
+        }
+
         // blur columns
         uint8_t keep = 255 - blur_amount;
         uint8_t seep = blur_amount >> 1;
         for (uint8_t col = 0; col < width; ++col)
         {
-            CRGB carryover = CRGB::Black;
-            for (uint8_t i = first; i < height; ++i)
-            {
-                CRGB cur = leds[xy(col, i)];
-                CRGB part = cur;
-                part.nscale8(seep);
-                cur.nscale8(keep);
-                cur += carryover;
-                if (i)
-                    leds[xy(col, i - 1)] += part;
-                leds[xy(col, i)] = cur;
-                carryover = part;
-            }
+            blurLine(first, height, keep, seep, [&](uint8_t i) -> CRGB & { return leds[xy(col, i)]; });
         }
     }
 
@@ -921,6 +958,21 @@ public:
     // give it a linear tail to the right
     inline void StreamRight(uint8_t scale, int fromX = 0, int toX = MATRIX_WIDTH, int fromY = 0, int toY = MATRIX_HEIGHT)
     {
+        if (_rowMajor)
+        {
+            for (int y = fromY; y < toY; y++)
+            {
+                CRGB * pRow = leds + y * _width;
+                for (int x = fromX + 1; x < toX; x++)
+                {
+                    pRow[x] += pRow[x - 1];
+                    pRow[x].nscale8(scale);
+                }
+                pRow[0].nscale8(scale);
+            }
+            return;
+        }
+
         for (int x = fromX + 1; x < toX; x++)
         {
             for (int y = fromY; y < toY; y++)
@@ -936,6 +988,23 @@ public:
     // give it a linear tail to the left
     inline void StreamLeft(uint8_t scale, int fromX = MATRIX_WIDTH, int toX = 0, int fromY = 0, int toY = MATRIX_HEIGHT)
     {
+        fromX = std::min(fromX, MATRIX_WIDTH - 1);      // The last pixel has nothing to its right to pull in
+
+        if (_rowMajor)
+        {
+            for (int y = fromY; y < toY; y++)
+            {
+                CRGB * pRow = leds + y * _width;
+                for (int x = toX; x < fromX; x++)
+                {
+                    pRow[x] += pRow[x + 1];
+                    pRow[x].nscale8(scale);
+                }
+                pRow[0].nscale8(scale);
+            }
+            return;
+        }
+
         for (int x = toX; x < fromX; x++)
         {
             for (int y = fromY; y < toY; y++)
@@ -951,6 +1020,23 @@ public:
     // give it a linear tail downwards
     inline void StreamDown(uint8_t scale)
     {
+        if (_rowMajor)
+        {
+            // Columns don't affect each other, so this can go a row at a time
+            for (int y = 1; y < MATRIX_HEIGHT; y++)
+            {
+                CRGB * pRow = leds + y * _width;
+                const CRGB * pAbove = pRow - _width;
+                for (int x = 0; x < MATRIX_WIDTH; x++)
+                {
+                    pRow[x] += pAbove[x];
+                    pRow[x].nscale8(scale);
+                }
+            }
+            nscale8(leds, MATRIX_WIDTH, scale);
+            return;
+        }
+
         for (int x = 0; x < MATRIX_WIDTH; x++)
         {
             for (int y = 1; y < MATRIX_HEIGHT; y++)
@@ -966,6 +1052,22 @@ public:
     // give it a linear tail upwards
     inline void StreamUp(uint8_t scale)
     {
+        if (_rowMajor)
+        {
+            for (int y = MATRIX_HEIGHT - 2; y >= 0; y--)
+            {
+                CRGB * pRow = leds + y * _width;
+                const CRGB * pBelow = pRow + _width;
+                for (int x = 0; x < MATRIX_WIDTH; x++)
+                {
+                    pRow[x] += pBelow[x];
+                    pRow[x].nscale8(scale);
+                }
+            }
+            nscale8(leds + (MATRIX_HEIGHT - 1) * _width, MATRIX_WIDTH, scale);
+            return;
+        }
+
         for (int x = 0; x < MATRIX_WIDTH; x++)
         {
             for (int y = MATRIX_HEIGHT - 2; y >= 0; y--)
@@ -1131,11 +1233,8 @@ public:
 
     void DimAll(uint8_t value)
     {
-        for (int i = 0; i < NUM_LEDS; i++)
-        {
-            // if ((leds[i].r != 255) || (leds[i].g != 255) || (leds[i].b != 255))           // Don't dim pure white
-            leds[i].nscale8(value);
-        }
+        // Every pixel gets the same treatment, so the layout doesn't matter
+        ScaleSpan(leds, NUM_LEDS, value);
     } 
     // write one pixel with the specified color from the current palette to coordinates
     /*
@@ -1201,14 +1300,25 @@ public:
     }
 #endif
 
+    // MoveInwardX - Shifts the left half of each row right and the right half left, towards the middle.  The
+    //               pixels at the outside edges stay put.
+
     inline void MoveInwardX(int startY = 0, int endY = MATRIX_HEIGHT - 1)
     {
         for (int y = startY; y <= endY; y++)
         {
+            if (_rowMajor)
+            {
+                CRGB * pRow = leds + y * _width;
+                memmove(pRow + 1, pRow, (MATRIX_WIDTH / 2) * sizeof(CRGB));
+                memmove(pRow + MATRIX_WIDTH / 2, pRow + MATRIX_WIDTH / 2 + 1, (MATRIX_WIDTH - MATRIX_WIDTH / 2 - 1) * sizeof(CRGB));
+                continue;
+            }
+
             for (int x = MATRIX_WIDTH / 2; x > 0; x--)
                 leds[xy(x, y)] = leds[xy(x - 1, y)];
 
-            for (int x = MATRIX_WIDTH / 2; x < MATRIX_WIDTH; x++)
+            for (int x = MATRIX_WIDTH / 2; x < MATRIX_WIDTH - 1; x++)
                 leds[xy(x, y)] = leds[xy(x + 1, y)];
         }
     }
@@ -1217,6 +1327,14 @@ public:
     {
         for (int y = startY; y <= endY; y++)
         {
+            if (_rowMajor)
+            {
+                CRGB * pRow = leds + y * _width;
+                memmove(pRow, pRow + 1, (MATRIX_WIDTH / 2 - 1) * sizeof(CRGB));
+                memmove(pRow + MATRIX_WIDTH - MATRIX_WIDTH / 2 + 1, pRow + MATRIX_WIDTH - MATRIX_WIDTH / 2, (MATRIX_WIDTH / 2 - 1) * sizeof(CRGB));
+                continue;
+            }
+
             for (int x = 0; x < MATRIX_WIDTH / 2 - 1; x++)
             {
                 leds[xy(x, y)] = leds[xy(x + 1, y)];
@@ -1227,32 +1345,59 @@ public:
         }       
     }
 
-    // MoveX - Shift the content on the matrix left or right
-    
+    // MoveX - Rotates each row of the matrix left by delta pixels, wrapping around
+
     inline void MoveX(uint8_t delta)
     {
+        delta %= MATRIX_WIDTH;
+        if (delta == 0)
+            return;
+
         for (int y = 0; y < MATRIX_HEIGHT; y++)
         {
-            // First part
-            for (int x = 0; x < MATRIX_WIDTH - delta; x++)  
-                leds[xy(x, y)] = leds[xy(x + delta, y)];
-            // Wrap around to second part
-            for (int x = MATRIX_WIDTH - delta; x < MATRIX_WIDTH; x++)
-                leds[xy(x, y)] = leds[xy(x + delta - MATRIX_WIDTH, y)];
+            if (_rowMajor)
+            {
+                CRGB * pRow = leds + y * _width;
+                std::rotate(pRow, pRow + delta, pRow + MATRIX_WIDTH);
+                continue;
+            }
+
+            // Rotating is the same as reversing the part that wraps, reversing the rest, and then reversing
+            // the lot, which can be done in place a swap at a time
+
+            auto Reverse = [&](int x0, int x1)
+            {
+                for (x1--; x0 < x1; x0++, x1--)
+                    std::swap(leds[xy(x0, y)], leds[xy(x1, y)]);
+            };
+            Reverse(0, delta);
+            Reverse(delta, MATRIX_WIDTH);
+            Reverse(0, MATRIX_WIDTH);
         }
     }
 
-    // MoveY - Shifts the content on the matix up or down
-    
+    // MoveY - Rotates the whole matrix up by delta rows, wrapping around
+
     inline void MoveY(uint8_t delta)
     {
+        delta %= MATRIX_HEIGHT;
+        if (delta == 0)
+            return;
+
+        if (_rowMajor)
+        {
+            // Rows are contiguous, so this is one rotate of the buffer by delta rows
+            std::rotate(leds, leds + delta * _width, leds + MATRIX_HEIGHT * _width);
+            return;
+        }
+
         CRGB tmp = 0;
         for (int x = 0; x < MATRIX_WIDTH; x++)
         {
-            tmp = leds[xy(x, 0)];
             for (int m = 0; m < delta; m++) // moves
             {
                 // Do this delta time for each row... computationally expensive potentially.
+                tmp = leds[xy(x, 0)];
                 for (int y = 0; y < MATRIX_HEIGHT - 1; y++)
                     leds[xy(x, y)] = leds[xy(x, y + 1)];
 
@@ -1264,7 +1409,8 @@ public:
 #if USE_MATRIX
     void MoveFractionalNoiseX(uint8_t amt = 16)
     {
-        std::unique_ptr<CRGB []> ledsTemp = std::make_unique<CRGB []>(NUM_LEDS);
+        FrameArena::Scope scope(_scratch);
+        CRGB * ledsTemp = _scratch.Allocate<CRGB>(NUM_LEDS);
 
         // move delta pixelwise
         for (int y = 0; y < MATRIX_HEIGHT; y++)
@@ -1314,7 +1460,8 @@ public:
 
     void MoveFractionalNoiseY(uint8_t amt = 16)
     {
-        std::unique_ptr<CRGB []> ledsTemp = std::make_unique<CRGB []>(NUM_LEDS);
+        FrameArena::Scope scope(_scratch);
+        CRGB * ledsTemp = _scratch.Allocate<CRGB>(NUM_LEDS);
 
         // move delta pixelwise
         for (int x = 0; x < MATRIX_WIDTH; x++)
@@ -160,7 +160,7 @@
 #undef min                                      // They define a min() on us
 #endif
 
-#define EFFECT_CROSS_FADE_TIME 600.0    // How long for an effect to ramp brightness fader down and back during effect change
+#define EFFECT_CROSS_FADE_TIME 600.0    // How long for an effect to ramp brightness fader down and back (or cross-fade) during effect change
 
 // Thread priorities
 //
@@ -203,6 +203,7 @@
 #define DEBUG_CORE              0
 #define SOCKET_CORE             1
 #define REMOTE_CORE             0
+#define RENDER_CORE             (1 - DRAWING_CORE)     // Split rendering worker, if USE_SPLIT_RENDER
 
 #define FASTLED_INTERNAL            1   // Suppresses the compilation banner from FastLED
 #define __STDC_FORMAT_MACROS
@@ -1094,6 +1095,38 @@ extern RemoteDebug Debug;           // Let everyone in the project know about it
     #define LED_PIN7        22
 #endif
 
+// Native Build
+//
+// The [env:native] build runs the drawing code on a desktop host against the shims in include/native.
+// There's no radio, screen, remote or OTA on the host, so those are forced off no matter what the
+// project config above asked for.  Matrix projects need SmartMatrix and are not supported natively.
+
+#if NATIVE
+    #if USE_MATRIX
+        #error The native build only supports strip projects
+    #endif
+
+    #undef  ENABLE_WIFI
+    #define ENABLE_WIFI             0
+    #undef  INCOMING_WIFI_ENABLED
+    #define INCOMING_WIFI_ENABLED   0
+    #undef  ENABLE_WEBSERVER
+    #define ENABLE_WEBSERVER        0
+    #undef  WAIT_FOR_WIFI
+    #define WAIT_FOR_WIFI           0
+    #undef  ENABLE_OTA
+    #define ENABLE_OTA              0
+    #undef  ENABLE_NTP
+    #define ENABLE_NTP              0
+    #undef  ENABLE_REMOTE
+    #define ENABLE_REMOTE           0
+    #undef  ENABLE_AUDIOSERIAL
+    #define ENABLE_AUDIOSERIAL      0
+    #undef  USE_SCREEN
+    #define USE_SCREEN              0
+    #undef  USE_PSRAM
+#endif
+
 #ifndef PROJECT_NAME
 #define PROJECT_NAME        "NightDriver"
 #endif
@@ -1147,6 +1180,28 @@ extern RemoteDebug Debug;           // Let everyone in the project know about it
 #define ENABLE_NTP              1   // Update the clock from NTP
 #endif
 
+// UDP transport
+//
+// When INCOMING_UDP_ENABLED is set alongside INCOMING_WIFI_ENABLED, color data can also arrive as UDP datagrams,
+// one frame per datagram, in the same format the TCP socket server takes.  Set INCOMING_UDP_MULTICAST_GROUP to
+// a group address like "239.192.49.152" and every strip in the group is fed by a single transmit.
+
+#ifndef INCOMING_UDP_ENABLED
+#define INCOMING_UDP_ENABLED            0
+#endif
+
+#ifndef INCOMING_UDP_PORT
+#define INCOMING_UDP_PORT               49152
+#endif
+
+#ifndef INCOMING_UDP_MULTICAST_GROUP
+#define INCOMING_UDP_MULTICAST_GROUP    nullptr     // Unicast only
+#endif
+
+#ifndef UDP_RESPONSE_INTERVAL_MS
+#define UDP_RESPONSE_INTERVAL_MS        1000        // How often a UDP sender gets a SocketResponse, rather than every frame
+#endif
+
 #ifndef NUM_LEDS
 #define NUM_LEDS (MATRIX_HEIGHT * MATRIX_WIDTH)
 #endif
@@ -1394,10 +1449,95 @@ extern DRAM_ATTR const int g_aRingSizeTable[];
     #define INPUT_PIN 0              
 #endif
 
+// FFT engine
+//
+// The sound analyzer runs its own single precision, real-input FFT (see fftengine.h).  Set USE_ARDUINOFFT to go
+// back to the double precision arduinoFFT path it replaced, which is several times slower on chips without a
+// double precision FPU (all of them, so far).
+
+#ifndef USE_ARDUINOFFT
+#define USE_ARDUINOFFT 0
+#endif
+
+// Samples in each window the sound analyzer runs its FFT over, which must be a power of two.  More gives finer
+// bands at the low end but costs more per pass and, outside streaming mode, waits longer for each window.
+
+#ifndef AUDIO_MAX_SAMPLES
+#define AUDIO_MAX_SAMPLES 512
+#endif
+
+// Streaming audio capture
+//
+// By default each sampler pass switches the ADC on, reads a whole window of samples, switches it off and only then
+// analyzes them, so any sound that arrives while it's busy is never heard.  With AUDIO_STREAMING_CAPTURE the I2S
+// DMA runs all the time and each pass reads only the next AUDIO_HOP_SAMPLES, analyzing them with the end of the
+// window before, so that windows overlap (by half at the default hop) and the passes come as fast as the samples do.
+
+#ifndef AUDIO_STREAMING_CAPTURE
+#define AUDIO_STREAMING_CAPTURE 0
+#endif
+
+#ifndef AUDIO_HOP_SAMPLES
+#define AUDIO_HOP_SAMPLES 256
+#endif
+
 #ifndef IR_REMOTE_PIN
 #define IR_REMOTE_PIN   25                    
 #endif
 
+// Effect cross-fade
+//
+// When the effect changes, the compositor keeps drawing the outgoing effect into its own buffer for the first
+// EFFECT_CROSS_FADE_TIME of the incoming one and blends the two, rather than fading out to black and back in.
+// Off for matrices, whose effects share noise and palette state in the GFX object and so can't run side by side.
+
+#ifndef USE_CROSS_FADE_COMPOSITOR
+    #if USE_MATRIX
+        #define USE_CROSS_FADE_COMPOSITOR 0
+    #else
+        #define USE_CROSS_FADE_COMPOSITOR 1
+    #endif
+#endif
+
+// FRAME_ARENA_SIZE
+//
+// Bytes of per-frame scratch memory each GFX device sets aside at startup for the helpers and effects that need a
+// temporary buffer (see framearena.h).  On a matrix that's one copy of the screen, for MoveFractionalNoiseX/Y,
+// which is also plenty for the two rows blurColumns borrows.  A strip only needs those two rows, at most 255 pixels
+// each since blurColumns takes a uint8_t width.
+// If it turns out to be too small the arena grows itself and says so on the debug console.
+
+#ifndef FRAME_ARENA_SIZE
+    #if USE_MATRIX
+        #define FRAME_ARENA_SIZE (NUM_LEDS * sizeof(CRGB))
+    #else
+        #define FRAME_ARENA_SIZE (2 * 255 * sizeof(CRGB))
+    #endif
+#endif
+
+// Split rendering
+//
+// Opt-in.  Effects that can draw their frame in pieces (LEDStripEffect::CanDrawSplit) have half of each frame, by
+// channel or by matrix rows, drawn by a worker on the other core while the draw task draws the rest (see
+// splitrender.h).  It takes the other core away from audio and networking for that long, hence off by default.
+
+#ifndef USE_SPLIT_RENDER
+    #define USE_SPLIT_RENDER 0
+#endif
+
+// Strip output correction
+//
+// The gamma curve and white balance (the most of each of red, green and blue an LED is given) that the output
+// stage applies to strip frames on their way out; see outputstage.h.  The defaults leave colors as drawn.
+
+#ifndef OUTPUT_GAMMA
+    #define OUTPUT_GAMMA 1.0f
+#endif
+
+#ifndef OUTPUT_WHITE_BALANCE
+    #define OUTPUT_WHITE_BALANCE CRGB(255, 255, 255)
+#endif
+
 
 // Custom WiFi Commands
 //
@@ -1410,6 +1550,7 @@ extern DRAM_ATTR const int g_aRingSizeTable[];
 #define WIFI_COMMAND_CLOCK       2             // Wifi command telling us current time at the server (DEPRECATED)
 #define WIFI_COMMAND_PIXELDATA64 3             // Wifi command with color data and 64-bit clock vals 
 #define WIFI_COMMAND_PEAKDATA    4             // Wifi command that delivers audio peaks
+#define WIFI_COMMAND_PIXELDELTA64 5            // Like PIXELDATA64, but spans of changes against the frame it names (see LEDBuffer::UpdateFromDelta)
 
 // Final headers
 // 
@@ -1638,7 +1779,7 @@ inline double mapDouble(double x, double in_min, double in_max, double out_min,
 {
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
-inline uint64_t ULONGFromMemory(uint8_t * payloadData)
+inline uint64_t ULONGFromMemory(const uint8_t * payloadData)
 {
     return  (uint64_t)payloadData[7] << 56  | 
             (uint64_t)payloadData[6] << 48  | 
@@ -1650,7 +1791,7 @@ inline uint64_t ULONGFromMemory(uint8_t * payloadData)
             (uint64_t)payloadData[0];
 }
 
-inline uint32_t DWORDFromMemory(uint8_t * payloadData)
+inline uint32_t DWORDFromMemory(const uint8_t * payloadData)
 {
     return  (uint32_t)payloadData[3] << 24  | 
             (uint32_t)payloadData[2] << 16  | 
@@ -1658,7 +1799,7 @@ inline uint32_t DWORDFromMemory(uint8_t * payloadData)
             (uint32_t)payloadData[0];
 }
 
-inline uint16_t WORDFromMemory(uint8_t * payloadData)
+inline uint16_t WORDFromMemory(const uint8_t * payloadData)
 {
     return  (uint16_t)payloadData[1] << 8   | 
             (uint16_t)payloadData[0];
@@ -1694,14 +1835,22 @@ inline bool CheckBlueBuffer(CRGB * prgb, size_t count)
 
 // Main includes 
 
+#include "taskmgr.h"                            // for cpu usage, etc
 #include "improvserial.h"                       // ImprovSerial impl for setting WiFi credentials over the serial port
+#include "framearena.h"                         // Per-frame scratch memory for the GFX devices
+#include "colorkernels.h"                       // Color operations on whole spans of CRGB
+#include "outputstage.h"                        // Gamma, white balance and power limit for strip output
 #include "gfxbase.h"                            // GFXBase drawing interface
 #include "screen.h"                             // LCD/TFT/OLED handling
 #include "socketserver.h"                       // Incoming WiFi data connections
+#include "udpserver.h"                          // Incoming WiFi data as UDP datagrams
+#include "seqlock.h"                            // Lock-free snapshots shared between tasks
 #include "soundanalyzer.h"                      // for audio sound processing
+#include "slidingminmax.h"                      // Min and max over a window of recent values
 #include "ledstripgfx.h"                        // Essential drawing code for strips
 #include "ledmatrixgfx.h"                       // For drawing to HUB75 matrices
 #include "ledstripeffect.h"                     // Defines base led effect classes
+#include "splitrender.h"                        // Draws splittable effects on both cores
 #include "ntptimeclient.h"                      // setting the system clock from ntp
 #include "effectmanager.h"                      // For g_EffectManagerf
 #include "network.h"                            // Networking 
@@ -1709,7 +1858,8 @@ inline bool CheckBlueBuffer(CRGB * prgb, size_t count)
 #include "Bounce2.h"                            // For Bounce button class
 #include "colordata.h"                          // color palettes
 #include "drawing.h"                            // drawing code
-#include "taskmgr.h"                            // for cpu usage, etc
+#include "framescheduler.h"                     // Paces the draw loop
+#include "frametimings.h"                       // Per-frame draw stage timings
 
 // Conditional includes depending on which project is being build
 
@@ -34,6 +34,7 @@
 #pragma once
 
 #include <pixeltypes.h>
+#include <atomic>
 #include <memory>
 #include <iostream>
 
@@ -93,20 +94,68 @@ public:
         p->~T();
     }
 };
+
+// psram_deleter
+//
+// Lets a unique_ptr own something made in memory from psram_allocator: runs the destructor, then hands the
+// memory back with free(), since delete would go to the wrong heap
+
+template <typename T>
+struct psram_deleter
+{
+    void operator()(T * p) const
+    {
+        p->~T();
+        psram_allocator<T>().deallocate(p, 1);
+    }
+};
+
+template <typename T> using psram_unique_ptr = std::unique_ptr<T, psram_deleter<std::remove_extent_t<T>>>;
+
+#else
+
+template <typename T> using psram_unique_ptr = std::unique_ptr<T>;
+
 #endif
 
+// Ingest counters
+//
+// Bytes of pixel data memcpy'd into LEDBuffers after arriving, and frames committed to a queue.
+// Compressed frames are inflated and UDP datagrams received straight into the buffers, so those
+// copy nothing unless a packet is sent to more than one channel.  Raw TCP frames are read whole
+// before the producer lock is taken and then copied in, adding up the pixels on the way.
+
+extern std::atomic<uint32_t> g_cbIngestCopied;
+extern std::atomic<uint32_t> g_cIngestFrames;
+
 class LEDBuffer
 {
   public:
-  
-     std::shared_ptr<GFXBase> _pStrand;
+
+    // The wire header is command16, channel16, length32, seconds64, micros64
+
+    static constexpr size_t WireHeaderSize = 2 * sizeof(uint16_t) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+    // A delta frame follows that with the seconds64 and micros64 of the frame it was encoded against
+
+    static constexpr size_t DeltaHeaderSize = WireHeaderSize + 2 * sizeof(uint64_t);
+
+    // Room for the header in front of the pixels plus one spare byte, so that a whole wire frame can be
+    // decompressed in place and the inflater can run one byte past the end to find the end of stream
+
+    static constexpr size_t WireStorageSize = WireHeaderSize + NUM_LEDS * sizeof(CRGB) + 1;
+
+    std::shared_ptr<GFXBase> _pStrand;
 
   private:
     
-    std::unique_ptr<CRGB []> _leds;
+    psram_unique_ptr<uint8_t []> _storage;                // The wire header followed by the pixels
+    CRGB *              _leds;                            // Points into _storage just past the header
     uint32_t            _pixelCount;
     uint64_t            _timeStampMicroseconds;
     uint64_t            _timeStampSeconds;
+    PixelSums           _sums;                            // Totals of the pixels, for the power limiter
+    bool                _bSummed = false;
    
   public:
 
@@ -117,15 +166,17 @@ class LEDBuffer
                  _timeStampSeconds(0)
     {
         #if USE_PSRAM
-            //psram_allocator<CRGB []> alloc = psram_allocator<CRGB []>();
-            // _leds = psram_allocator<CRGB>().allocate(NUM_LEDS);
-            _leds.reset(psram_allocator<CRGB>().allocate(NUM_LEDS));
+            _storage.reset(psram_allocator<uint8_t>().allocate(WireStorageSize));
+            if (!_storage)
+                throw std::runtime_error("Could not allocate LED buffer storage in PSRAM");
         #else
-            _leds = std::make_unique<CRGB []>(NUM_LEDS);
+            _storage = std::make_unique<uint8_t []>(WireStorageSize);
         #endif
 
+        memset(_storage.get(), 0, WireHeaderSize);
+        _leds = reinterpret_cast<CRGB *>(_storage.get() + WireHeaderSize);
 
-        for (int i = 0; i < ARRAYSIZE(_leds); i++)
+        for (int i = 0; i < NUM_LEDS; i++)
             _leds[i] = CRGB::Yellow;
     }
 
@@ -136,6 +187,16 @@ class LEDBuffer
     uint64_t Seconds()      const  { return _timeStampSeconds;      }
     uint64_t MicroSeconds() const  { return _timeStampMicroseconds; }
     uint32_t Length()       const  { return _pixelCount;            }
+    const PixelSums & Sums() const { return _sums;                  }
+
+    // WireStorage
+    //
+    // The header and pixels as one contiguous wire frame, for readers that want to land a whole
+    // frame at once.  Call SetFromWireHeader once the header bytes are in.
+
+    uint8_t * WireStorage()             { return _storage.get(); }
+    const uint8_t * WireHeader() const  { return _storage.get(); }
+    CRGB * Pixels()                     { return _leds;          }
 
     bool IsBufferOlderThan(const timeval & tv) const
     {
@@ -149,220 +210,581 @@ class LEDBuffer
         return false;
     }
 
-    bool UpdateFromWire(uint8_t * payloadData, size_t payloadLength)
+    // SetFromWireHeader
+    //
+    // Takes the timestamp and pixel count from a wire header and keeps a copy of the header itself.
+    // The pixels are expected to be written to Pixels() by the caller.
+
+    bool SetFromWireHeader(const uint8_t * pHeader)
     {
-        if (payloadLength < 24)                 // Our header size
+        uint32_t length32  = DWORDFromMemory(&pHeader[4]);
+        uint64_t seconds   = ULONGFromMemory(&pHeader[8]);
+        uint64_t micros    = ULONGFromMemory(&pHeader[16]);
+
+        if (length32 > NUM_LEDS)
         {
-            debugW("Not enough data received to process");
+            debugW("More data than we have LEDs\n");
             return false;
         }
 
-        #if 0
-            debugV("========");              
-            for (int i = 0; i < 24; i++)
-                debugV("%02x ", payloadData[i]);
-            debugV("========");
-        #endif
-
-        uint16_t command16 = WORDFromMemory(&payloadData[0]);
-        uint16_t channel16 = WORDFromMemory(&payloadData[2]);
-        uint32_t length32  = DWORDFromMemory(&payloadData[4]);
-        uint64_t seconds   = ULONGFromMemory(&payloadData[8]);
-        uint64_t micros    = ULONGFromMemory(&payloadData[16]);
-
-        //printf("UpdateFromWire -- Command: %u, Channel: %d, Length: %u, Seconds: %u, Micros: %u\n", command16, channel16, length32, seconds, micros);
-
-        const size_t cbHeader = sizeof(command16) + sizeof(channel16) + sizeof(length32) + sizeof(seconds) + sizeof(micros);
+        if (pHeader != _storage.get())
+            memcpy(_storage.get(), pHeader, WireHeaderSize);
 
         _timeStampSeconds      = seconds;
         _timeStampMicroseconds = micros;
         _pixelCount            = length32;
+        _bSummed               = false;
 
-        if (payloadLength < length32 * sizeof(CRGB) + cbHeader)
+        debugV("seconds, micros: %llu.%llu", seconds, micros);
+        return true;
+    }
+
+    // UpdateFromWire
+    //
+    // Fills the buffer from a complete packet that's already sitting somewhere else in memory.  This
+    // is the copying path; the socket server avoids it by reading into WireStorage() directly.
+
+    bool UpdateFromWire(const uint8_t * payloadData, size_t payloadLength)
+    {
+        if (payloadLength < WireHeaderSize)
         {
-            debugW("command16: %d   length32: %d,  payloadLength: %d\n", command16, length32, payloadLength);
-            debugW("Data size mismatch");
+            debugW("Not enough data received to process");
             return false;
         }
-        if (length32 > NUM_LEDS)
+
+        uint32_t length32 = DWORDFromMemory(&payloadData[4]);
+        if (payloadLength < length32 * sizeof(CRGB) + WireHeaderSize)
         {
-            debugW("More data than we have LEDs\n");
+            debugW("length32: %d,  payloadLength: %d\n", length32, payloadLength);
+            debugW("Data size mismatch");
             return false;
         }
-        debugV("PayloadLength: %d, command16: %d, Length32: %d", payloadLength, command16, length32);
-        
-        CRGB * pRGB = reinterpret_cast<CRGB *>(&payloadData[cbHeader]);
 
-        memcpy((void *)_leds.get(), pRGB, length32 * sizeof(CRGB));
-        debugV("seconds, micros: %llu.%llu", seconds, micros);
+        if (!SetFromWireHeader(payloadData))
+            return false;
+
+        // The copy adds up the pixels as it goes, so the draw task never has to walk them for the power limit
+
+        _sums = PixelSums();
+        _sums.Copy(_leds, &payloadData[WireHeaderSize], length32);
+        _bSummed = true;
+        g_cbIngestCopied += length32 * sizeof(CRGB);
+
         debugV("Color0: %08x", (uint32_t) _leds[0]);
         return true;
     }
 
+    // SumPixels
+    //
+    // Adds up the pixels, unless the way they came in already did.  Frames read or decompressed straight into
+    // WireStorage() get their totals here, once they're complete.
+
+    void SumPixels()
+    {
+        if (_bSummed)
+            return;
+
+        _sums = PixelSums();
+        _sums.Add(_leds, _pixelCount);
+        _bSummed = true;
+    }
+
+    // CopyFrom
+    //
+    // Duplicates another buffer's frame, for packets addressed to more than one channel
+
+    void CopyFrom(const LEDBuffer & source)
+    {
+        memcpy(_storage.get(), source._storage.get(), WireHeaderSize + source._pixelCount * sizeof(CRGB));
+        g_cbIngestCopied += source._pixelCount * sizeof(CRGB);
+
+        _timeStampSeconds      = source._timeStampSeconds;
+        _timeStampMicroseconds = source._timeStampMicroseconds;
+        _pixelCount            = source._pixelCount;
+        _sums                  = source._sums;
+        _bSummed               = source._bSummed;
+    }
+
+    // UpdateFromDelta
+    //
+    // Fills the buffer from a WIFI_COMMAND_PIXELDELTA64 packet, whose length32 is the number of span bytes that
+    // follow the header rather than a pixel count.  The header is DeltaHeaderSize long, since it also names the
+    // base frame the spans were encoded against; the caller finds that frame (see LEDBufferManager::DeltaBase)
+    // and passes it as pReference, or nullptr to decode against black.  The spans are decoded in one pass,
+    // front to back.  Each span starts with a tag byte: the top two bits are the DeltaOp, and the low six bits
+    // are the pixel count, or 0 if a 16-bit little-endian count follows.
+    //
+    //   DeltaSkip      Pixels are unchanged from the reference frame
+    //   DeltaLiteral   count CRGBs follow
+    //   DeltaRun       One CRGB follows, repeated count times
+    //
+    // pReference may be this very buffer, in which case skipped pixels are simply left alone.
+
+    enum DeltaOp : uint8_t
+    {
+        DeltaSkip    = 0,
+        DeltaLiteral = 1,
+        DeltaRun     = 2
+    };
+
+    bool UpdateFromDelta(const uint8_t * payloadData, size_t payloadLength, const LEDBuffer * pReference)
+    {
+        if (payloadLength < DeltaHeaderSize)
+        {
+            debugW("Not enough data received to process");
+            return false;
+        }
+
+        uint32_t cbSpans = DWORDFromMemory(&payloadData[4]);
+        if (payloadLength < DeltaHeaderSize + cbSpans)
+        {
+            debugW("Delta data size mismatch: %u bytes of spans promised, %u received", cbSpans, payloadLength - DeltaHeaderSize);
+            return false;
+        }
+
+        const uint8_t * p    = &payloadData[DeltaHeaderSize];
+        const uint8_t * pEnd = p + cbSpans;
+        size_t cPixels = 0;
+        PixelSums sums;
+
+        while (p < pEnd)
+        {
+            uint8_t op    = *p >> 6;
+            size_t  count = *p++ & 0x3F;
+            if (count == 0)
+            {
+                if (pEnd - p < 2)
+                    return false;
+                count = WORDFromMemory(p);
+                p += 2;
+            }
+
+            if (count == 0 || cPixels + count > NUM_LEDS)
+            {
+                debugW("Bad delta span of %u pixels at pixel %u", count, cPixels);
+                return false;
+            }
+
+            CRGB * pDest = &_leds[cPixels];
+            switch (op)
+            {
+                case DeltaSkip:
+                {
+                    size_t cKept = 0;
+                    if (pReference && cPixels < pReference->_pixelCount)
+                        cKept = std::min(count, (size_t) pReference->_pixelCount - cPixels);
+
+                    if (pReference != this && cKept)
+                    {
+                        sums.Copy(pDest, (const uint8_t *) &pReference->_leds[cPixels], cKept);
+                        g_cbIngestCopied += cKept * sizeof(CRGB);
+                    }
+                    else
+                    {
+                        sums.Add(pDest, cKept);
+                    }
+                    memset((void *) (pDest + cKept), 0, (count - cKept) * sizeof(CRGB));
+                    sums.Add(CRGB::Black, count - cKept);
+                    break;
+                }
+
+                case DeltaLiteral:
+                    if ((size_t)(pEnd - p) < count * sizeof(CRGB))
+                        return false;
+                    sums.Copy(pDest, p, count);
+                    p += count * sizeof(CRGB);
+                    break;
+
+                case DeltaRun:
+                {
+                    if (pEnd - p < (ptrdiff_t) sizeof(CRGB))
+                        return false;
+                    CRGB color(p[0], p[1], p[2]);
+                    p += sizeof(CRGB);
+                    for (size_t i = 0; i < count; i++)
+                        pDest[i] = color;
+                    sums.Add(color, count);
+                    break;
+                }
+
+                default:
+                    debugW("Unknown delta op %u", op);
+                    return false;
+            }
+            cPixels += count;
+        }
+
+        if (payloadData != _storage.get())
+            memcpy(_storage.get(), payloadData, WireHeaderSize);
+
+        _timeStampSeconds      = ULONGFromMemory(&payloadData[8]);
+        _timeStampMicroseconds = ULONGFromMemory(&payloadData[16]);
+        _pixelCount            = cPixels;
+        _sums                  = sums;
+        _bSummed               = true;
+        return true;
+    }
+
     void DrawBuffer() 
     {
         _timeStampMicroseconds = 0;
         _timeStampSeconds      = 0;
-        _pStrand->fillLeds(_leds.get());
+        _pStrand->fillLeds(_leds);
+    }
+};
+
+// IndexRing
+//
+// A fixed-size ring of slot numbers that can be shared between two tasks without a lock.
+// Push() may only ever be called from one task and TryPop() from one other.  The capacity is
+// rounded up to a power of two so the free-running head and tail counters can simply wrap.
+
+class IndexRing
+{
+    std::unique_ptr<std::atomic<uint16_t> []> _aEntries;
+    size_t                                    _mask;
+    std::atomic<size_t>                       _head;          // Next entry to write; only the producer moves it
+    std::atomic<size_t>                       _tail;          // Oldest entry; only the consumer moves it
+
+  public:
+
+    explicit IndexRing(size_t cMinEntries)
+      : _head(0),
+        _tail(0)
+    {
+        size_t cEntries = 1;
+        while (cEntries < cMinEntries)
+            cEntries <<= 1;
+
+        _aEntries = std::make_unique<std::atomic<uint16_t> []>(cEntries);
+        _mask = cEntries - 1;
+    }
+
+    // Count
+    //
+    // Tail is read first so that the head we compare it against can only be newer, never older
+
+    size_t Count() const
+    {
+        size_t tail = _tail.load(std::memory_order_acquire);
+        return _head.load(std::memory_order_acquire) - tail;
+    }
+
+    // Push
+    //
+    // The caller guarantees there's room, which is easy since the ring is never asked to hold
+    // more entries than the pool has buffers
+
+    void Push(uint16_t value)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        _aEntries[head & _mask].store(value, std::memory_order_relaxed);
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    bool TryPop(uint16_t & value)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire))
+            return false;
+
+        value = _aEntries[tail & _mask].load(std::memory_order_relaxed);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // PeekOldest, PeekNewest, Peek
+    //
+    // Non-destructive looks into the ring.  Since only the consumer pops, the oldest entry it peeks
+    // at stays put until it pops it itself.  From any other task the entry may be popped out from
+    // under you, so treat the answer as a hint.
+
+    bool PeekOldest(uint16_t & value) const
+    {
+        return Peek(0, value);
+    }
+
+    bool PeekNewest(uint16_t & value) const
+    {
+        size_t head = _head.load(std::memory_order_acquire);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = _aEntries[(head - 1) & _mask].load(std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Peek(size_t index, uint16_t & value) const
+    {
+        size_t tail = _tail.load(std::memory_order_acquire);
+        if (index >= _head.load(std::memory_order_acquire) - tail)
+            return false;
+        value = _aEntries[(tail + index) & _mask].load(std::memory_order_relaxed);
+        return true;
     }
 };
 
 // LEDBufferManager
 //
-// Manages a circular buffer of LEDBuffer objects.  The buffer itself is an array of shared_ptrs to
-// LEDBuffer objects.  The buffer is managed through a unique_ptr.  The LEDBuffer objects are managed
-// through shared_ptrs as they are also returned to callers.
+// Hands frames from the socket task (the producer) to the draw task (the consumer) without either
+// one ever blocking the other.  The LEDBuffers live in a fixed pool, and what moves between the
+// tasks are just their slot numbers, through two lock-free rings: _readyRing holds filled frames
+// oldest first, and _freeRing returns drawn frames to the producer.
+//
+// At any moment every slot is owned by exactly one party, so no buffer is ever written while it
+// is being read:
+//
+//   - the producer's write buffer, which it fills via GetNewBuffer() and publishes with CommitNewBuffer()
+//   - the consumer's draw buffer, returned by GetOldestBuffer() and valid until its next call
+//   - frames waiting in _readyRing (at most cBuffers of them)
+//   - spares in _freeRing
+//
+// Only the consumer ever takes frames out of _readyRing, so a frame it has peeked at can't be
+// recycled and rewritten before it pops it.  That means when the ready ring is full the producer
+// drops the frame it was about to queue, rather than overwriting the oldest one as the old
+// mutex-based version did.
 
 class LEDBufferManager
 {
-    const std::unique_ptr<std::shared_ptr<LEDBuffer> []> _ppBuffers;          // The circular array of buffer ptrs
-    std::shared_ptr<LEDBuffer>                           _pLastBufferAdded;   // Keeps track of the MRU buffer
-    size_t                                               _iNextBuffer;        // Head pointer index
-    size_t                                               _iLastBuffer;        // Tail pointer index
-    uint32_t                                             _cBuffers;           // Number of buffers
-    double                                               _BufferAgeOldest = 0;
-    double                                               _BufferAgeNewest = 0;
-   
+  public:
+
+    // Slots beyond the queue depth: one the producer is writing, one the consumer is drawing,
+    // and one that may be in flight between the two rings during GetOldestBuffer.  With those,
+    // the free ring is never empty while the ready ring has room.
+
+    static constexpr uint32_t SpareBuffers = 3;
+
+  private:
+
+    const std::unique_ptr<psram_unique_ptr<LEDBuffer> []> _apBuffers;         // The pool of buffers, indexed by slot
+    uint32_t                                             _cBuffers;           // Max frames queued for drawing
+    IndexRing                                            _readyRing;          // Filled frames, oldest first
+    IndexRing                                            _freeRing;           // Drawn frames returned to the producer
+    uint16_t                                             _iWriting;           // Owned by the producer
+    uint16_t                                             _iLastCommitted;     // Also the producer's; UINT16_MAX until the first frame
+    uint16_t                                             _iDrawing;           // Owned by the consumer
+    uint64_t                                             _lastSeconds;        // Timestamp of _iLastCommitted as committed, since
+    uint64_t                                             _lastMicros;         //   drawing a buffer zeroes its own copy
+    std::atomic<bool>                                    _bKeyframeWanted;    // A delta was refused since the last frame queued
+
+    uint32_t PoolSize() const
+    {
+        return _cBuffers + SpareBuffers;
+    }
+
+    static double BufferTime(const LEDBuffer * pBuffer)
+    {
+        return pBuffer->Seconds() + pBuffer->MicroSeconds() / (double) MICROS_PER_SECOND;
+    }
+
   public:
 
     LEDBufferManager(uint32_t cBuffers, std::shared_ptr<GFXBase> pGFX)
-     : _ppBuffers(std::make_unique<std::shared_ptr<LEDBuffer> []>(cBuffers)), // Create the circular array of ptrs
-       _iNextBuffer(0),
-       _iLastBuffer(0),
-       _cBuffers(cBuffers)
+     : _apBuffers(std::make_unique<psram_unique_ptr<LEDBuffer> []>(cBuffers + SpareBuffers)),
+       _cBuffers(cBuffers),
+       _readyRing(cBuffers + SpareBuffers),
+       _freeRing(cBuffers + SpareBuffers),
+       _iWriting(0),
+       _iLastCommitted(UINT16_MAX),
+       _iDrawing(1),
+       _lastSeconds(0),
+       _lastMicros(0),
+       _bKeyframeWanted(false)
     {
-        // The initializer creates a uniquely owned table of shared pointers.
-        // We exclusively can see the table, but the buffer objects it contains
-        // are returned back out to callers so they must be shared pointers.
+        if (PoolSize() > UINT16_MAX)
+            throw std::runtime_error("Too many LED buffers requested");
 
-        for (int i = 0; i < _cBuffers; i++)
+        for (uint32_t i = 0; i < PoolSize(); i++)
         {
             #if USE_PSRAM
-                _ppBuffers[i] = std::allocate_shared<LEDBuffer>(psram_allocator<LEDBuffer>(), pGFX);
+                void * pMemory = psram_allocator<LEDBuffer>().allocate(1);
+                if (!pMemory)
+                    throw std::runtime_error("Could not allocate LED buffer in PSRAM");
+                _apBuffers[i].reset(new (pMemory) LEDBuffer(pGFX));
             #else
-                _ppBuffers[i] = std::make_shared<LEDBuffer>(pGFX);
+                _apBuffers[i] = std::make_unique<LEDBuffer>(pGFX);
             #endif
         }
+
+        // Slots 0 and 1 start out as the write and draw buffers; the rest are free
+
+        for (uint32_t i = 2; i < PoolSize(); i++)
+            _freeRing.Push(i);
     }
 
-    double AgeOfOldestBuffer()
+    double AgeOfOldestBuffer() const
     {
-        if (false == IsEmpty())
-        {
-            auto pOldest = PeekOldestBuffer();
-            return (pOldest->Seconds() + pOldest->MicroSeconds() / (double) MICROS_PER_SECOND) - g_AppTime.CurrentTime();
-        }
-        else
-        {
-            return 0.0;
-        }
+        auto pOldest = PeekOldestBuffer();
+        return pOldest ? BufferTime(pOldest) - g_AppTime.CurrentTime() : 0.0;
     }
 
-    double AgeOfNewestBuffer()
+    double AgeOfNewestBuffer() const
     {
-        if (false == IsEmpty())
-        {
-            auto pNewest = PeekNewestBuffer();
-            return (pNewest->Seconds() + pNewest->MicroSeconds() / (double) MICROS_PER_SECOND) - g_AppTime.CurrentTime();
-        }
-        else
-        {
-            return 0.0;
-        }
+        auto pNewest = PeekNewestBuffer();
+        return pNewest ? BufferTime(pNewest) - g_AppTime.CurrentTime() : 0.0;
     }
 
     // BufferCount
     //
     // The fixed, maximum size of the whole thing if it were full
 
-    size_t BufferCount() const   
-    { 
-        return _cBuffers; 
+    size_t BufferCount() const
+    {
+        return _cBuffers;
     }
-    
+
     // Depth
-    // 
+    //
     // The variable, current count of buffers in use
 
     size_t Depth() const
     {
-        if (_iNextBuffer < _iLastBuffer)
-            return (_iNextBuffer + _cBuffers - _iLastBuffer);
-        else
-            return _iNextBuffer - _iLastBuffer;
+        return _readyRing.Count();
     }
 
     inline bool IsEmpty() const
     {
-        return _iNextBuffer == _iLastBuffer;
+        return Depth() == 0;
     }
 
     // PeekNewestBuffer
     //
     // Get a pointer to the most recently added (newest) buffer, or nullptr if empty
 
-    std::shared_ptr<LEDBuffer> PeekNewestBuffer() const
+    const LEDBuffer * PeekNewestBuffer() const
     {
-        if (IsEmpty())
-            return nullptr; 
-        return _pLastBufferAdded;
+        uint16_t iSlot;
+        return _readyRing.PeekNewest(iSlot) ? _apBuffers[iSlot].get() : nullptr;
     }
 
     // GetNewBuffer
     //
-    // Grabs the next buffer in the circle, advancing the tail pointer as well if we've
-    // 'caught up' to the head pointer, which effective throws away that buffer via reuse
+    // Producer only.  Returns the buffer to fill with the next frame.  Nobody else can see it
+    // until CommitNewBuffer(), so a frame that fails to decode can simply be abandoned and the
+    // same buffer will be handed out again next time.
 
-    std::shared_ptr<LEDBuffer> GetNewBuffer()
+    LEDBuffer * GetNewBuffer()
     {
-        auto pResult = _ppBuffers[_iNextBuffer++];
+        return _apBuffers[_iWriting].get();
+    }
 
-        if (IsEmpty())
-            _iLastBuffer++;
+    // CommitNewBuffer
+    //
+    // Producer only.  Publishes the buffer from GetNewBuffer() to the consumer, unless the queue is
+    // already full, in which case the frame is dropped and the buffer is kept for the next one.
+    // Returns false if the frame was dropped.
 
-        _iLastBuffer %= _cBuffers;
-        _iNextBuffer %= _cBuffers;
-        
-        _pLastBufferAdded = pResult;
-        
-        return pResult;
+    bool CommitNewBuffer()
+    {
+        if (_readyRing.Count() >= _cBuffers)
+        {
+            debugV("LED buffer queue full, dropping frame");
+            return false;
+        }
+
+        uint16_t iNext;
+        if (!_freeRing.TryPop(iNext))
+        {
+            debugW("No free LED buffer, dropping frame");
+            return false;
+        }
+
+        // The timestamp is noted before the push, after which the consumer may already be drawing it
+
+        _lastSeconds = _apBuffers[_iWriting]->Seconds();
+        _lastMicros  = _apBuffers[_iWriting]->MicroSeconds();
+        _bKeyframeWanted = false;
+
+        _readyRing.Push(_iWriting);
+        _iLastCommitted = _iWriting;
+        _iWriting = iNext;
+        g_cIngestFrames++;
+        return true;
+    }
+
+    // DeltaBase
+    //
+    // Producer only.  The buffer to decode a PIXELDELTA64 packet against.  A delta is only any good applied to
+    // the very frame it was encoded from, which the packet names by timestamp, and that has to be the frame most
+    // recently passed to CommitNewBuffer.  If the sender encoded it against a frame that never made it here (lost,
+    // dropped for a full queue, or refused itself), every pixel it skips would be wrong, so this returns nullptr,
+    // and the caller should refuse the delta and RequestKeyframe().
+    //
+    // Whether the base is still queued, being drawn, or back in the free ring, only the producer ever writes to a
+    // buffer's pixels, so they're intact.  It may even come back around as GetNewBuffer() itself.
+
+    const LEDBuffer * DeltaBase(const uint8_t * payloadData, size_t payloadLength) const
+    {
+        if (_iLastCommitted == UINT16_MAX || payloadLength < LEDBuffer::DeltaHeaderSize)
+            return nullptr;
+
+        uint64_t seconds = ULONGFromMemory(&payloadData[LEDBuffer::WireHeaderSize]);
+        uint64_t micros  = ULONGFromMemory(&payloadData[LEDBuffer::WireHeaderSize + sizeof(uint64_t)]);
+        if (seconds != _lastSeconds || micros != _lastMicros)
+        {
+            debugV("Delta against %llu.%06llu, but the last frame queued was %llu.%06llu", seconds, micros, _lastSeconds, _lastMicros);
+            return nullptr;
+        }
+
+        return _apBuffers[_iLastCommitted].get();
+    }
+
+    // RequestKeyframe, KeyframeWanted
+    //
+    // Set by the producer when it refuses a delta, and cleared when a frame is next queued.  The sender sees it in
+    // the SocketResponse and sends a full frame, since until then any delta it sends is against the wrong frame.
+
+    void RequestKeyframe()
+    {
+        _bKeyframeWanted = true;
+    }
+
+    bool KeyframeWanted() const
+    {
+        return _bKeyframeWanted;
     }
 
     // GetOldestBuffer
-    // 
-    // Return a pointer to the very oldest buffer, or nullptr if empty
+    //
+    // Consumer only.  Takes the oldest frame out of the queue, or returns nullptr if empty.  The
+    // buffer belongs to the caller until the next call, at which point it's recycled.  If the
+    // producer queued the same timestamp more than once (a resent frame), only the last copy is
+    // returned, since it supersedes the earlier ones.
 
-    std::shared_ptr<LEDBuffer> GetOldestBuffer() 
+    LEDBuffer * GetOldestBuffer()
     {
-        if (IsEmpty())
-            return nullptr; 
+        uint16_t iSlot;
+        if (!_readyRing.TryPop(iSlot))
+            return nullptr;
+
+        uint16_t iNext;
+        while (_readyRing.PeekOldest(iNext)
+               && _apBuffers[iNext]->MicroSeconds() != 0
+               && _apBuffers[iNext]->MicroSeconds() == _apBuffers[iSlot]->MicroSeconds()
+               && _apBuffers[iNext]->Seconds() == _apBuffers[iSlot]->Seconds())
+        {
+            _freeRing.Push(iSlot);
+            _readyRing.TryPop(iSlot);                   // Always iNext, since nobody else pops
+        }
 
-        auto pResult = _ppBuffers[_iLastBuffer];
-        _iLastBuffer++;
-        _iLastBuffer %= _cBuffers;
-        
-        return pResult;
+        _freeRing.Push(_iDrawing);
+        _iDrawing = iSlot;
+        return _apBuffers[iSlot].get();
     }
 
     // PeekOldestBuffer
     //
-    // Take a "peek" at the newest buffer, or nullptr if empty
+    // Take a "peek" at the oldest buffer, or nullptr if empty.  For the consumer it stays put, timestamp
+    // and all, until its own GetOldestBuffer() takes it; for anyone else it's only a hint.
 
-    const std::shared_ptr<LEDBuffer> PeekOldestBuffer() const
+    const LEDBuffer * PeekOldestBuffer() const
     {
-        if (IsEmpty())
-            return nullptr; 
-        
-        return _ppBuffers[_iLastBuffer];
+        uint16_t iSlot;
+        return _readyRing.PeekOldest(iSlot) ? _apBuffers[iSlot].get() : nullptr;
     }
 
-    const std::shared_ptr<LEDBuffer> operator[](size_t index) const
+    const LEDBuffer * operator[](size_t index) const
     {
-        if (IsEmpty())
-            return nullptr; 
-        size_t i = (_iLastBuffer + index) % _cBuffers;
-        return _ppBuffers[i];
+        uint16_t iSlot;
+        return _readyRing.Peek(index, iSlot) ? _apBuffers[iSlot].get() : nullptr;
     }
 };
-
-
@@ -79,6 +79,7 @@ public:
 
     LEDMatrixGFX(size_t w, size_t h) : GFXBase(w, h)
     {
+        _rowMajor = true;                               // See xy() below
     }
 
     ~LEDMatrixGFX()
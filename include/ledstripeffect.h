@@ -34,6 +34,40 @@
 extern bool                      g_bUpdateStarted;
 extern DRAM_ATTR std::shared_ptr<GFXBase> g_aptrDevices[NUM_CHANNELS];
 
+// FramePart
+//
+// A piece of a frame for an effect that can draw its frame in pieces: a range of channels and, within each of
+// them, a range of rows.  On a strip the whole strip is one row.
+
+struct FramePart
+{
+    int channelBegin;
+    int channelEnd;
+    int rowBegin;
+    int rowEnd;
+
+    // Split
+    //
+    // Halves the part, by channel if it has more than one, otherwise by rows.  Returns false if it can't be split.
+
+    bool Split(FramePart & first, FramePart & second) const
+    {
+        first = second = *this;
+
+        if (channelEnd - channelBegin > 1)
+        {
+            first.channelEnd = second.channelBegin = channelBegin + (channelEnd - channelBegin) / 2;
+            return true;
+        }
+        if (rowEnd - rowBegin > 1)
+        {
+            first.rowEnd = second.rowBegin = rowBegin + (rowEnd - rowBegin) / 2;
+            return true;
+        }
+        return false;
+    }
+};
+
 
 // LEDStripEffect
 //
@@ -114,6 +148,38 @@ class LEDStripEffect
         return true;
     }
 
+    // CanDrawSplit
+    //
+    // An effect whose pixels don't depend on one another can return true here and draw its frame in pieces: once
+    // per frame PrepareFrame() to do whatever has to happen once, like advancing the animation, then DrawPart() for
+    // each piece of WholeFrame().  With USE_SPLIT_RENDER, two pieces are drawn at the same time, one on each core,
+    // so DrawPart may only write to the pixels in its part and may not borrow from Scratch().  Draw() still has to
+    // draw the whole frame, which is normally just PrepareFrame() followed by DrawPart(WholeFrame()).
+
+    virtual bool CanDrawSplit() const
+    {
+        return false;
+    }
+
+    virtual FramePart WholeFrame() const
+    {
+        return FramePart { 0, NUM_CHANNELS, 0, _GFX[0]->height() };
+    }
+
+    virtual void PrepareFrame() {}
+    virtual void DrawPart(const FramePart & part) {}
+
+    // FrameSums
+    //
+    // An effect that can total up the pixels of a channel as it draws them, for the power limiter, can return those
+    // totals here so that nothing has to walk the frame again to find them.  They have to cover every LED on the
+    // channel and be for the frame just drawn.
+
+    virtual bool FrameSums(int iChannel, PixelSums & sums) const
+    {
+        return false;
+    }
+
     static inline CRGB RandomRainbowColor()
     {
         static const CRGB colors[] =
@@ -230,8 +296,8 @@ class LEDStripEffect
 
     inline void fadeAllChannelsToBlackBy(uint8_t fadeValue) const
     {
-        for (int i = 0; i < _cLEDs; i++)
-            fadePixelToBlackOnAllChannelsBy(i, fadeValue);
+        for (int i = 0; i < NUM_CHANNELS; i++)
+            FadeSpanToBlackBy(_GFX[i]->leds, _cLEDs, fadeValue);
     }
 
     inline void setAllOnAllChannels(uint8_t r, uint8_t g, uint8_t b) const
@@ -0,0 +1,208 @@
+//+--------------------------------------------------------------------------
+//
+// File:        Adafruit_GFX.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The subset of Adafruit_GFX that GFXBase and the effects rely on: the
+//    primitive shapes, all of which funnel into drawPixel/writePixel so that
+//    GFXBase's overrides see every pixel.  Text calls are accepted and
+//    ignored.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include "gfxfont.h"
+
+class Adafruit_GFX
+{
+  protected:
+
+    int16_t  _width;
+    int16_t  _height;
+    int16_t  cursor_x   = 0;
+    int16_t  cursor_y   = 0;
+    uint16_t textcolor  = 0xFFFF;
+    uint8_t  textsize_x = 1;
+    uint8_t  textsize_y = 1;
+    uint8_t  rotation   = 0;
+    bool     wrap       = true;
+    const GFXfont * gfxFont = nullptr;
+
+  public:
+
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h)
+    {
+    }
+
+    virtual ~Adafruit_GFX()
+    {
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite() {}
+    virtual void endWrite()   {}
+
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color)
+    {
+        drawPixel(x, y, color);
+    }
+
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+        bool steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep)
+        {
+            std::swap(x0, y0);
+            std::swap(x1, y1);
+        }
+        if (x0 > x1)
+        {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+
+        int16_t dx = x1 - x0;
+        int16_t dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = (y0 < y1) ? 1 : -1;
+
+        for (; x0 <= x1; x0++)
+        {
+            if (steep)
+                writePixel(y0, x0, color);
+            else
+                writePixel(x0, y0, color);
+            err -= dy;
+            if (err < 0)
+            {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+        writeLine(x, y, x, y + h - 1, color);
+    }
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+        writeLine(x, y, x + w - 1, y, color);
+    }
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        for (int16_t i = x; i < x + w; i++)
+            drawFastVLine(i, y, h, color);
+    }
+
+    virtual void fillScreen(uint16_t color)
+    {
+        fillRect(0, 0, _width, _height, color);
+    }
+
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+        if (x0 == x1)
+            drawFastVLine(x0, std::min(y0, y1), abs(y1 - y0) + 1, color);
+        else if (y0 == y1)
+            drawFastHLine(std::min(x0, x1), y0, abs(x1 - x0) + 1, color);
+        else
+            writeLine(x0, y0, x1, y1, color);
+    }
+
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+    {
+        int16_t f = 1 - r;
+        int16_t ddF_x = 1;
+        int16_t ddF_y = -2 * r;
+        int16_t x = 0;
+        int16_t y = r;
+
+        writePixel(x0, y0 + r, color);
+        writePixel(x0, y0 - r, color);
+        writePixel(x0 + r, y0, color);
+        writePixel(x0 - r, y0, color);
+
+        while (x < y)
+        {
+            if (f >= 0)
+            {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+
+            writePixel(x0 + x, y0 + y, color);
+            writePixel(x0 - x, y0 + y, color);
+            writePixel(x0 + x, y0 - y, color);
+            writePixel(x0 - x, y0 - y, color);
+            writePixel(x0 + y, y0 + x, color);
+            writePixel(x0 - y, y0 + x, color);
+            writePixel(x0 + y, y0 - x, color);
+            writePixel(x0 - y, y0 - x, color);
+        }
+    }
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+    {
+        for (int16_t y = -r; y <= r; y++)
+        {
+            int16_t w = (int16_t) sqrt(r * r - y * y);
+            drawFastHLine(x0 - w, y0 + y, 2 * w + 1, color);
+        }
+    }
+
+    void setCursor(int16_t x, int16_t y)        { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c)               { textcolor = c; }
+    void setTextColor(uint16_t c, uint16_t)     { textcolor = c; }
+    void setTextSize(uint8_t s)                 { textsize_x = textsize_y = s; }
+    void setTextWrap(bool w)                    { wrap = w; }
+    void setFont(const GFXfont * f = nullptr)   { gfxFont = f; }
+    void setRotation(uint8_t r)                 { rotation = r & 3; }
+
+    size_t print(const char *)                  { return 0; }
+    size_t print(const String &)                { return 0; }
+    size_t println(const char * = "")           { return 0; }
+    size_t printf(const char *, ...)            { return 0; }
+
+    int16_t width() const                       { return _width; }
+    int16_t height() const                      { return _height; }
+    uint8_t getRotation() const                 { return rotation; }
+};
@@ -0,0 +1,333 @@
+//+--------------------------------------------------------------------------
+//
+// File:        Arduino.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Just enough of the Arduino-ESP32 core (and the bits of FreeRTOS and
+//    ESP-IDF that come along with it) to build the drawing code on a
+//    desktop host.  Only used by the [env:native] build, which puts the
+//    include/native folder ahead of everything else on the include path.
+//
+//    Timing is real wall-clock time, tasks are std::threads, and anything
+//    that would touch hardware is a no-op that reports success.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#define ARDUINO 10805
+#define ARDUINO_ARCH_NATIVE 1
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define PROGMEM
+#define PGM_P                   const char *
+#define F(s)                    (s)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+
+#define HIGH                    0x1
+#define LOW                     0x0
+#define INPUT                   0x01
+#define OUTPUT                  0x02
+#define INPUT_PULLUP            0x05
+
+#ifndef PI
+#define PI                      3.1415926535897932384626433832795
+#endif
+#define HALF_PI                 1.5707963267948966192313216916398
+#define TWO_PI                  6.283185307179586476925286766559
+#define DEG_TO_RAD              0.017453292519943295769236907684886
+#define RAD_TO_DEG              57.295779513082320876798154814105
+#define radians(deg)            ((deg)*DEG_TO_RAD)
+#define degrees(rad)            ((rad)*RAD_TO_DEG)
+
+using std::abs;
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+// Timing
+//
+// millis() and micros() are measured from process start, like they are from boot on the chip
+
+uint32_t millis();
+uint32_t micros();
+void     delay(int ms);
+void     delayMicroseconds(unsigned int us);
+void     yield();
+
+// Virtual clock
+//
+// Normally time is real.  The benchmark harness freezes it and steps it by hand so that every
+// effect sees the same frame times on every run.  gettimeofday is routed through the shim so
+// that AppTime and the LEDBuffer timestamps follow the virtual clock as well.
+
+void NativeClockFreeze(int64_t usSinceBoot);
+void NativeClockAdvance(int64_t us);
+void NativeClockRelease();
+int  NativeGetTimeOfDay(struct timeval * tv, void * tz);
+
+#define gettimeofday NativeGetTimeOfDay
+
+// Pins
+//
+// There's nothing on the other end of any pin in the native build
+
+inline void pinMode(uint8_t, uint8_t)        {}
+inline void digitalWrite(uint8_t, uint8_t)   {}
+inline int  digitalRead(uint8_t)             { return LOW; }
+inline int  analogRead(uint8_t)              { return 0; }
+inline void ledcSetup(uint8_t, double, uint8_t) {}
+inline void ledcAttachPin(uint8_t, uint8_t)  {}
+inline void ledcWrite(uint8_t, uint32_t)     {}
+
+// Math helpers
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+// String
+//
+// The Arduino String is close enough to std::string for everything we do with it
+
+class String : public std::string
+{
+  public:
+
+    String() = default;
+    String(const char * psz)               : std::string(psz ? psz : "") {}
+    String(const std::string & str)        : std::string(str) {}
+    String(const char * psz, size_t len)   : std::string(psz, len) {}
+    explicit String(char c)                : std::string(1, c) {}
+    explicit String(int value)             : std::string(std::to_string(value)) {}
+    explicit String(unsigned int value)    : std::string(std::to_string(value)) {}
+    explicit String(long value)            : std::string(std::to_string(value)) {}
+    explicit String(unsigned long value)   : std::string(std::to_string(value)) {}
+    explicit String(double value, unsigned int decimals = 2)
+    {
+        char sz[32];
+        snprintf(sz, sizeof(sz), "%.*f", decimals, value);
+        assign(sz);
+    }
+
+    bool isEmpty() const                           { return empty(); }
+    String substring(size_t from) const            { return from < size() ? String(substr(from)) : String(); }
+    String substring(size_t from, size_t to) const { return from < to && from < size() ? String(substr(from, to - from)) : String(); }
+    int indexOf(char c) const                      { auto i = find(c); return i == npos ? -1 : (int) i; }
+    int indexOf(const char * psz) const            { auto i = find(psz); return i == npos ? -1 : (int) i; }
+    long toInt() const                             { return atol(c_str()); }
+    float toFloat() const                          { return (float) atof(c_str()); }
+    bool startsWith(const String & str) const      { return rfind(str, 0) == 0; }
+    bool equals(const String & str) const          { return *this == str; }
+
+    bool equalsIgnoreCase(const String & str) const
+    {
+        return size() == str.size() && std::equal(begin(), end(), str.begin(), [](char a, char b) { return tolower(a) == tolower(b); });
+    }
+};
+
+// HardwareSerial
+//
+// Serial output goes to stdout; there is never anything to read
+
+class HardwareSerial
+{
+  public:
+
+    void begin(unsigned long)                       {}
+    void end()                                      {}
+    void flush()                                    { fflush(stdout); }
+    int  available()                                { return 0; }
+    int  read()                                     { return -1; }
+    size_t readBytes(uint8_t *, size_t)             { return 0; }
+    size_t write(uint8_t b)                         { return fwrite(&b, 1, 1, stdout); }
+    size_t write(const uint8_t * p, size_t len)     { return fwrite(p, 1, len, stdout); }
+
+    size_t print(const char * psz)                  { return fputs(psz, stdout) >= 0 ? strlen(psz) : 0; }
+    size_t print(const String & str)                { return print(str.c_str()); }
+    size_t print(char c)                            { return printf("%c", c); }
+    size_t print(int n)                             { return printf("%d", n); }
+    size_t print(unsigned int n)                    { return printf("%u", n); }
+    size_t print(long n)                            { return printf("%ld", n); }
+    size_t print(unsigned long n)                   { return printf("%lu", n); }
+    size_t print(double d, int digits = 2)          { return printf("%.*f", digits, d); }
+
+    size_t println()                                { return print("\n"); }
+    template<typename T>
+    size_t println(const T & value)                 { return print(value) + println(); }
+
+    size_t printf(const char * fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list args;
+        va_start(args, fmt);
+        int len = vprintf(fmt, args);
+        va_end(args);
+        return len < 0 ? 0 : len;
+    }
+};
+
+extern HardwareSerial Serial;
+
+// ESP-IDF bits
+//
+// Error codes, logging, and the chip/heap queries that the stats code makes
+
+typedef int esp_err_t;
+
+#define ESP_OK                          0
+#define ESP_FAIL                        -1
+#define ESP_ERR_INVALID_STATE           0x103
+#define ESP_ERR_NVS_NO_FREE_PAGES       0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND   0x1110
+#define ESP_ERROR_CHECK(x)              do { esp_err_t __err = (x); if (__err != ESP_OK) { fprintf(stderr, "ESP_ERROR_CHECK failed: %d at %s:%d\n", __err, __FILE__, __LINE__); abort(); } } while (0)
+#define ESP_INTR_FLAG_LEVEL1            (1<<1)
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+#define ESP_IDF_VERSION                 ESP_IDF_VERSION_VAL(4, 4, 0)
+
+// Like the Arduino core, the tag is dropped, which is why callers get away without defining one
+
+#define ESP_LOGE(tag, fmt, ...)         fprintf(stderr, "[E] " fmt "\n", ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)         fprintf(stderr, "[W] " fmt "\n", ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)         do {} while (0)
+#define ESP_LOGD(tag, fmt, ...)         do {} while (0)
+#define ESP_LOGV(tag, fmt, ...)         do {} while (0)
+
+typedef enum { ESP_LOG_NONE, ESP_LOG_ERROR, ESP_LOG_WARN, ESP_LOG_INFO, ESP_LOG_DEBUG, ESP_LOG_VERBOSE } esp_log_level_t;
+inline void esp_log_level_set(const char *, esp_log_level_t) {}
+
+inline esp_err_t esp_efuse_mac_get_default(uint8_t * mac)
+{
+    static const uint8_t abMac[6] = { 0x02, 0x00, 0x00, 0x4e, 0x44, 0x53 };     // Locally administered, "NDS"
+    memcpy(mac, abMac, sizeof(abMac));
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time();
+
+#define MALLOC_CAP_8BIT     (1<<2)
+#define MALLOC_CAP_INTERNAL (1<<11)
+#define MALLOC_CAP_SPIRAM   (1<<10)
+
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_total_size(uint32_t caps);
+inline bool heap_caps_check_integrity_all(bool) { return true; }
+
+inline bool   psramInit()             { return false; }
+inline void * ps_malloc(size_t size)  { return malloc(size); }
+inline void * ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+
+class EspClass
+{
+  public:
+
+    uint32_t getHeapSize()              { return heap_caps_get_total_size(MALLOC_CAP_INTERNAL); }
+    uint32_t getFreeHeap()              { return heap_caps_get_free_size(MALLOC_CAP_INTERNAL); }
+    uint32_t getMinFreeHeap()           { return getFreeHeap(); }
+    uint32_t getMaxAllocHeap()          { return heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL); }
+    uint32_t getPsramSize()             { return 0; }
+    uint32_t getFreePsram()             { return 0; }
+    uint32_t getMinFreePsram()          { return 0; }
+    uint32_t getMaxAllocPsram()         { return 0; }
+    uint32_t getCpuFreqMHz()            { return 240; }
+    uint32_t getFlashChipSize()         { return 4 * 1024 * 1024; }
+    uint32_t getSketchSize()            { return 0; }
+    uint32_t getFreeSketchSpace()       { return 0; }
+    uint8_t  getChipCores()             { return 2; }
+    const char * getChipModel()         { return "Native"; }
+    void     restart()                  { exit(0); }
+};
+
+extern EspClass ESP;
+
+// FreeRTOS
+//
+// Tasks run as detached std::threads.  Priorities and core affinity are accepted and ignored.
+
+typedef int             BaseType_t;
+typedef unsigned int    UBaseType_t;
+typedef uint32_t        TickType_t;
+typedef void *          TaskHandle_t;
+typedef void *          QueueHandle_t;                  // Only handed to i2s_driver_install, which ignores it
+typedef void (*TaskFunction_t)(void *);
+
+#define pdTRUE                  1
+#define pdFALSE                 0
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS        portTICK_PERIOD_MS
+#define portMAX_DELAY           ((TickType_t) 0xffffffffUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms) / portTICK_PERIOD_MS)
+#define tskIDLE_PRIORITY        0
+#define tskNO_AFFINITY          0x7FFFFFFF
+#define ESP_TASK_MAIN_STACK     8192
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
+                                   const char * pcName,
+                                   uint32_t usStackDepth,
+                                   void * pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * pvCreatedTask,
+                                   BaseType_t xCoreID);
+
+void         vTaskDelay(TickType_t ticks);
+void         vTaskDelete(TaskHandle_t task);
+BaseType_t   xPortGetCoreID();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+// Direct to task notifications, used as a counting semaphore
+
+BaseType_t   xTaskNotifyGive(TaskHandle_t task);
+uint32_t     ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t ticksToWait);
+inline TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t) { return nullptr; }
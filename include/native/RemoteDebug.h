@@ -0,0 +1,89 @@
+//+--------------------------------------------------------------------------
+//
+// File:        RemoteDebug.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Stands in for the RemoteDebug telnet console.  The debugX() macros print
+//    straight to stdout, filtered by the current level, which defaults to
+//    INFO so that verbose output doesn't swamp a benchmark run.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+class RemoteDebug
+{
+    uint8_t _level = INFO;
+    String  _lastCommand;
+
+  public:
+
+    static const uint8_t PROFILER   = 0;
+    static const uint8_t VERBOSE    = 1;
+    static const uint8_t DEBUG      = 2;
+    static const uint8_t INFO       = 3;
+    static const uint8_t WARNING    = 4;
+    static const uint8_t ERROR      = 5;
+    static const uint8_t ANY        = 6;
+
+    bool begin(const String &, uint8_t startingDebugLevel = DEBUG)
+    {
+        _level = startingDebugLevel;
+        return true;
+    }
+
+    void handle()                                   {}
+    void stop()                                     {}
+    void setSerialEnabled(bool)                     {}
+    void setResetCmdEnabled(bool)                   {}
+    void showProfiler(bool, uint32_t = 0)           {}
+    void showColors(bool)                           {}
+    void showTime(bool)                             {}
+    void setCallBackProjectCmds(void (*)())         {}
+    bool isConnected()                              { return false; }
+    String getLastCommand()                         { return _lastCommand; }
+
+    void setLevel(uint8_t level)                    { _level = level; }
+    bool isActive(uint8_t level) const              { return level >= _level; }
+
+    size_t printf(const char * fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list args;
+        va_start(args, fmt);
+        int len = vprintf(fmt, args);
+        va_end(args);
+        return len < 0 ? 0 : len;
+    }
+
+    size_t println(const char * psz = "")           { return printf("%s\n", psz); }
+};
+
+#define debugV(fmt, ...) if (Debug.isActive(Debug.VERBOSE)) Debug.printf("(V) " fmt "\n", ##__VA_ARGS__)
+#define debugD(fmt, ...) if (Debug.isActive(Debug.DEBUG))   Debug.printf("(D) " fmt "\n", ##__VA_ARGS__)
+#define debugI(fmt, ...) if (Debug.isActive(Debug.INFO))    Debug.printf("(I) " fmt "\n", ##__VA_ARGS__)
+#define debugW(fmt, ...) if (Debug.isActive(Debug.WARNING)) Debug.printf("(W) " fmt "\n", ##__VA_ARGS__)
+#define debugE(fmt, ...) if (Debug.isActive(Debug.ERROR))   Debug.printf("(E) " fmt "\n", ##__VA_ARGS__)
+#define debugA(fmt, ...) if (Debug.isActive(Debug.ANY))     Debug.printf(fmt "\n", ##__VA_ARGS__)
@@ -0,0 +1,78 @@
+//+--------------------------------------------------------------------------
+//
+// File:        WiFi.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    A WiFi radio that never connects.  The drawing code checks
+//    WiFi.isConnected() before pulling frames off the wire, so this keeps
+//    the native build on local effects.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK } wifi_auth_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_DISCONNECTED = 6 } wl_status_t;
+
+class IPAddress
+{
+    uint8_t _bytes[4] = { 0, 0, 0, 0 };
+
+  public:
+
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes { a, b, c, d } {}
+
+    uint8_t operator[](int i) const { return _bytes[i]; }
+
+    String toString() const
+    {
+        char sz[16];
+        snprintf(sz, sizeof(sz), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+        return String(sz);
+    }
+};
+
+class WiFiClass
+{
+  public:
+
+    wl_status_t begin(const char *, const char *)   { return WL_DISCONNECTED; }
+    bool disconnect(bool = false)                   { return true; }
+    bool mode(wifi_mode_t)                          { return true; }
+    wifi_mode_t getMode()                           { return WIFI_OFF; }
+    wl_status_t status()                            { return WL_DISCONNECTED; }
+    bool isConnected()                              { return false; }
+    IPAddress localIP()                             { return IPAddress(); }
+    int8_t RSSI(uint8_t = 0)                        { return 0; }
+    String SSID(uint8_t = 0)                        { return String(); }
+    wifi_auth_mode_t encryptionType(uint8_t)        { return WIFI_AUTH_OPEN; }
+    int16_t scanNetworks()                          { return 0; }
+    uint8_t * macAddress(uint8_t * mac)             { esp_efuse_mac_get_default(mac); return mac; }
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,50 @@
+//+--------------------------------------------------------------------------
+//
+// File:        WiFiUdp.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    A UDP socket with nobody on the other end.  Enough for NTPTimeClient
+//    to compile; it is never called because WiFi never comes up.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <WiFi.h>
+
+class WiFiUDP
+{
+  public:
+
+    uint8_t begin(uint16_t)                             { return 0; }
+    void stop()                                         {}
+    int beginPacket(IPAddress, uint16_t)                { return 0; }
+    int endPacket()                                     { return 0; }
+    size_t write(const uint8_t *, size_t)               { return 0; }
+    int parsePacket()                                   { return 0; }
+    int available()                                     { return 0; }
+    int read(char *, size_t)                            { return 0; }
+    int read(uint8_t *, size_t)                         { return 0; }
+    void flush()                                        {}
+};
@@ -0,0 +1,41 @@
+//+--------------------------------------------------------------------------
+//
+// File:        driver/adc.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    ADC configuration entry points used by SoundAnalyzer.  All no-ops.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum { ADC_UNIT_1 = 1, ADC_UNIT_2 = 2 } adc_unit_t;
+typedef enum { ADC1_CHANNEL_0 = 0, ADC1_CHANNEL_MAX = 8 } adc1_channel_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+typedef enum { ADC_ATTEN_DB_0 = 0, ADC_ATTEN_DB_11 = 3 } adc_atten_t;
+
+inline esp_err_t adc1_config_width(adc_bits_width_t)                     { return ESP_OK; }
+inline esp_err_t adc1_config_channel_atten(adc1_channel_t, adc_atten_t)  { return ESP_OK; }
@@ -0,0 +1,37 @@
+//+--------------------------------------------------------------------------
+//
+// File:        esp_task_wdt.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Task watchdog.  There is no watchdog on the host, so these all succeed.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+inline esp_err_t esp_task_wdt_add(TaskHandle_t)     { return ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t)  { return ESP_OK; }
+inline esp_err_t esp_task_wdt_reset()               { return ESP_OK; }
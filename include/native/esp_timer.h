@@ -0,0 +1,52 @@
+//+--------------------------------------------------------------------------
+//
+// File:        esp_timer.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    One-shot high resolution timers.  Only what the frame scheduler
+//    uses; see nativeshim.cpp.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef void (*esp_timer_cb_t)(void * arg);
+typedef void * esp_timer_handle_t;
+
+typedef enum { ESP_TIMER_TASK } esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t          callback;
+    void *                  arg;
+    esp_timer_dispatch_t    dispatch_method;
+    const char *            name;
+    bool                    skip_unhandled_events;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t * pArgs, esp_timer_handle_t * pHandle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t handle, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t handle);
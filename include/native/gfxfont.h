@@ -0,0 +1,53 @@
+//+--------------------------------------------------------------------------
+//
+// File:        gfxfont.h (native)
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Font structures from the Adafruit GFX library.  Text is not rendered
+//    in the native build but the types have to exist.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint16_t bitmapOffset;
+    uint8_t  width;
+    uint8_t  height;
+    uint8_t  xAdvance;
+    int8_t   xOffset;
+    int8_t   yOffset;
+} GFXglyph;
+
+typedef struct
+{
+    uint8_t  * bitmap;
+    GFXglyph * glyph;
+    uint16_t   first;
+    uint16_t   last;
+    uint8_t    yAdvance;
+} GFXfont;
@@ -34,6 +34,11 @@
     extern SocketServer g_SocketServer;
 #endif
 
+#if INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+    #include "udpserver.h"
+    extern UDPServer g_UDPServer;
+#endif
+
 #if ENABLE_WIFI
     extern uint8_t g_Brightness;
     extern bool    g_bUpdateStarted;
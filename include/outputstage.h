@@ -0,0 +1,259 @@
+//+--------------------------------------------------------------------------
+//
+// File:        outputstage.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The last thing that happens to a strip frame before FastLED clocks
+//    it out.  One pass over each channel runs every pixel through a
+//    256 entry table per color, which holds both the gamma curve and the
+//    white balance, and adds up the power the result will draw.  That
+//    sum gives the brightness that keeps the strip under POWER_LIMIT_MW,
+//    which along with the global brightness and the effect fader becomes
+//    the single scale FastLED.show() applies as it clocks the pixels out,
+//    the same way it already applies the color order.
+//
+//    FastLED is given no power limit of its own, so show() doesn't walk
+//    the LEDs again to work it out.  Before, it did that inside show(),
+//    ShowStrip did it once more for the brightness readout, and the
+//    wattage took another walk.
+//
+//    With the default gamma of 1 and white balance of pure white the
+//    tables don't change anything, so the pass only adds up the power
+//    and the effect's own buffers are shown.  Otherwise the corrected
+//    pixels go to a buffer of their own, so that effects that draw on
+//    top of their last frame don't see them.
+//
+//    Even that pass can be skipped: whoever drew a channel can hand over
+//    its PixelSums, kept as the pixels were written, with SetChannelSums.
+//    Frames from the wire are totaled as they come in (see LEDBuffer),
+//    and effects can keep their own (LEDStripEffect::FrameSums).
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <math.h>
+#include <memory>
+
+// PixelSums
+//
+// Running totals of the red, green and blue of a run of pixels, and how many there were, which is all the power
+// estimate needs to know about them
+
+struct PixelSums
+{
+    uint32_t red   = 0;
+    uint32_t green = 0;
+    uint32_t blue  = 0;
+    uint32_t count = 0;
+
+    void Add(CRGB color, size_t cPixels = 1)
+    {
+        red   += color.r * cPixels;
+        green += color.g * cPixels;
+        blue  += color.b * cPixels;
+        count += cPixels;
+    }
+
+    void Add(const CRGB * pPixels, size_t cPixels)
+    {
+        for (size_t i = 0; i < cPixels; i++)
+        {
+            red   += pPixels[i].r;
+            green += pPixels[i].g;
+            blue  += pPixels[i].b;
+        }
+        count += cPixels;
+    }
+
+    void Add(const PixelSums & other)
+    {
+        red   += other.red;
+        green += other.green;
+        blue  += other.blue;
+        count += other.count;
+    }
+
+    // Copy
+    //
+    // memcpy for cPixels worth of packed RGB bytes, which need not be aligned, adding them up on the way past
+
+    void Copy(CRGB * pDest, const uint8_t * pSource, size_t cPixels)
+    {
+        for (size_t i = 0; i < cPixels; i++, pSource += 3)
+        {
+            pDest[i].r = pSource[0];
+            pDest[i].g = pSource[1];
+            pDest[i].b = pSource[2];
+            red   += pSource[0];
+            green += pSource[1];
+            blue  += pSource[2];
+        }
+        count += cPixels;
+    }
+};
+
+class OutputStage
+{
+    // FastLED's own figures for a WS2812B (see power_mgt.cpp), in mW: full red, green and blue, a dark LED, and
+    // the MCU itself
+
+    static constexpr uint32_t kRedMilliwatts   = 16 * 5;
+    static constexpr uint32_t kGreenMilliwatts = 11 * 5;
+    static constexpr uint32_t kBlueMilliwatts  = 15 * 5;
+    static constexpr uint32_t kDarkMilliwatts  = 1 * 5;
+    static constexpr uint32_t kMCUMilliwatts   = 25 * 5;
+
+    uint8_t                 _lut[3][256];
+    bool                    _bIdentity = true;
+    std::unique_ptr<CRGB[]> _apOutput[NUM_CHANNELS];
+    PixelSums               _aKnownSums[NUM_CHANNELS];
+    bool                    _abSumsKnown[NUM_CHANNELS] = { };
+    uint32_t                _mWUnscaled = 0;            // Last frame, at full brightness, LEDs only
+    uint32_t                _cScansSkipped = 0;
+
+  public:
+
+    OutputStage(float gamma = OUTPUT_GAMMA, CRGB whiteBalance = OUTPUT_WHITE_BALANCE)
+    {
+        SetCorrection(gamma, whiteBalance);
+    }
+
+    // SetCorrection
+    //
+    // Rebuilds the tables for a gamma curve and the white balance, the most each of red, green and blue is let go
+
+    void SetCorrection(float gamma, CRGB whiteBalance)
+    {
+        _bIdentity = true;
+        for (int c = 0; c < 3; c++)
+        {
+            for (int v = 0; v < 256; v++)
+            {
+                uint8_t corrected = (uint8_t) lroundf(255.0f * powf(v / 255.0f, gamma));
+                _lut[c][v] = scale8(corrected, whiteBalance[c]);
+                _bIdentity = _bIdentity && _lut[c][v] == v;
+            }
+        }
+    }
+
+    // SetChannelSums
+    //
+    // Draw task only.  The totals of what a channel holds now, to be used by the next Process instead of adding the
+    // channel up again.  They only count if they cover exactly the LEDs Process is asked to show.
+
+    void SetChannelSums(int iChannel, const PixelSums & sums)
+    {
+        _aKnownSums[iChannel] = sums;
+        _abSumsKnown[iChannel] = true;
+    }
+
+    // Process
+    //
+    // Draw task only.  Runs the first cLEDs of each channel through the tables and returns the brightness to show
+    // them at, which is targetBrightness or less if that would draw more than maxMilliwatts.  Show the channels
+    // from Output() rather than the buffers passed in.
+
+    uint8_t Process(CRGB * const apLEDs[NUM_CHANNELS], size_t cLEDs, uint8_t targetBrightness, uint32_t maxMilliwatts)
+    {
+        PixelSums total;
+
+        for (int i = 0; i < NUM_CHANNELS; i++)
+        {
+            const CRGB * pIn = apLEDs[i];
+            bool bSumsKnown = _abSumsKnown[i] && _aKnownSums[i].count == cLEDs;
+            _abSumsKnown[i] = false;
+
+            if (_bIdentity)
+            {
+                _apOutput[i].reset();
+                if (bSumsKnown)
+                {
+                    total.Add(_aKnownSums[i]);
+                    _cScansSkipped++;
+                }
+                else
+                {
+                    total.Add(pIn, cLEDs);
+                }
+            }
+            else
+            {
+                if (!_apOutput[i])
+                    _apOutput[i] = std::make_unique<CRGB[]>(NUM_LEDS);
+
+                CRGB * pOut = _apOutput[i].get();
+                for (size_t j = 0; j < cLEDs; j++)
+                {
+                    pOut[j].r = _lut[0][pIn[j].r];
+                    pOut[j].g = _lut[1][pIn[j].g];
+                    pOut[j].b = _lut[2][pIn[j].b];
+                    total.red   += pOut[j].r;
+                    total.green += pOut[j].g;
+                    total.blue  += pOut[j].b;
+                }
+                total.count += cLEDs;
+            }
+        }
+
+        // Same arithmetic as FastLED's calculate_unscaled_power_mW, over all the channels at once
+
+        _mWUnscaled = ((total.red * kRedMilliwatts) >> 8) + ((total.green * kGreenMilliwatts) >> 8)
+                    + ((total.blue * kBlueMilliwatts) >> 8) + kDarkMilliwatts * total.count;
+
+        return LimitBrightness(targetBrightness, maxMilliwatts);
+    }
+
+    // LimitBrightness
+    //
+    // The brightness, up to targetBrightness, at which the last frame would draw no more than maxMilliwatts,
+    // worked out the way calculate_max_brightness_for_power_mW does
+
+    uint8_t LimitBrightness(uint8_t targetBrightness, uint32_t maxMilliwatts) const
+    {
+        uint32_t mWRequested = ((_mWUnscaled + kMCUMilliwatts) * targetBrightness) / 256;
+        if (mWRequested <= maxMilliwatts)
+            return targetBrightness;
+        return (targetBrightness * maxMilliwatts) / mWRequested;
+    }
+
+    CRGB * Output(int iChannel, CRGB * pLEDs) const
+    {
+        return _apOutput[iChannel] ? _apOutput[iChannel].get() : pLEDs;
+    }
+
+    uint32_t UnscaledMilliwatts() const
+    {
+        return _mWUnscaled;
+    }
+
+    // Channels whose totals came from SetChannelSums rather than a pass over their pixels, since startup
+
+    uint32_t ScansSkipped() const
+    {
+        return _cScansSkipped;
+    }
+};
+
+extern OutputStage g_OutputStage;
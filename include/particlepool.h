@@ -0,0 +1,175 @@
+//+--------------------------------------------------------------------------
+//
+// File:        particlepool.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    A FIFO of particles kept in one contiguous ring, for the particle
+//    systems and star effects that used to push_back and pop_front a
+//    std::deque every frame, and with it malloc and free from the draw
+//    task.
+//
+//    The ring starts empty and doubles whenever it fills, up to the
+//    maximum it was created with, so it ends up sized to the most
+//    particles the effect has actually had alive at once.  From then on
+//    adding and aging out particles never touches the heap.  Once it is
+//    at its maximum, adding a particle retires the oldest one.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Type> class ParticlePool
+{
+    static constexpr size_t kInitialCapacity = 8;
+
+    using Slot = typename std::aligned_storage<sizeof(Type), alignof(Type)>::type;
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t                  _capacity = 0;
+    size_t                  _maxCapacity;
+    size_t                  _first = 0;                 // Slot index of the oldest particle
+    size_t                  _count = 0;
+
+    Type * At(size_t i) const
+    {
+        size_t iSlot = _first + i;
+        if (iSlot >= _capacity)
+            iSlot -= _capacity;
+        return std::launder(reinterpret_cast<Type *>(&_slots[iSlot]));
+    }
+
+    // Grow
+    //
+    // Moves the particles, oldest first, into a ring twice the size (or the maximum, if that's smaller)
+
+    void Grow()
+    {
+        size_t newCapacity = std::min(_maxCapacity, std::max(kInitialCapacity, _capacity * 2));
+        std::unique_ptr<Slot[]> newSlots(new Slot[newCapacity]);
+
+        for (size_t i = 0; i < _count; i++)
+        {
+            Type * p = At(i);
+            new (&newSlots[i]) Type(std::move(*p));
+            p->~Type();
+        }
+
+        _slots    = std::move(newSlots);
+        _capacity = newCapacity;
+        _first    = 0;
+    }
+
+  public:
+
+    class iterator
+    {
+        const ParticlePool * _pPool;
+        size_t               _i;
+
+      public:
+
+        iterator(const ParticlePool * pPool, size_t i) : _pPool(pPool), _i(i) {}
+
+        Type & operator*() const                    { return *_pPool->At(_i); }
+        Type * operator->() const                   { return _pPool->At(_i);  }
+        iterator & operator++()                     { _i++; return *this;     }
+        iterator operator++(int)                    { iterator it = *this; _i++; return it; }
+        bool operator==(const iterator & rhs) const { return _i == rhs._i;    }
+        bool operator!=(const iterator & rhs) const { return _i != rhs._i;    }
+    };
+
+    explicit ParticlePool(size_t maxCapacity) : _maxCapacity(std::max<size_t>(1, maxCapacity))
+    {
+    }
+
+    ParticlePool(const ParticlePool &) = delete;
+    ParticlePool & operator=(const ParticlePool &) = delete;
+
+    ~ParticlePool()
+    {
+        clear();
+    }
+
+    size_t size() const                             { return _count;          }
+    bool empty() const                              { return _count == 0;     }
+    size_t capacity() const                         { return _capacity;       }
+    size_t max_size() const                         { return _maxCapacity;    }
+
+    Type & front()                                  { return *At(0);          }
+    Type & back()                                   { return *At(_count - 1); }
+
+    iterator begin() const                          { return iterator(this, 0);      }
+    iterator end() const                            { return iterator(this, _count); }
+
+    // emplace_back
+    //
+    // Constructs a new particle in place as the newest one, retiring the oldest if the pool is already at its maximum
+
+    template <typename... Args> Type & emplace_back(Args &&... args)
+    {
+        if (_count == _capacity)
+        {
+            if (_capacity < _maxCapacity)
+                Grow();
+            else
+                pop_front();
+        }
+
+        size_t iSlot = _first + _count;
+        if (iSlot >= _capacity)
+            iSlot -= _capacity;
+
+        Type * p = new (&_slots[iSlot]) Type(std::forward<Args>(args)...);
+        _count++;
+        return *p;
+    }
+
+    void push_back(const Type & particle)
+    {
+        emplace_back(particle);
+    }
+
+    void pop_front()
+    {
+        At(0)->~Type();
+        if (++_first == _capacity)
+            _first = 0;
+        _count--;
+    }
+
+    // clear
+    //
+    // Retires every particle but keeps the ring, so refilling it doesn't allocate again
+
+    void clear()
+    {
+        while (_count)
+            pop_front();
+    }
+};
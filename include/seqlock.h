@@ -0,0 +1,149 @@
+//+--------------------------------------------------------------------------
+//
+// File:        seqlock.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Hands a small struct from one task that writes it to any number of
+//    tasks that read it, without a lock.  Readers always get a complete
+//    copy of one published value, never half of one and half of the
+//    next, and the writer never waits for them.
+//
+//    It keeps two copies and a sequence number.  The writer bumps the
+//    sequence to odd, which sends readers to copy 1 while it rewrites
+//    copy 0, then bumps it back to even and rewrites copy 1.  A reader
+//    copies whichever one the sequence points at and then checks that
+//    the sequence hasn't moved, starting over if it has.  Since there
+//    is always one copy that isn't being written, a reader only ever has
+//    to retry when a whole publish happened while it was copying, and
+//    even a writer that is preempted part way through doesn't hold
+//    anybody up.
+//
+//    The copies are kept as atomic words so that a read that races a
+//    write, and is then thrown away, is still well defined.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <string.h>
+#include <type_traits>
+
+// AtomicCopy
+//
+// A T kept as relaxed atomic words, for anything else guarded by a sequence number the same way
+
+template <typename T>
+class AtomicCopy
+{
+    static_assert(std::is_trivially_copyable<T>::value, "AtomicCopy copies its value a word at a time");
+
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> _words[kWords];
+
+  public:
+
+    explicit AtomicCopy(const T & initial = T())
+    {
+        Store(initial);
+    }
+
+    void Store(const T & value)
+    {
+        uint32_t words[kWords] = { };
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < kWords; i++)
+            _words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    void Load(T & value) const
+    {
+        uint32_t words[kWords];
+        for (size_t i = 0; i < kWords; i++)
+            words[i] = _words[i].load(std::memory_order_relaxed);
+        memcpy(&value, words, sizeof(T));
+    }
+};
+
+template <typename T>
+class SeqLock
+{
+    std::atomic<uint32_t> _sequence { 0 };
+    AtomicCopy<T>         _copies[2];
+
+  public:
+
+    explicit SeqLock(const T & initial = T())
+      : _copies { AtomicCopy<T>(initial), AtomicCopy<T>(initial) }
+    {
+    }
+
+    // Publish
+    //
+    // Only ever from the one task that owns the value.  Each bump of the sequence is a release, since it sends
+    // readers to the copy that was written just before it: the odd one to copy 1 from the last Publish, and the
+    // even one to copy 0.  The fence after each keeps the bump ahead of the writes to the other copy, so that a
+    // reader that sees any of those also sees the sequence move when it checks again.
+
+    void Publish(const T & value)
+    {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+
+        _sequence.store(sequence + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        _copies[0].Store(value);
+
+        _sequence.store(sequence + 2, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        _copies[1].Store(value);
+    }
+
+    // Read
+    //
+    // A copy of the most recently published value, from any task
+
+    T Read() const
+    {
+        T value;
+        uint32_t sequence;
+        do
+        {
+            sequence = _sequence.load(std::memory_order_acquire);
+            _copies[sequence & 1].Load(value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while (_sequence.load(std::memory_order_relaxed) != sequence);
+
+        return value;
+    }
+
+    // Version
+    //
+    // How many values have been published, to tell whether there's a new one without copying it
+
+    uint32_t Version() const
+    {
+        return _sequence.load(std::memory_order_acquire) / 2;
+    }
+};
@@ -0,0 +1,175 @@
+//+--------------------------------------------------------------------------
+//
+// File:        slidingminmax.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    The minimum and maximum of the last N values pushed, kept up to
+//    date as each one arrives instead of searched for each time, in
+//    fixed storage that never allocates.
+//
+//    Each value gets a serial number as it is pushed.  Alongside a ring
+//    of the values are two more rings of serial numbers, whose values
+//    only ever rise (for the minimum) or fall (for the maximum) from the
+//    oldest to the newest.  A new value knocks off the newer end every
+//    entry it beats, since none of those can ever be the answer again
+//    while it's in the window, and entries that age out of the window
+//    fall off the older end.  Each value goes on and comes off each ring
+//    once, so a push is O(1) on average, and the answer for the whole
+//    window is simply the oldest entry.
+//
+//    Since the rings are ordered by serial number, the minimum and
+//    maximum of just the values since a given serial number can be found
+//    with a binary search, which lets several readers each look at their
+//    own part of the one window.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <typename T, size_t N>
+class SlidingMinMax
+{
+    static_assert(N > 0, "SlidingMinMax needs room for at least one value");
+
+    // A ring of up to N serial numbers, oldest first
+
+    class SerialRing
+    {
+        uint32_t _serials[N];
+        size_t   _first = 0;
+        size_t   _count = 0;
+
+      public:
+
+        size_t   Count() const          { return _count; }
+        uint32_t operator[](size_t i) const { return _serials[(_first + i) % N]; }
+        uint32_t Oldest() const         { return (*this)[0]; }
+        uint32_t Newest() const         { return (*this)[_count - 1]; }
+
+        void PushNewest(uint32_t serial)
+        {
+            _serials[(_first + _count) % N] = serial;
+            _count++;
+        }
+
+        void PopNewest()                { _count--; }
+        void PopOldest()                { _first = (_first + 1) % N; _count--; }
+        void Clear()                    { _first = 0; _count = 0; }
+
+        // Position of the first serial at or after since, or Count() if there isn't one
+
+        size_t FirstAtOrAfter(uint32_t since) const
+        {
+            size_t low = 0, high = _count;
+            while (low < high)
+            {
+                size_t mid = (low + high) / 2;
+                if ((*this)[mid] < since)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
+    };
+
+    T          _values[N];
+    uint32_t   _next = 0;                               // Serial number the next value will get
+    SerialRing _mins;
+    SerialRing _maxes;
+
+    const T & Value(uint32_t serial) const
+    {
+        return _values[serial % N];
+    }
+
+  public:
+
+    // Push
+    //
+    // Adds a value, dropping the oldest if there are already N
+
+    void Push(const T & value)
+    {
+        const uint32_t serial = _next++;
+        _values[serial % N] = value;
+
+        // Only one serial number leaves the window per push, so at most one entry can have aged out of each ring
+
+        if (_mins.Count() && _mins.Oldest() + N <= serial)
+            _mins.PopOldest();
+        while (_mins.Count() && Value(_mins.Newest()) >= value)
+            _mins.PopNewest();
+        _mins.PushNewest(serial);
+
+        if (_maxes.Count() && _maxes.Oldest() + N <= serial)
+            _maxes.PopOldest();
+        while (_maxes.Count() && Value(_maxes.Newest()) <= value)
+            _maxes.PopNewest();
+        _maxes.PushNewest(serial);
+    }
+
+    void Clear()
+    {
+        _mins.Clear();
+        _maxes.Clear();
+        _next = 0;
+    }
+
+    // Next
+    //
+    // The serial number the next value pushed will get, so a reader can later ask about only what came after now
+
+    uint32_t Next() const
+    {
+        return _next;
+    }
+
+    size_t Count() const
+    {
+        return _next < N ? _next : N;
+    }
+
+    // MinMax
+    //
+    // The smallest and largest values pushed at or after serial number since that are still in the window, or
+    // false if there aren't any
+
+    bool MinMax(T & minimum, T & maximum, uint32_t since = 0) const
+    {
+        if (_next == 0 || since >= _next)
+            return false;
+
+        const uint32_t oldest = _next - Count();
+        if (since < oldest)
+            since = oldest;
+
+        minimum = Value(_mins[_mins.FirstAtOrAfter(since)]);
+        maximum = Value(_maxes[_maxes.FirstAtOrAfter(since)]);
+        return true;
+    }
+};
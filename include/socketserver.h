@@ -45,6 +45,7 @@ extern "C"
 }
 
 #define STANDARD_DATA_HEADER_SIZE   24                                              // Size of the header for expanded data
+#define DELTA_DATA_HEADER_SIZE      40                                              // Standard header plus the base frame's timestamp
 #define COMPRESSED_HEADER_SIZE      16                                              // Size of the header for compressed data
 #define LED_DATA_SIZE                3                                              // Data size of an LED (24 bits or 3 bytes)
 
@@ -56,6 +57,16 @@ extern "C"
 
 #define COMPRESSED_HEADER (0x44415645)                                              // asci "DAVE" as header 
 bool ProcessIncomingData(uint8_t * payloadData, size_t payloadLength);              // In main file
+LEDBuffer * BeginIncomingPixelData(const uint8_t * pHeader);                        // In network.cpp
+bool EndIncomingPixelData(LEDBuffer * pBuffer);
+
+// The buffer queues take a single producer, so the TCP and UDP servers take turns with this between
+// BeginIncomingPixelData and EndIncomingPixelData.  The draw task never touches it.
+
+extern std::mutex g_producer_mutex;
+
+static_assert(LEDBuffer::WireHeaderSize == STANDARD_DATA_HEADER_SIZE, "LEDBuffer and the socket server disagree on the header size");
+static_assert(LEDBuffer::DeltaHeaderSize == DELTA_DATA_HEADER_SIZE, "LEDBuffer and the socket server disagree on the delta header size");
 
 #if ENABLE_WIFI && INCOMING_WIFI_ENABLED
 
@@ -75,6 +86,8 @@ struct SocketResponse
     uint32_t    bufferPos;         // 4
     uint32_t    fpsDrawing;        // 4    
     uint32_t    watts;             // 4
+    uint32_t    keyframeMask;      // 4    Channels that refused a delta and want a full PIXELDATA64 frame next
+    uint32_t    reserved;          // 4
 };
 
 static_assert(sizeof(double) == 8);             // SocketResponse on wire uses 8 byte doubles
@@ -84,7 +97,7 @@ static_assert(sizeof(float)  == 4);             // PeakData on wire uses 4 byte
 // doubles land on byte multiples of 8, otherwise you'll get packing bytes inserted.  Welcome to my world! Once upon
 // a time, I ported about a billion lines of x86 'pragma_pack(1)' code to the MIPS (davepl)!
 
-static_assert( sizeof(SocketResponse) == 64, "SocketResponse struct size is not what is expected - check alignment and double size" );            
+static_assert( sizeof(SocketResponse) == 72, "SocketResponse struct size is not what is expected - check alignment and double size" );            
 
 extern AppTime g_AppTime;
 extern std::unique_ptr<LEDBufferManager> g_aptrBufferManager[NUM_CHANNELS];
@@ -92,6 +105,47 @@ extern uint32_t g_FPS;
 extern double g_Brite;
 extern uint32_t g_Watts; 
 
+// CurrentSocketResponse
+//
+// Snapshot of our stats to send back to whoever is sending us color data
+
+inline SocketResponse CurrentSocketResponse()
+{
+    uint32_t keyframeMask = 0;
+    for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
+        if (g_aptrBufferManager[iChannel]->KeyframeWanted())
+            keyframeMask |= 1 << iChannel;
+
+    SocketResponse response = { 
+                                .size = sizeof(SocketResponse),
+                                .flashVersion = FLASH_VERSION,
+                                .currentClock = g_AppTime.CurrentTime(),
+                                .oldestPacket = g_aptrBufferManager[0]->AgeOfOldestBuffer(),
+                                .newestPacket = g_aptrBufferManager[0]->AgeOfNewestBuffer(),
+                                .brightness   = g_Brite,
+                                .wifiSignal   = (double) WiFi.RSSI(),
+                                .bufferSize   = g_aptrBufferManager[0]->BufferCount(),
+                                .bufferPos    = g_aptrBufferManager[0]->Depth(),
+                                .fpsDrawing   = g_FPS,
+                                .watts        = g_Watts,
+                                .keyframeMask = keyframeMask,
+                                .reserved     = 0
+                            };
+    return response;
+}
+
+// free_deleter
+//
+// For buffers that come from malloc or heap_caps_malloc, which have to go back with free() rather than delete[]
+
+struct free_deleter
+{
+    void operator()(void * p) const
+    {
+        free(p);
+    }
+};
+
 // SocketServer
 //
 // Handles incoming connections from the server and pass the data that comes in 
@@ -104,7 +158,7 @@ private:
     int                    _numLeds;
     int                    _server_fd;
     struct sockaddr_in     _address; 
-    std::unique_ptr<uint8_t []> _pBuffer;
+    std::unique_ptr<uint8_t [], free_deleter> _pBuffer;
     std::unique_ptr<uint8_t []> _abOutputBuffer;
 
 public:
@@ -117,7 +171,7 @@ public:
         _server_fd(0),
         _cbReceived(0)
     {
-        _abOutputBuffer = std::make_unique<uint8_t []>(MAXIUMUM_PACKET_SIZE);
+        _abOutputBuffer = std::make_unique<uint8_t []>(MAXIUMUM_PACKET_SIZE + 1);          // +1 so the inflater can find the end of stream
         memset(&_address, 0, sizeof(_address));
     }
 
@@ -135,7 +189,20 @@ public:
 
     bool begin()
     {
-        _pBuffer = std::make_unique<uint8_t []>(MAXIUMUM_PACKET_SIZE);
+        // Compressed data is inflated straight out of this buffer, and SPIRAM is slow at the scattered reads that
+        // involves, so keep it in internal RAM even on PSRAM boards rather than copying it out for each packet
+
+        #if USE_PSRAM
+            _pBuffer.reset((uint8_t *) heap_caps_malloc(MAXIUMUM_PACKET_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+        #else
+            _pBuffer.reset((uint8_t *) malloc(MAXIUMUM_PACKET_SIZE));
+        #endif
+
+        if (!_pBuffer)
+        {
+            debugW("Could not allocate %d byte socket buffer\n", MAXIUMUM_PACKET_SIZE);
+            return false;
+        }
 
         _cbReceived = 0;
         
@@ -318,30 +385,10 @@ public:
                 }
                 debugV("Successfuly read %u bytes", STANDARD_DATA_HEADER_SIZE + compressedSize);
 
-                // If our buffer is in PSRAM it would be expensive to decompress in place, as the SPIRAM doesn't like
-                // non-linear access from what I can tell.  I bet it must send addr+len to request each unique read, so
-                // one big read one time would work best, and we use that to copy it to a regular RAM buffer.
-                
-                #if USE_PSRAM
-                    std::unique_ptr<uint8_t []> _abTempBuffer = std::make_unique<uint8_t []>(MAXIUMUM_PACKET_SIZE);
-                    memcpy(_abTempBuffer.get(), _pBuffer.get(), MAXIUMUM_PACKET_SIZE);
-                    auto pSourceBuffer = &_abTempBuffer[STANDARD_DATA_HEADER_SIZE];
-                #else
-                    auto pSourceBuffer = &_pBuffer[STANDARD_DATA_HEADER_SIZE];
-                #endif
-                
-                if (!DecompressBuffer(pSourceBuffer, compressedSize, _abOutputBuffer.get(), expandedSize))
-                {
-                    debugW("Error decompressing data\n");
-                    break;
-                }
-
-                if (false == ProcessIncomingData(_abOutputBuffer.get(), expandedSize))
-                {
-                    debugW("Error processing data\n");
+                std::lock_guard<std::mutex> guard(g_producer_mutex);
+                if (false == DecompressAndProcess(&_pBuffer[STANDARD_DATA_HEADER_SIZE], compressedSize, expandedSize))
                     break;
 
-                }
                 ResetReadBuffer();
             }
             else
@@ -409,18 +456,25 @@ public:
                     }
 
                     debugE("Expecting %d total bytes", totalExpected);
+
+                    // Read the whole frame before taking the producer lock, since the read can block for as long as the
+                    // socket timeout and the UDP server drops every datagram that arrives while we hold it.  The copy
+                    // into the LEDBuffer adds up the pixels as it goes, which would otherwise be a pass of its own.
+
                     if (false == ReadUntilNBytesReceived(new_socket, totalExpected))
                     {
                         debugW("Error in getting pixel data from wifi\n");
                         break;
                     }
-                
-                    // Add it to the buffer ring
-                    
-                    if (false == ProcessIncomingData(_pBuffer.get(), totalExpected))
-                    {
+
+                    std::lock_guard<std::mutex> guard(g_producer_mutex);
+                    auto pBuffer = BeginIncomingPixelData(_pBuffer.get());
+                    if (!pBuffer || !pBuffer->UpdateFromWire(_pBuffer.get(), totalExpected))
                         break;
-                    }
+
+                    // A full queue drops the frame, but the stream itself is fine, so carry on either way
+
+                    EndIncomingPixelData(pBuffer);
 
                     // Consume the data by resetting the buffer 
                     debugV("Consuming the data as WIFI_COMMAND_PIXELDATA64 by setting _cbReceived to from %d down 0.", _cbReceived);
@@ -428,6 +482,35 @@ public:
 
                     bSendResponsePacket = true;
                 }
+                else if (command16 == WIFI_COMMAND_PIXELDELTA64)
+                {
+                    // Delta spans don't map onto the pixels one to one, so they're read whole and then decoded
+                    // into the next buffer against the previous frame
+
+                    uint32_t length32 = DWORDFromMemory(&_pBuffer.get()[4]);
+                    size_t totalExpected = DELTA_DATA_HEADER_SIZE + length32;
+                    if (totalExpected > MAXIUMUM_PACKET_SIZE)
+                    {
+                        debugW("Delta frame of %u bytes is bigger than a raw frame (%u); sender should send it raw\n", totalExpected, MAXIUMUM_PACKET_SIZE);
+                        break;
+                    }
+
+                    if (false == ReadUntilNBytesReceived(new_socket, totalExpected))
+                    {
+                        debugW("Error in getting delta data from wifi\n");
+                        break;
+                    }
+
+                    // Whether or not the frame is queued, the whole packet has been read, so the stream stays in step.
+                    // A delta that was refused shows up in the response's keyframeMask.
+
+                    std::lock_guard<std::mutex> guard(g_producer_mutex);
+                    if (false == ProcessIncomingData(_pBuffer.get(), totalExpected))
+                        debugV("Delta frame not queued");
+
+                    ResetReadBuffer();
+                    bSendResponsePacket = true;
+                }
                 else
                 {
                     debugW("Unknown command in packet received: %d\n", command16);
@@ -442,19 +525,7 @@ public:
 
             if (bSendResponsePacket)
             {
-                SocketResponse response = { 
-                                            .size = sizeof(SocketResponse),
-                                            .flashVersion = FLASH_VERSION,
-                                            .currentClock = g_AppTime.CurrentTime(),
-                                            .oldestPacket = g_aptrBufferManager[0]->AgeOfOldestBuffer(),
-                                            .newestPacket = g_aptrBufferManager[0]->AgeOfNewestBuffer(),
-                                            .brightness   = g_Brite,
-                                            .wifiSignal   = (double) WiFi.RSSI(),
-                                            .bufferSize   = g_aptrBufferManager[0]->BufferCount(),
-                                            .bufferPos    = g_aptrBufferManager[0]->Depth(),
-                                            .fpsDrawing   = g_FPS,
-                                            .watts        = g_Watts
-                                        };
+                SocketResponse response = CurrentSocketResponse();
 
                 // I dont think this is fatal, and doesn't affect the read buffer, so content to ignore for now if it happens
                 if (sizeof(response) != write(new_socket, &response, sizeof(response)))
@@ -467,23 +538,31 @@ public:
         return false;
     }    
 
-    // DecompressBuffer
+    // DecompressAndProcess
     //
-    // Use unzlib to decompress a memory buffer
+    // Inflates a compressed packet.  Only the 24 byte header is inflated on its own; once we know where the data
+    // is going, the rest is inflated straight into it.  For pixel data that's the LEDBuffer's own storage, which
+    // has room for the header in front of the pixels so the inflater's back-references still see one contiguous
+    // output.  Anything else is inflated into _abOutputBuffer and handed to ProcessIncomingData as before.
 
-    bool DecompressBuffer(const uint8_t * pBuffer, size_t cBuffer, uint8_t * pOutput, size_t expectedOutputSize) const
+    bool DecompressAndProcess(const uint8_t * pBuffer, size_t cBuffer, size_t expectedOutputSize)
     {
+        TaskBusyTimer busy;
+
         debugV("Compressed Data: %02X %02X %02X %02X...", pBuffer[0], pBuffer[1], pBuffer[2], pBuffer[3]);
-        
+
+        if (expectedOutputSize < STANDARD_DATA_HEADER_SIZE)
+        {
+            debugE("Compressed packet expands to only %d bytes, not even a header\n", expectedOutputSize);
+            return false;
+        }
+
         struct uzlib_uncomp d = { 0 };
         uzlib_uncompress_init(&d, NULL, 0);
 
         d.source         = pBuffer;
         d.source_limit   = pBuffer + cBuffer;
         d.source_read_cb = nullptr;
-        d.dest_start     = pOutput;
-        d.dest           = pOutput;
-        d.dest_limit     = pOutput + expectedOutputSize + 1;
 
         int res = uzlib_zlib_parse_header(&d);
         if (res < 0)
@@ -492,19 +571,70 @@ public:
             return false;
         }
 
-        res = uzlib_uncompress_chksum(&d);                                          // Expand the data
+        uint8_t abHeader[STANDARD_DATA_HEADER_SIZE + 1];
+        if (!InflateInto(d, abHeader, 0, STANDARD_DATA_HEADER_SIZE, expectedOutputSize == STANDARD_DATA_HEADER_SIZE))
+            return false;
+
+        uint16_t command16 = WORDFromMemory(&abHeader[0]);
+        uint32_t length32  = DWORDFromMemory(&abHeader[4]);
 
-        if (res != TINF_DONE) {
+        if (command16 == WIFI_COMMAND_PIXELDATA64 && expectedOutputSize == STANDARD_DATA_HEADER_SIZE + length32 * LED_DATA_SIZE)
+        {
+            auto pLEDBuffer = BeginIncomingPixelData(abHeader);            // Also copies the header into its storage
+            if (!pLEDBuffer)
+                return false;
+
+            if (!InflateInto(d, pLEDBuffer->WireStorage(), STANDARD_DATA_HEADER_SIZE, expectedOutputSize, true))
+                return false;
+
+            EndIncomingPixelData(pLEDBuffer);                               // A full queue drops the frame, but that's no error
+            return true;
+        }
+
+        memcpy(_abOutputBuffer.get(), abHeader, STANDARD_DATA_HEADER_SIZE);
+        if (!InflateInto(d, _abOutputBuffer.get(), STANDARD_DATA_HEADER_SIZE, expectedOutputSize, true))
+            return false;
+
+        // A delta that's refused for being against the wrong frame was still read whole, so it's no reason to drop
+        // the connection
+
+        if (false == ProcessIncomingData(_abOutputBuffer.get(), expectedOutputSize) && command16 != WIFI_COMMAND_PIXELDELTA64)
+        {
+            debugW("Error processing data\n");
+            return false;
+        }
+        return true;
+    }
+
+    // InflateInto
+    //
+    // Continues an inflate into pOutput, which already holds the first cbHave bytes of the output, until it holds
+    // cbTotal.  If bFinal, the stream must end right there and the checksum must match, and pOutput needs one
+    // spare byte past cbTotal for the inflater to discover that.
+
+    bool InflateInto(struct uzlib_uncomp & d, uint8_t * pOutput, size_t cbHave, size_t cbTotal, bool bFinal) const
+    {
+        if (cbHave == cbTotal)                                                      // Header-only packet, already finished
+            return true;
+
+        d.dest_start     = pOutput;
+        d.dest           = pOutput + cbHave;
+        d.dest_limit     = pOutput + cbTotal + (bFinal ? 1 : 0);
+
+        int res = uzlib_uncompress_chksum(&d);                                      // Expand the data
+
+        if (res != (bFinal ? TINF_DONE : TINF_OK) && !(res == TINF_DONE && d.dest - pOutput == cbTotal))
+        {
             debugE("Error during decompression after producing %d bytes: %d\n", d.dest - pOutput, res);
             return false;
         }
 
-        if (d.dest - pOutput != expectedOutputSize)
+        if (d.dest - pOutput != cbTotal)
         {
-            debugE("Exepcted it to to decompress to %d but got %d instead\n", expectedOutputSize, d.dest - pOutput);
+            debugE("Exepcted it to to decompress to %d but got %d instead\n", cbTotal, d.dest - pOutput);
             return false;
         }
-        
+
         return true;
     }
 };
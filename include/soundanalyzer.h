@@ -33,7 +33,13 @@
 
 #pragma once
 
+#if USE_ARDUINOFFT
 #include <arduinoFFT.h>
+#else
+#include "fftengine.h"
+#endif
+#include "tempotracker.h"
+#include "audiosource.h"
 #include <driver/i2s.h>
 #include <driver/adc.h>
 //#include <driver/adc_deprecated.h>
@@ -54,6 +60,33 @@ extern DRAM_ATTR bool g_bUpdateStarted;                     // Has an OTA update
 //
 // In both cases, the AudioVariables are accessiable as g_Analyzer.  It'll just be a stub in the non-audio case
 
+// AudioFrame
+//
+// Everything a sampler pass produces that the rest of the code draws from.  The sampler publishes one after every
+// pass, and GetAudioFrame() gives other tasks a consistent copy of the latest, rather than them reading the bands
+// while the sampler is part way through rewriting them.
+
+struct AudioFrame
+{
+    uint32_t      sequence      = 0;                     // Counts up with each sampler pass
+    float         vu            = 0.0f;
+    float         vuRatio       = 1.0f;
+    float         vuRatioFade   = 1.0f;
+    float         minVU         = 0.0f;
+    float         peakVU        = MAX_VU;
+    bool          bRemote       = false;                 // Peaks came from a remote source, not the microphone
+    float         bpm           = 0.0f;                  // Tempo of the music, or 0 if there's no telling yet
+    float         beatPhase     = 0.0f;                  // How far through the current beat, from 0 to 1
+    float         tempoConfidence = 0.0f;                // How sure the tempo tracker is, from 0 to 1
+    uint32_t      beatCount     = 0;                     // Beats the tempo tracker's clock has ticked
+#if ENABLE_AUDIO
+    float         peaks[NUM_BANDS]         = { };
+    float         peak1Decay[NUM_BANDS]    = { };
+    float         peak2Decay[NUM_BANDS]    = { };
+    unsigned long lastPeak1Time[NUM_BANDS] = { };
+#endif
+};
+
 struct AudioVariables
 {
     float         _VURatio     = 1.0;                    // Current VU as a ratio to its recent min and max
@@ -62,9 +95,17 @@ struct AudioVariables
     float         _PeakVU      = MAX_VU;                 // How high our peak VU scale is in live mode
     float         _MinVU       = 0.0;                    // How low our peak VU scale is in live mode
     unsigned long _cSamples    = 0U;                     // Total number of samples successfully collected
+    unsigned long _cDroppedSamples = 0U;                 // Samples the I2S driver overwrote before we read them
     int           _AudioFPS    = 0;                      // Framerate of the audio sampler
     int           _serialFPS   = 0;                      // How many serial packets are processed per second
     uint          _msLastRemote= 0;                      // When the last Peak data came in from external (ie: WiFi)
+
+    SeqLock<AudioFrame> _audioFrame;                     // Latest published pass, for other tasks
+
+    AudioFrame GetAudioFrame() const
+    {
+        return _audioFrame.Read();
+    }
 };
 
 #if !ENABLE_AUDIO
@@ -269,7 +310,7 @@ struct AudioVariables
 
     class SoundAnalyzer : public AudioVariables
     {
-        const size_t MAX_SAMPLES = 512;
+        static constexpr size_t MAX_SAMPLES = AUDIO_MAX_SAMPLES;
 
         // I'm old enough I can only hear up to about 12K, but feel free to adjust.  Remember from
         // school that you need to sample at doube the frequency you want to process, so 24000 is 12K
@@ -283,6 +324,7 @@ struct AudioVariables
         float *    _vPeaks;
         int        _InputPin;
         int        _cutOffsBand[NUM_BANDS];
+        uint8_t    _binBand[MAX_SAMPLES / 2];           // Which band each FFT bin falls in, from BuildBinBandTable
         float      _oldVU;
         float      _oldPeakVU;
         float      _oldMinVU;
@@ -306,8 +348,39 @@ struct AudioVariables
         }
 
         volatile int _cSamples;
+
+        // In streaming mode the DMA buffers are a hop each, and a few of them give the pass time to finish before
+        // the driver starts overwriting samples it hasn't handed over yet, which it reports on the event queue
+
+    #if AUDIO_STREAMING_CAPTURE
+        static_assert(AUDIO_HOP_SAMPLES > 0 && MAX_SAMPLES % AUDIO_HOP_SAMPLES == 0, "AUDIO_HOP_SAMPLES must divide MAX_SAMPLES");
+
+        static constexpr int DMA_BUFFER_COUNT   = 4;
+        static constexpr int DMA_BUFFER_LEN     = AUDIO_HOP_SAMPLES;
+        static constexpr int I2S_EVENT_QUEUE_LEN = 16;
+
+        int16_t       _window[MAX_SAMPLES] = { };        // The latest MAX_SAMPLES samples, oldest first
+        QueueHandle_t _hI2SEvents = nullptr;
+
+        QueueHandle_t * I2SEventQueue() { return &_hI2SEvents; }
+    #else
+        static constexpr int DMA_BUFFER_COUNT   = 2;
+        static constexpr int DMA_BUFFER_LEN     = MAX_SAMPLES;
+        static constexpr int I2S_EVENT_QUEUE_LEN = 0;
+
+        QueueHandle_t * I2SEventQueue() { return nullptr; }
+    #endif
+
+    #if USE_ARDUINOFFT
         double *_vReal;
         double *_vImaginary;
+    #else
+        float  *_vReal;                                  // Samples go in, bin magnitudes come out
+        RealFFT _fft;
+    #endif
+
+        TempoTracker _tempo;                             // Fed the raw band peaks of each microphone pass
+        AudioSource * _pSource = nullptr;                // Listened to instead of I2S, if set
 
         // SampleBuffer::Reset
         //
@@ -319,7 +392,9 @@ struct AudioVariables
             for (int i = 0; i < _MaxSamples; i++)
             {
                 _vReal[i] = 0.0;
-                _vImaginary[i] = 0.0f;
+                #if USE_ARDUINOFFT
+                    _vImaginary[i] = 0.0f;
+                #endif
             }
             for (int i = 0; i < _BandCount; i++)
                 _vPeaks[i] = 0;
@@ -332,12 +407,16 @@ struct AudioVariables
 
         void FFT()
         {
-            arduinoFFT _FFT(_vReal, _vImaginary, _MaxSamples, _SamplingFrequency);
-            _FFT.DCRemoval();
-            _FFT.Windowing(FFT_WIN_TYP_FLT_TOP, FFT_FORWARD);
-            _FFT.Compute(FFT_FORWARD);
-            _FFT.ComplexToMagnitude();
-            _FFT.MajorPeak();
+            #if USE_ARDUINOFFT
+                arduinoFFT _FFT(_vReal, _vImaginary, _MaxSamples, _SamplingFrequency);
+                _FFT.DCRemoval();
+                _FFT.Windowing(FFT_WIN_TYP_FLT_TOP, FFT_FORWARD);
+                _FFT.Compute(FFT_FORWARD);
+                _FFT.ComplexToMagnitude();
+                _FFT.MajorPeak();
+            #else
+                _fft.Magnitudes(_vReal, _vReal);
+            #endif
         }
 
         inline bool IsBufferFull() const __attribute__((always_inline))
@@ -366,8 +445,8 @@ struct AudioVariables
                         .communication_format = I2S_COMM_FORMAT_I2S,
                     #endif
                     .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
-                    .dma_buf_count = 2,
-                    .dma_buf_len = 256,
+                    .dma_buf_count = DMA_BUFFER_COUNT,
+                    .dma_buf_len = AUDIO_STREAMING_CAPTURE ? DMA_BUFFER_LEN : 256,
                 };
 
                 i2s_pin_config_t pin_config;
@@ -381,7 +460,7 @@ struct AudioVariables
                 pin_config.data_out_num = I2S_PIN_NO_CHANGE;
                 pin_config.data_in_num = INPUT_PIN;
 
-                i2s_driver_install(I2S_NUM_0, &i2s_config, 0, NULL);
+                i2s_driver_install(I2S_NUM_0, &i2s_config, I2S_EVENT_QUEUE_LEN, I2SEventQueue());
                 i2s_set_pin(I2S_NUM_0, &pin_config);
                 i2s_set_clk(I2S_NUM_0, SAMPLING_FREQUENCY, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_MONO);
 
@@ -390,17 +469,17 @@ struct AudioVariables
                 i2s_config_t i2s_config;
                 i2s_config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
                 i2s_config.sample_rate = SAMPLING_FREQUENCY;
-                i2s_config.dma_buf_len = MAX_SAMPLES;
+                i2s_config.dma_buf_len = DMA_BUFFER_LEN;
                 i2s_config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
                 i2s_config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
                 i2s_config.use_apll = false,
                 i2s_config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
                 i2s_config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
-                i2s_config.dma_buf_count = 2;
+                i2s_config.dma_buf_count = DMA_BUFFER_COUNT;
 
                 ESP_ERROR_CHECK(adc1_config_width(ADC_WIDTH_BIT_12));
                 ESP_ERROR_CHECK(adc1_config_channel_atten(ADC1_CHANNEL_0, ADC_ATTEN_DB_0));
-                ESP_ERROR_CHECK(i2s_driver_install(EXAMPLE_I2S_NUM, &i2s_config, 0, NULL));
+                ESP_ERROR_CHECK(i2s_driver_install(EXAMPLE_I2S_NUM, &i2s_config, I2S_EVENT_QUEUE_LEN, I2SEventQueue()));
                 ESP_ERROR_CHECK(i2s_set_adc_mode(I2S_ADC_UNIT, I2S_ADC_CHANNEL));
 
             #else
@@ -408,47 +487,122 @@ struct AudioVariables
                 i2s_config_t i2s_config;
                 i2s_config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
                 i2s_config.sample_rate = SAMPLING_FREQUENCY;
-                i2s_config.dma_buf_len = MAX_SAMPLES;
+                i2s_config.dma_buf_len = DMA_BUFFER_LEN;
                 i2s_config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
                 i2s_config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
                 i2s_config.use_apll = false,
                 i2s_config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
                 i2s_config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
-                i2s_config.dma_buf_count = 2;
+                i2s_config.dma_buf_count = DMA_BUFFER_COUNT;
 
                 ESP_ERROR_CHECK(adc1_config_width(ADC_WIDTH_BIT_12));
                 ESP_ERROR_CHECK(adc1_config_channel_atten(ADC1_CHANNEL_0, ADC_ATTEN_DB_0));
-                ESP_ERROR_CHECK(i2s_driver_install(EXAMPLE_I2S_NUM, &i2s_config, 0, NULL));
+                ESP_ERROR_CHECK(i2s_driver_install(EXAMPLE_I2S_NUM, &i2s_config, I2S_EVENT_QUEUE_LEN, I2SEventQueue()));
                 ESP_ERROR_CHECK(i2s_set_adc_mode(I2S_ADC_UNIT, I2S_ADC_CHANNEL));
 
             #endif
 
+            // Streaming from the built-in ADC, it's switched on once here and left on
+
+            #if AUDIO_STREAMING_CAPTURE && !(M5STICKC || M5STICKCPLUS)
+                ESP_ERROR_CHECK(i2s_adc_enable(EXAMPLE_I2S_NUM));
+            #endif
+
             debugV("SamplerBufferInitI2S Complete\n");
         }
 
-        void FillBufferI2S()
+        // ReadSamples
+        //
+        // The next cSamples samples, from the AudioSource if there is one or from I2S if not.  Returns how many it got.
+
+        size_t ReadSamples(int16_t * pSamples, size_t cSamples)
         {
-            int16_t sampleBuffer[MAX_SAMPLES];
+            if (_pSource)
+                return _pSource->Read(pSamples, cSamples);
 
-            if (IsBufferFull())
-            {
-                debugW("BUG: FillBUfferI2S found buffer already full.");
-                return;
-            }
             size_t bytesRead = 0;
-
             #if M5STICKC || M5STICKCPLUS
-                ESP_ERROR_CHECK(i2s_read(I2S_NUM_0, (void *)sampleBuffer, sizeof(sampleBuffer), &bytesRead, (100 / portTICK_RATE_MS)));
+                ESP_ERROR_CHECK(i2s_read(I2S_NUM_0, (void *)pSamples, cSamples * sizeof(pSamples[0]), &bytesRead, (100 / portTICK_RATE_MS)));
+            #elif AUDIO_STREAMING_CAPTURE
+                ESP_ERROR_CHECK(i2s_read(EXAMPLE_I2S_NUM, (void *)pSamples, cSamples * sizeof(pSamples[0]), &bytesRead, portMAX_DELAY));
             #else
                 ESP_ERROR_CHECK(i2s_adc_enable(EXAMPLE_I2S_NUM));
-                ESP_ERROR_CHECK(i2s_read(EXAMPLE_I2S_NUM, (void *)sampleBuffer, sizeof(sampleBuffer), &bytesRead, portMAX_DELAY));
+                ESP_ERROR_CHECK(i2s_read(EXAMPLE_I2S_NUM, (void *)pSamples, cSamples * sizeof(pSamples[0]), &bytesRead, portMAX_DELAY));
                 ESP_ERROR_CHECK(i2s_adc_disable(EXAMPLE_I2S_NUM));
             #endif
 
+            #if AUDIO_STREAMING_CAPTURE
+                CountDroppedSamples();
+            #endif
+
+            return bytesRead / sizeof(pSamples[0]);
+        }
+
+    #if AUDIO_STREAMING_CAPTURE
+
+        // CountDroppedSamples
+        //
+        // When the driver has to overwrite a DMA buffer that hasn't been read yet, it posts an overflow event, and
+        // that's a buffer's worth of samples gone.  The event queue drops its oldest events when it fills, so after
+        // a long stall this is a lower bound.  Older IDFs don't post the event at all, and it stays at zero.
+
+        void CountDroppedSamples()
+        {
+            i2s_event_t event;
+            while (xQueueReceive(_hI2SEvents, &event, 0) == pdTRUE)
+            {
+                #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
+                    if (event.type == I2S_EVENT_RX_Q_OVF)
+                        _cDroppedSamples += DMA_BUFFER_LEN;
+                #endif
+            }
+        }
+
+        // FillBuffer
+        //
+        // Slides the window along by a hop and reads the next hop onto the end of it, waiting on the DMA if it isn't
+        // all in yet.  The FFT gets the whole window, so each pass sees the newest hop and the tail of the last.
+
+        void FillBuffer()
+        {
+            const size_t cKept = MAX_SAMPLES - AUDIO_HOP_SAMPLES;
+
+            memmove(_window, _window + AUDIO_HOP_SAMPLES, cKept * sizeof(_window[0]));
+
+            size_t cRead = ReadSamples(&_window[cKept], AUDIO_HOP_SAMPLES);
+
             _cSamples = _MaxSamples;
-            if (bytesRead != sizeof(sampleBuffer))
+            if (cRead != AUDIO_HOP_SAMPLES)
+                debugW("Could only read %zu samples of %zu in FillBuffer()\n", cRead, (size_t) AUDIO_HOP_SAMPLES);
+
+            for (int i = 0; i < MAX_SAMPLES; i++)
             {
-                debugW("Could only read %u bytes of %u in FillBufferI2S()\n", bytesRead, sizeof(sampleBuffer));
+                #if M5STICKC || M5STICKCPLUS
+                    _vReal[i] = ::map(_window[i], INT16_MIN, INT16_MAX, 0, MAX_VU);
+                #else
+                    _vReal[i] = _window[i];
+                #endif
+            }
+        }
+
+    #else
+
+        void FillBuffer()
+        {
+            int16_t sampleBuffer[MAX_SAMPLES];
+
+            if (IsBufferFull())
+            {
+                debugW("BUG: FillBuffer found buffer already full.");
+                return;
+            }
+
+            size_t cRead = ReadSamples(sampleBuffer, MAX_SAMPLES);
+
+            _cSamples = _MaxSamples;
+            if (cRead != MAX_SAMPLES)
+            {
+                debugW("Could only read %zu samples of %zu in FillBuffer()\n", cRead, MAX_SAMPLES);
                 return;
             }
 
@@ -462,6 +616,8 @@ struct AudioVariables
             }
         }
 
+    #endif
+
         void UpdateVU(double newval)
         {
             if (newval > _oldVU)
@@ -506,36 +662,21 @@ struct AudioVariables
 
             for (int i = 2; i < _MaxSamples / 2; i++)
             {
-                // Track the average and the peak value
-
-                averageSum += _vReal[i];
-                if (_vReal[i] > samplesPeak)
-                    samplesPeak = _vReal[i];
-
-                // If it's above the noise floor, figure out which band this belongs to and
-                // if it's a new peak for that band, record that fact
+                const float value = _vReal[i];
 
-                int freq = BucketFrequency(i);
-                int iBand = 0;
-                while (iBand < _BandCount - 1)
-                {
-                    if (freq < BandCutoffTable(_BandCount)[iBand])
-                        break;
-                    iBand++;
-                }
-                if (iBand > _BandCount - 1)
-                    iBand = _BandCount - 1;
+                // Track the average and the peak value
 
-                if (_vReal[i] > NOISE_CUTOFF)
-                {
-                    if (_vReal[i] > _vPeaks[iBand])
-                        _vPeaks[iBand] += _vReal[i];
-                }
+                averageSum += value;
+                if (value > samplesPeak)
+                    samplesPeak = value;
             }
 
+            AddBinsToBands(_vReal, _vPeaks);
+
             // Print out the low 4 and high 4 bands so we can monitor levels in the debugger if needed
             debugV("Raw Peaks: %0.1lf %0.1lf  %0.1lf  %0.1lf <--> %0.1lf  %0.1lf  %0.1lf  %0.1lf",
-                _vPeaks[0], _vPeaks[1], _vPeaks[2], _vPeaks[3], _vPeaks[12], _vPeaks[13], _vPeaks[14], _vPeaks[15]);
+                _vPeaks[0], _vPeaks[1], _vPeaks[2], _vPeaks[3],
+                _vPeaks[_BandCount - 4], _vPeaks[_BandCount - 3], _vPeaks[_BandCount - 2], _vPeaks[_BandCount - 1]);
 
             //        for (int i = 0; i < _BandCount; i++)
             //        {
@@ -555,6 +696,10 @@ struct AudioVariables
             // It's hard to know what to use for a "minimum" volume so I aimed for a light ambient noise background
             // just triggering the bottom pixel, and real silence yielding darkness
 
+            // The tempo tracker wants the levels before they're scaled to this pass's loudest band
+
+            _tempo.Update(_vPeaks, _BandCount, esp_timer_get_time() / (double) MICROS_PER_SECOND);
+
             debugV("All Bands Peak: %f", allBandsPeak);
             allBandsPeak = max(NOISE_FLOOR, allBandsPeak);
 
@@ -599,6 +744,28 @@ struct AudioVariables
                 lowFreq *= df;
                 Serial.printf("Band %d: %i\n", i, _cutOffsBand[i]);
             }
+
+            BuildBinBandTable();
+        }
+
+        // BuildBinBandTable
+        //
+        // Resolves the band cutoffs into a per-bin lookup once, so that ProcessPeaks doesn't have to search for each
+        // bin's band on every pass.  It's the same search ProcessPeaks used to do: a bin goes in the first band whose
+        // cutoff is above its BucketFrequency, or the top band if none is.  --audiobench checks the two agree.
+
+        void BuildBinBandTable()
+        {
+            for (int i = 0; i < _MaxSamples / 2; i++)
+            {
+                const int freq = BucketFrequency(i);
+
+                int iBand = 0;
+                while (iBand < _BandCount - 1 && freq >= _cutOffsBand[iBand])
+                    iBand++;
+
+                _binBand[i] = iBand;
+            }
         }
 
         PeakData GetSamplePassPeaks()
@@ -630,14 +797,22 @@ struct AudioVariables
         SoundAnalyzer(uint8_t inputPin)
             : _sampling_period_us(PERIOD_FROM_FREQ(SAMPLING_FREQUENCY)),
             _inputPin(inputPin)
+        #if !USE_ARDUINOFFT
+            , _fft(MAX_SAMPLES)
+        #endif
+            , _tempo(NOISE_CUTOFF)
         {
             _BandCount = NUM_BANDS;
             _SamplingFrequency = SAMPLING_FREQUENCY;
             _MaxSamples = MAX_SAMPLES;
             _InputPin = INPUT_PIN;
 
+        #if USE_ARDUINOFFT
             _vReal      = (double *)malloc(_MaxSamples * sizeof(_vReal[0]));
             _vImaginary = (double *)malloc(_MaxSamples * sizeof(_vImaginary[0]));
+        #else
+            _vReal      = (float *) malloc(_MaxSamples * sizeof(_vReal[0]));
+        #endif
             _vPeaks     = (float *) malloc(_BandCount * sizeof(_vPeaks[0]));
 
             _oldVU = 0.0f;
@@ -652,7 +827,9 @@ struct AudioVariables
         ~SoundAnalyzer()
         {
             free(_vReal);
-            free(_vImaginary);
+            #if USE_ARDUINOFFT
+                free(_vImaginary);
+            #endif
             free(_vPeaks);
         }
        
@@ -723,6 +900,106 @@ struct AudioVariables
             return _Peaks;
         }
         
+        // PublishAudioFrame
+        //
+        // Sampler task only, once a pass is complete
+
+        void PublishAudioFrame()
+        {
+            AudioFrame frame;
+
+            frame.sequence    = _audioFrame.Version() + 1;
+            frame.vu          = _VU;
+            frame.vuRatio     = _VURatio;
+            frame.vuRatioFade = _VURatioFade;
+            frame.minVU       = _MinVU;
+            frame.peakVU      = _PeakVU;
+            frame.bRemote     = _MicMode == PeakData::PCREMOTE;
+            frame.bpm         = _tempo.BPM();
+            frame.beatPhase   = _tempo.BeatPhase();
+            frame.tempoConfidence = _tempo.Confidence();
+            frame.beatCount   = _tempo.BeatCount();
+
+            for (int i = 0; i < NUM_BANDS; i++)
+            {
+                frame.peaks[i]         = _Peaks[i];
+                frame.peak1Decay[i]    = g_peak1Decay[i];
+                frame.peak2Decay[i]    = g_peak2Decay[i];
+                frame.lastPeak1Time[i] = g_lastPeak1Time[i];
+            }
+
+            _audioFrame.Publish(frame);
+        }
+
+        // SetAudioSource
+        //
+        // Listen to pSource rather than the microphone, or go back to the microphone given nullptr.  Sampler task
+        // only, or before it starts.
+
+        void SetAudioSource(AudioSource * pSource)
+        {
+            _pSource = pSource;
+        }
+
+        size_t SamplingFrequency() const
+        {
+            return _SamplingFrequency;
+        }
+
+        // How many new samples each pass takes in, and so how much time it covers
+
+        size_t SamplesPerPass() const
+        {
+            return AUDIO_STREAMING_CAPTURE ? AUDIO_HOP_SAMPLES : MAX_SAMPLES;
+        }
+
+        // AddBinsToBands
+        //
+        // The heart of ProcessPeaks: any bin above the noise floor that's louder than its band's level so far is
+        // added to it.  Public, along with the bin and band accessors after it, so --audiobench can check it against
+        // the per-bin band search it replaced.
+
+        template <typename T>
+        void AddBinsToBands(const T * pBins, float * pPeaks) const
+        {
+            for (int i = 2; i < _MaxSamples / 2; i++)
+                if (pBins[i] > NOISE_CUTOFF && pBins[i] > pPeaks[_binBand[i]])
+                    pPeaks[_binBand[i]] += pBins[i];
+        }
+
+        size_t BinCount() const
+        {
+            return _MaxSamples / 2;
+        }
+
+        int BinFrequency(int iBin) const
+        {
+            return BucketFrequency(iBin);
+        }
+
+        int BandCutoff(int iBand) const
+        {
+            return _cutOffsBand[iBand];
+        }
+
+        // SamplerPass
+        //
+        // Everything the sampler task does each time around: takes in the next window of samples (or the latest
+        // remote peaks), works out the bands, peaks and VU from it and publishes the result
+
+        void SamplerPass()
+        {
+            RunSamplerPass();
+            UpdatePeakData();
+            DecayPeaks();
+
+            // Instantaneous VURatio
+
+            _VURatio = (_PeakVU == _MinVU) ? 0.0 : (_VU - _MinVU) / std::max(_PeakVU - _MinVU, (float) MIN_VU) * 2.0f;
+
+            PublishAudioFrame();
+        }
+
         inline void SetPeakData(const PeakData & peaks)
         {
             debugV("Manually setting peaks!");
@@ -737,10 +1014,19 @@ struct AudioVariables
 
         inline void RunSamplerPass()
         {
+            // A stream has to be read whether we use it or not, or the driver drops samples; it also paces the passes
+
+            #if AUDIO_STREAMING_CAPTURE
+                Reset();
+                FillBuffer();
+            #endif
+
             if (millis() - _msLastRemote > AUDIO_PEAK_REMOTE_TIMEOUT)
             {
-                Reset();
-                FillBufferI2S();
+                #if !AUDIO_STREAMING_CAPTURE
+                    Reset();
+                    FillBuffer();
+                #endif
                 FFT();
                 _Peaks = ProcessPeaks();
                 _Peaks.ApplyScalars(PeakData::M5);
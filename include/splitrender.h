@@ -0,0 +1,121 @@
+//+--------------------------------------------------------------------------
+//
+// File:        splitrender.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Draws effects that can draw their frame in pieces (see
+//    LEDStripEffect::CanDrawSplit) on both cores at once.  The draw task
+//    hands the second half of the frame, half the channels or half the
+//    matrix rows, to a worker task pinned to the other core, draws the
+//    first half itself, and then waits for the worker before returning,
+//    so the frame is complete by the time it gets to ShowStrip.
+//
+//    The worker is woken with a task notification.  The draw task waits
+//    for it by spinning on a flag instead, since its own notifications
+//    belong to the FrameScheduler, and by the time it has drawn its half
+//    the worker should be all but done with the other.
+//
+//    Effects that can't be split, and every effect until the worker has
+//    started, are simply drawn by the draw task as before.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+
+class SplitRenderer
+{
+    std::atomic<TaskHandle_t>   _hWorker { nullptr };
+    LEDStripEffect *            _pEffect = nullptr;
+    FramePart                   _part = { };
+    std::atomic<bool>           _bDone { true };
+
+  public:
+
+    // RunWorker
+    //
+    // Body of the worker task, which never returns.  Draws whatever part of a frame it is handed each time it is
+    // notified, then raises the done flag.
+
+    void RunWorker()
+    {
+        _hWorker = xTaskGetCurrentTaskHandle();
+
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (_bDone.load(std::memory_order_acquire))
+                continue;
+
+            {
+                TaskBusyTimer busy;
+                _pEffect->DrawPart(_part);
+            }
+            _bDone.store(true, std::memory_order_release);
+        }
+    }
+
+    static void WorkerEntry(void * pThis)
+    {
+        ((SplitRenderer *) pThis)->RunWorker();
+    }
+
+    bool IsRunning() const
+    {
+        return _hWorker != nullptr;
+    }
+
+    // Draw
+    //
+    // Draw task only.  Draws a frame of the effect, split across both cores if it can be.
+
+    void Draw(LEDStripEffect * pEffect)
+    {
+        TaskHandle_t hWorker = _hWorker;
+        FramePart first, second;
+
+        if (!hWorker || !pEffect->CanDrawSplit() || !pEffect->WholeFrame().Split(first, second))
+        {
+            pEffect->Draw();
+            return;
+        }
+
+        pEffect->PrepareFrame();
+
+        _pEffect = pEffect;
+        _part    = second;
+        _bDone.store(false, std::memory_order_release);
+        xTaskNotifyGive(hWorker);
+
+        pEffect->DrawPart(first);
+
+        while (!_bDone.load(std::memory_order_acquire))
+            ;
+    }
+};
+
+#if USE_SPLIT_RENDER
+    extern SplitRenderer g_SplitRenderer;
+#endif
@@ -32,6 +32,10 @@
 //    watchdog on for our own idle tasks, and feed the watchdog in 
 //    ProcessIdleTime as we consume all available idle time.
 //
+//    NightDriverTaskManager also keeps per-task numbers for the tasks it
+//    starts: busy time, which each task reports with a TaskBusyTimer
+//    around its work, and the stack high-water mark.
+//
 //    BUGBUG(davepl): I think this means that vTaskDelete is never called
 //                    since it was handled by the idle tasks.
 //
@@ -43,8 +47,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <Arduino.h>
 #include <esp_task_wdt.h>
+#include <esp_timer.h>
 
 #define IDLE_STACK_SIZE 2048        
 // Stack size for the taskmgr's idle threads
@@ -189,85 +196,230 @@ void IRAM_ATTR AudioSamplerTaskEntry(void *);
 void IRAM_ATTR NetworkHandlingLoopEntry(void *);
 void IRAM_ATTR DebugLoopTaskEntry(void *);
 void IRAM_ATTR SocketServerTaskEntry(void *);
+void IRAM_ATTR UDPServerTaskEntry(void *);
 void IRAM_ATTR RemoteLoopEntry(void *);
+void IRAM_ATTR SplitRenderTaskEntry(void *);
 
 class NightDriverTaskManager : public TaskManager
 {
+public:
+
+    // The tasks we start, and the names we report them by
+
+    enum TaskId
+    {
+        ScreenTask,
+        DrawTask,
+        AudioTask,
+        SerialTask,
+        NetTask,
+        DebugTask,
+        SocketTask,
+        UDPTask,
+        RemoteTask,
+        RenderTask,
+        TaskCount
+    };
+
+    static constexpr const char * TaskNames[TaskCount] = { "Screen", "Draw", "Audio", "Serial", "Net", "Debug", "Socket", "UDP", "Remote", "Render" };
+
+    // TaskStatistics
+    //
+    // What GetTaskStatistics reports for each task.  CPU is the share of one core the task was busy for since
+    // the previous sample, stack free is the least the stack has ever had left, in bytes on the ESP32.
+
+    struct TaskStatistics
+    {
+        const char * name;
+        bool         running;
+        float        cpuPercent;
+        uint64_t     busyMicros;
+        uint32_t     stackFree;
+    };
+
 private:
 
-    TaskHandle_t _taskScreen = nullptr;
-    TaskHandle_t _taskSync   = nullptr;
-    TaskHandle_t _taskDraw   = nullptr;
-    TaskHandle_t _taskDebug  = nullptr;
-    TaskHandle_t _taskAudio  = nullptr;
-    TaskHandle_t _taskNet    = nullptr;
-    TaskHandle_t _taskRemote = nullptr;
-    TaskHandle_t _taskSocket = nullptr;
-    TaskHandle_t _taskSerial = nullptr;
+    static constexpr int64_t kMinSampleMicros = 1000000;
+
+    // Only the task itself touches its nesting depth and writes its busy time, so the latter is the only atomic
+
+    struct TaskSlot
+    {
+        TaskHandle_t            handle = nullptr;
+        uint32_t                depth = 0;
+        std::atomic<uint64_t>   busyMicros { 0 };
+        uint64_t                lastBusyMicros = 0;
+        float                   cpuPercent = 0.0f;
+    };
+
+    TaskSlot   _aTasks[TaskCount];
+    std::mutex _sampleMutex;
+    int64_t    _usLastSample = 0;
+
+    void StartTask(TaskId id, TaskFunction_t pEntry, const char * pszName, UBaseType_t priority, BaseType_t core)
+    {
+        debugW(">> Launching %s Thread", TaskNames[id]);
+        xTaskCreatePinnedToCore(pEntry, pszName, STACK_SIZE, nullptr, priority, &_aTasks[id].handle, core);
+    }
+
+    TaskSlot * FindCurrentTask()
+    {
+        TaskHandle_t current = xTaskGetCurrentTaskHandle();
+        for (auto & task : _aTasks)
+            if (task.handle == current)
+                return &task;
+        return nullptr;
+    }
 
 public:
 
     void StartScreenThread()
     {
-        debugW(">> Launching Screen Thread");
-        xTaskCreatePinnedToCore(ScreenUpdateLoopEntry, "Screen Loop", STACK_SIZE, nullptr, SCREEN_PRIORITY, &_taskScreen, SCREEN_CORE);
+        StartTask(ScreenTask, ScreenUpdateLoopEntry, "Screen Loop", SCREEN_PRIORITY, SCREEN_CORE);
     }
 
     void StartSerialThread()
     {
         #if ENABLE_SERIAL
-            debugW(">> Launching Serial Thread");
-            xTaskCreatePinnedToCore(AudioSerialTaskEntry, "Audio Serial Loop", STACK_SIZE, nullptr, AUDIOSERIAL_PRIORITY, &_taskAudio, AUDIOSERIAL_CORE);    
+            StartTask(SerialTask, AudioSerialTaskEntry, "Audio Serial Loop", AUDIOSERIAL_PRIORITY, AUDIOSERIAL_CORE);
         #endif
     }
     
 
     void StartDrawThread()
     {
-        debugW(">> Launching Draw Thread");
-        xTaskCreatePinnedToCore(DrawLoopTaskEntry, "Draw Loop", STACK_SIZE, nullptr, DRAWING_PRIORITY, &_taskDraw, DRAWING_CORE);    
+        StartTask(DrawTask, DrawLoopTaskEntry, "Draw Loop", DRAWING_PRIORITY, DRAWING_CORE);
     }
 
     void StartAudioThread()
     {
         #if ENABLE_AUDIO
-            debugW(">> Launching Audio Thread");
-            xTaskCreatePinnedToCore(AudioSamplerTaskEntry, "Audio Sampler Loop", STACK_SIZE, nullptr, AUDIO_PRIORITY, &_taskAudio, AUDIO_CORE);
+            StartTask(AudioTask, AudioSamplerTaskEntry, "Audio Sampler Loop", AUDIO_PRIORITY, AUDIO_CORE);
         #endif
     }
     
     void StartNetworkThread()
     {
         #if ENABLE_WIFI
-            debugW(">> Launching Network Thread");
-            xTaskCreatePinnedToCore(NetworkHandlingLoopEntry, "NetworkHandlingLoop", STACK_SIZE, nullptr, NET_PRIORITY, &_taskSync, NET_CORE);    
+            StartTask(NetTask, NetworkHandlingLoopEntry, "NetworkHandlingLoop", NET_PRIORITY, NET_CORE);
         #endif
     }
 
     void StartDebugThread()
     {
         #if ENABLE_WIFI
-            debugW(">> Launching Debug Thread");
-            xTaskCreatePinnedToCore(DebugLoopTaskEntry, "Debug Loop", STACK_SIZE, nullptr, DEBUG_PRIORITY, &_taskDebug, DEBUG_CORE);    
+            StartTask(DebugTask, DebugLoopTaskEntry, "Debug Loop", DEBUG_PRIORITY, DEBUG_CORE);
         #endif
     }
     
     void StartSocketThread()
     {
         #if ENABLE_WIFI
-            debugW(">> Launching Socket Thread");
-            xTaskCreatePinnedToCore(SocketServerTaskEntry, "Socket Server Loop", STACK_SIZE, nullptr, SOCKET_PRIORITY, &_taskSocket, SOCKET_CORE);
+            StartTask(SocketTask, SocketServerTaskEntry, "Socket Server Loop", SOCKET_PRIORITY, SOCKET_CORE);
+        #endif
+    }
+
+    void StartUDPThread()
+    {
+        #if ENABLE_WIFI
+            StartTask(UDPTask, UDPServerTaskEntry, "UDP Server Loop", SOCKET_PRIORITY, SOCKET_CORE);
         #endif
     }
 
     void StartRemoteThread()
     {
         #if ENABLE_WIFI
-            debugW(">> Launching Remote Thread");
-            xTaskCreatePinnedToCore(RemoteLoopEntry, "IR Remote Loop", STACK_SIZE, nullptr, REMOTE_PRIORITY, &_taskRemote, REMOTE_CORE);
+            StartTask(RemoteTask, RemoteLoopEntry, "IR Remote Loop", REMOTE_PRIORITY, REMOTE_CORE);
         #endif
     }
+
+    // The split rendering worker runs at the draw task's priority so that it finishes its half about when the draw
+    // task finishes the other
+
+    void StartRenderThread()
+    {
+        #if USE_SPLIT_RENDER
+            StartTask(RenderTask, SplitRenderTaskEntry, "Split Render", DRAWING_PRIORITY, RENDER_CORE);
+        #endif
+    }
+
+    // BeginBusy/EndBusy
+    //
+    // Called by TaskBusyTimer.  Time is only counted for the outermost pair, so work that calls other instrumented
+    // work isn't counted twice, and only when the caller is one of our tasks.  Returns the start time, or 0 if the
+    // pair isn't being counted.
+
+    int64_t BeginBusy()
+    {
+        TaskSlot * pTask = FindCurrentTask();
+        if (!pTask || pTask->depth++ > 0)
+            return 0;
+        return esp_timer_get_time();
+    }
+
+    void EndBusy(int64_t usStart)
+    {
+        TaskSlot * pTask = FindCurrentTask();
+        if (!pTask || pTask->depth == 0)
+            return;
+        if (--pTask->depth == 0 && usStart != 0)
+            pTask->busyMicros.fetch_add(esp_timer_get_time() - usStart, std::memory_order_relaxed);
+    }
+
+    // GetTaskStatistics
+    //
+    // Fills in one entry per TaskId.  The CPU percentages are recomputed from the busy time totals when it has been at
+    // least a second since they last were, so they cover whatever window lies between two such samples.
+
+    void GetTaskStatistics(TaskStatistics (&stats)[TaskCount])
+    {
+        std::lock_guard<std::mutex> guard(_sampleMutex);
+
+        int64_t usNow = esp_timer_get_time();
+        bool bResample = usNow - _usLastSample >= kMinSampleMicros;
+
+        for (int i = 0; i < TaskCount; i++)
+        {
+            TaskSlot & task = _aTasks[i];
+            uint64_t busyMicros = task.busyMicros.load(std::memory_order_relaxed);
+
+            if (bResample)
+            {
+                task.cpuPercent = _usLastSample ? 100.0f * (busyMicros - task.lastBusyMicros) / (usNow - _usLastSample) : 0.0f;
+                task.lastBusyMicros = busyMicros;
+            }
+
+            stats[i].name       = TaskNames[i];
+            stats[i].running    = task.handle != nullptr;
+            stats[i].cpuPercent = task.cpuPercent;
+            stats[i].busyMicros = busyMicros;
+            stats[i].stackFree  = task.handle ? uxTaskGetStackHighWaterMark(task.handle) : 0;
+        }
+
+        if (bResample)
+            _usLastSample = usNow;
+    }
 };
 
 extern NightDriverTaskManager g_TaskManager;
 
+// TaskBusyTimer
+//
+// Counts the time from construction to destruction as busy time for the calling task.  Tasks put one around the
+// work in each trip through their loops, leaving out the time they spend waiting in delay() or on a socket.
+
+class TaskBusyTimer
+{
+    int64_t _usStart;
+
+  public:
+
+    TaskBusyTimer() : _usStart(g_TaskManager.BeginBusy())
+    {
+    }
+
+    ~TaskBusyTimer()
+    {
+        g_TaskManager.EndBusy(_usStart);
+    }
+};
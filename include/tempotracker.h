@@ -0,0 +1,339 @@
+//+--------------------------------------------------------------------------
+//
+// File:        tempotracker.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Works out the tempo of whatever the microphone is hearing, and keeps
+//    a clock that ticks along with its beats, so effects can line their
+//    animation up with the music and see a beat coming rather than only
+//    react once it's been and gone.
+//
+//    Each pass of band levels gives an onset strength, the spectral flux:
+//    how much louder each band got since the pass before, on a log scale,
+//    added up over the bands.  That goes into an envelope sampled at a
+//    fixed kEnvelopeHz, whatever rate the passes come at, which holds the
+//    last kHistory samples.
+//
+//    Every kEstimateEvery samples, the autocorrelation of the envelope is
+//    run through a comb filter: for each tempo from kMinBPM to kMaxBPM,
+//    the autocorrelation at one, two, three and four beat periods added
+//    up, and weighted towards kPreferredBPM so a steady beat isn't taken
+//    for one at half or double its speed.  The best is the tempo.  The
+//    comb is then slid along the envelope itself at that period to find
+//    where the beats fall, which pulls the beat clock towards them.
+//
+//    Nothing here depends on Arduino, so the native build's --tempobench
+//    can run recordings through it.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+
+class TempoTracker
+{
+  public:
+
+    static constexpr float  kEnvelopeHz    = 50.0f;     // Onset envelope samples per second
+    static constexpr size_t kHistory       = 512;       // Envelope samples kept, about ten seconds
+    static constexpr size_t kMinHistory    = 300;       // Envelope samples needed before the first estimate
+    static constexpr size_t kEstimateEvery = 25;        // Envelope samples between estimates
+    static constexpr float  kMinBPM        = 60.0f;
+    static constexpr float  kMaxBPM        = 180.0f;
+    static constexpr float  kBPMStep       = 0.5f;
+    static constexpr float  kPreferredBPM  = 120.0f;
+    static constexpr float  kPriorOctaves  = 1.0f;      // Width of the weighting towards kPreferredBPM
+    static constexpr int    kHarmonics     = 4;         // Teeth in the comb
+    static constexpr float  kPhaseGain     = 0.5f;      // How much of the phase error each estimate corrects
+    static constexpr float  kRetuneRatio   = 0.04f;     // A tempo change bigger than this restarts the beat clock
+    static constexpr size_t kMaxBands      = 64;
+
+  private:
+
+    static constexpr size_t kMaxLag = (size_t)(kHarmonics * 60.0f * kEnvelopeHz / kMinBPM) + 2;
+    static_assert(kMaxLag < kMinHistory && kMinHistory <= kHistory, "Not enough history for the slowest tempo");
+
+    const float _levelFloor;                            // Band level that counts as silence
+    float    _lastLevels[kMaxBands] = { };
+    bool     _bPrimed = false;
+
+    float    _envelope[kHistory] = { };                 // Ring of onset strengths
+    size_t   _cSamples = 0;                             // Envelope samples so far
+    float    _sampleFlux = 0.0f;                        // Flux of the passes in the sample being built
+    bool     _bSampleHasPass = false;
+    double   _sampleStart = 0.0;
+    double   _lastSeconds = 0.0;
+    bool     _bStarted = false;
+
+    float    _series[kHistory];                         // Scratch for estimates: the envelope, newest first
+    float    _autocorrelation[kMaxLag + 1];
+
+    float    _bpm = 0.0f;
+    float    _confidence = 0.0f;
+    float    _phase = 0.0f;
+    uint32_t _cBeats = 0;
+    double   _secondsSinceBeat = 0.0;
+
+    // Envelope sample i samples ago, 0 being the newest
+
+    float Envelope(size_t iAgo) const
+    {
+        return _envelope[(_cSamples - 1 - iAgo) % kHistory];
+    }
+
+    // Linear interpolation into a series at a fractional index
+
+    static float Interpolate(const float * pSeries, size_t count, float index)
+    {
+        size_t i = (size_t) index;
+        if (i + 1 >= count)
+            return i < count ? pSeries[i] : 0.0f;
+        float fraction = index - i;
+        return pSeries[i] + (pSeries[i + 1] - pSeries[i]) * fraction;
+    }
+
+    static float PeriodInSamples(float bpm)
+    {
+        return 60.0f * kEnvelopeHz / bpm;
+    }
+
+    // Moves the beat clock on by delta beats (which may be negative), counting a beat each time it passes one, but
+    // never two within half a beat of each other
+
+    void AdvancePhase(float delta)
+    {
+        _phase += delta;
+        if (_phase >= 1.0f)
+        {
+            _phase -= floorf(_phase);
+            if (_secondsSinceBeat >= 30.0 / _bpm)
+            {
+                _cBeats++;
+                _secondsSinceBeat = 0.0;
+            }
+        }
+        else if (_phase < 0.0f)
+        {
+            _phase -= floorf(_phase);
+        }
+    }
+
+    void AddSample(float flux)
+    {
+        _envelope[_cSamples % kHistory] = flux;
+        _cSamples++;
+
+        if (_cSamples >= kMinHistory && _cSamples % kEstimateEvery == 0)
+            Estimate();
+    }
+
+    // Estimate
+    //
+    // Picks the tempo whose comb best matches the envelope's autocorrelation, then the phase of the beats
+
+    void Estimate()
+    {
+        const size_t cSeries = std::min(_cSamples, kHistory);
+
+        float mean = 0.0f;
+        for (size_t i = 0; i < cSeries; i++)
+            mean += (_series[i] = Envelope(i));
+        mean /= cSeries;
+
+        for (size_t i = 0; i < cSeries; i++)
+            _series[i] -= mean;
+
+        // Each lag's autocorrelation is averaged over the samples it overlaps, so long lags aren't penalized
+
+        for (size_t lag = 0; lag <= kMaxLag; lag++)
+        {
+            float sum = 0.0f;
+            for (size_t i = lag; i < cSeries; i++)
+                sum += _series[i] * _series[i - lag];
+            _autocorrelation[lag] = sum / (cSeries - lag);
+        }
+
+        if (_autocorrelation[0] <= 0.0f)
+        {
+            _confidence = 0.0f;
+            return;
+        }
+
+        float bestBPM = 0.0f, bestScore = -INFINITY, bestComb = 0.0f;
+        for (float bpm = kMinBPM; bpm <= kMaxBPM; bpm += kBPMStep)
+        {
+            const float period = PeriodInSamples(bpm);
+
+            float comb = 0.0f;
+            for (int k = 1; k <= kHarmonics; k++)
+                comb += Interpolate(_autocorrelation, kMaxLag + 1, k * period);
+            comb /= kHarmonics;
+
+            const float octaves = log2f(bpm / kPreferredBPM) / kPriorOctaves;
+            const float score = comb * expf(-0.5f * octaves * octaves);
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestBPM   = bpm;
+                bestComb  = comb;
+            }
+        }
+
+        _confidence = std::max(0.0f, std::min(1.0f, bestComb / _autocorrelation[0]));
+
+        // Slide the comb along the envelope, newest first, to find how many samples ago the last beat fell
+
+        const float period = PeriodInSamples(bestBPM);
+        float bestOffset = 0.0f, bestSum = -INFINITY;
+        for (float offset = 0.0f; offset < period; offset += 1.0f)
+        {
+            float sum = 0.0f;
+            for (float index = offset; index < cSeries; index += period)
+                sum += Interpolate(_series, cSeries, index);
+            if (sum > bestSum)
+            {
+                bestSum    = sum;
+                bestOffset = offset;
+            }
+        }
+
+        // The newest sample is half a sample old on average by the time this runs
+
+        float targetPhase = (bestOffset + 0.5f) / period;
+        targetPhase -= floorf(targetPhase);
+
+        if (_bpm == 0.0f || fabsf(bestBPM - _bpm) > _bpm * kRetuneRatio)
+        {
+            _bpm   = bestBPM;
+            _phase = targetPhase;
+            return;
+        }
+
+        _bpm = bestBPM;
+
+        float error = targetPhase - _phase;
+        error -= roundf(error);
+        AdvancePhase(error * kPhaseGain);
+    }
+
+  public:
+
+    // levelFloor is the band level below which there's nothing to hear; flux is measured relative to it
+
+    explicit TempoTracker(float levelFloor = 1.0f)
+        : _levelFloor(levelFloor)
+    {
+    }
+
+    // Update
+    //
+    // Takes the band levels from one pass of the analyzer, before any scaling that changes from one pass to the
+    // next, and the time of the pass in seconds
+
+    void Update(const float * pLevels, size_t cLevels, double seconds)
+    {
+        cLevels = std::min(cLevels, kMaxBands);
+
+        float flux = 0.0f;
+        for (size_t i = 0; i < cLevels; i++)
+        {
+            const float level = log1pf(std::max(0.0f, pLevels[i]) / _levelFloor);
+            if (_bPrimed)
+                flux += std::max(0.0f, level - _lastLevels[i]);
+            _lastLevels[i] = level;
+        }
+        _bPrimed = true;
+
+        if (!_bStarted)
+        {
+            _bStarted    = true;
+            _sampleStart = seconds;
+            _lastSeconds = seconds;
+        }
+
+        // Run the beat clock up to now
+
+        const double elapsed = seconds - _lastSeconds;
+        _lastSeconds = seconds;
+        if (_bpm > 0.0f && elapsed > 0.0)
+        {
+            _secondsSinceBeat += elapsed;
+            AdvancePhase(elapsed * _bpm / 60.0);
+        }
+
+        // Finish any envelope samples that ended before this pass.  One with no pass of its own, because the
+        // passes are slower than the envelope, repeats the one before it.  After a long stall, start over.
+
+        constexpr double samplePeriod = 1.0 / kEnvelopeHz;
+        if (seconds - _sampleStart > kHistory * samplePeriod)
+        {
+            _sampleStart = seconds;
+            _sampleFlux = 0.0f;
+            _bSampleHasPass = false;
+        }
+
+        while (seconds >= _sampleStart + samplePeriod)
+        {
+            AddSample(_bSampleHasPass || _cSamples == 0 ? _sampleFlux : Envelope(0));
+            _sampleFlux = 0.0f;
+            _bSampleHasPass = false;
+            _sampleStart += samplePeriod;
+        }
+
+        _sampleFlux += flux;
+        _bSampleHasPass = true;
+    }
+
+    // Beats per minute, or 0 until there's been enough to go on
+
+    float BPM() const
+    {
+        return _bpm;
+    }
+
+    // How far through the current beat the clock is, from 0 on the beat to just under 1
+
+    float BeatPhase() const
+    {
+        return _phase;
+    }
+
+    // How strongly the envelope repeats at the tempo, from 0 for not at all to 1 for perfectly
+
+    float Confidence() const
+    {
+        return _confidence;
+    }
+
+    // Beats the clock has ticked since startup, so a reader can tell when a new one has started
+
+    uint32_t BeatCount() const
+    {
+        return _cBeats;
+    }
+};
@@ -0,0 +1,291 @@
+//+--------------------------------------------------------------------------
+//
+// File:        UDPServer.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+//
+// Description:
+//
+//    Receives LED data as UDP datagrams, unicast or on a multicast group.
+//    Each datagram is one packet just as the TCP socket server would see
+//    it: the 24 byte header followed by the CRGB data (or the peak data).
+//
+//    Unlike TCP there's no stall waiting on a retransmit: a frame that
+//    goes missing is simply never drawn, and a mangled one is dropped.
+//    And rather than a SocketResponse for every frame, the sender gets
+//    one every UDP_RESPONSE_INTERVAL_MS, or straight away when a delta
+//    frame is refused so that it knows to send a full one.
+//
+//    A frame has to fit in one datagram.  Anything past the WiFi MTU
+//    (about 480 LEDs) gets IP fragmented, which needs IP reassembly
+//    enabled in lwIP, and losing any one fragment loses the frame.
+//
+// History:     Oct-16-2026     Davepl      Created
+//---------------------------------------------------------------------------
+#pragma once
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+
+#include "socketserver.h"
+
+#if ENABLE_WIFI && INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+
+// UDPServer
+//
+// Listens on a UDP port (and optionally a multicast group) and feeds whatever arrives into the buffer queues
+
+class UDPServer
+{
+private:
+
+    int                         _port;
+    const char *                _pszMulticastGroup;
+    int                         _fd;
+    std::unique_ptr<uint8_t []> _pBuffer;                   // For anything that isn't pixel data
+    struct sockaddr_in          _lastSender;
+    bool                        _bHaveSender;
+    bool                        _bResponseDue;              // Send one now rather than waiting out the interval
+    uint32_t                    _msLastResponse;
+
+public:
+
+    size_t                      _cDatagrams;                // Everything that arrived
+    size_t                      _cDropped;                  // Arrived, but not drawn: truncated, malformed, or the TCP server was busy
+
+    UDPServer(int port, const char * pszMulticastGroup) :
+        _port(port),
+        _pszMulticastGroup(pszMulticastGroup),
+        _fd(-1),
+        _bHaveSender(false),
+        _bResponseDue(false),
+        _msLastResponse(0),
+        _cDatagrams(0),
+        _cDropped(0)
+    {
+        memset(&_lastSender, 0, sizeof(_lastSender));
+    }
+
+    void release()
+    {
+        _pBuffer.reset();
+
+        if (_fd >= 0)
+        {
+            close(_fd);
+            _fd = -1;
+        }
+    }
+
+    bool begin()
+    {
+        _pBuffer = std::make_unique<uint8_t []>(MAXIUMUM_PACKET_SIZE);
+
+        if ((_fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
+        {
+            debugW("UDP socket error\n");
+            release();
+            return false;
+        }
+
+        int one = 1;
+        setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(_port);
+
+        if (bind(_fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+        {
+            debugW("UDP bind failed\n");
+            release();
+            return false;
+        }
+
+        if (_pszMulticastGroup)
+        {
+            struct ip_mreq mreq;
+            mreq.imr_multiaddr.s_addr = inet_addr(_pszMulticastGroup);
+            mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+            if (setsockopt(_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+            {
+                debugW("Could not join multicast group %s\n", _pszMulticastGroup);
+                release();
+                return false;
+            }
+            debugI("Joined multicast group %s", _pszMulticastGroup);
+        }
+
+        // Wake up once a second even if nothing arrives so that the loop notices when WiFi drops
+
+        struct timeval to;
+        to.tv_sec = 1;
+        to.tv_usec = 0;
+        if (setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to)) < 0)
+        {
+            debugW("Unable to set read timeout on UDP socket!");
+            release();
+            return false;
+        }
+
+        return true;
+    }
+
+    // ProcessIncomingDatagramsLoop
+    //
+    // Handles datagrams until the socket fails or WiFi goes away
+
+    void ProcessIncomingDatagramsLoop()
+    {
+        if (_fd < 0)
+        {
+            debugW("No UDP socket, returning.");
+            return;
+        }
+
+        while (WiFi.isConnected() && ProcessIncomingDatagram())
+            SendResponseIfDue();
+    }
+
+private:
+
+    // DiscardDatagram
+    //
+    // Pulls the datagram we peeked at out of the socket without looking at it
+
+    void DiscardDatagram()
+    {
+        uint8_t b;
+        recv(_fd, &b, sizeof(b), 0);
+        _cDropped++;
+    }
+
+    // ProcessIncomingDatagram
+    //
+    // Waits for and handles one datagram.  Pixel data is received straight into the LEDBuffer it'll be drawn from:
+    // we peek at the header to find out which buffer that is, then receive the whole datagram into its storage,
+    // which has room for the header in front of the pixels.  Returns false only if the socket itself has failed.
+
+    bool ProcessIncomingDatagram()
+    {
+        uint8_t abHeader[STANDARD_DATA_HEADER_SIZE];
+        struct sockaddr_in from;
+        socklen_t cbFrom = sizeof(from);
+
+        int cbPeeked = recvfrom(_fd, abHeader, sizeof(abHeader), MSG_PEEK, (struct sockaddr *)&from, &cbFrom);
+        if (cbPeeked < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK;          // Just the timeout
+
+        _cDatagrams++;
+
+        if (cbPeeked < STANDARD_DATA_HEADER_SIZE)
+        {
+            debugV("Runt datagram of %d bytes", cbPeeked);
+            DiscardDatagram();
+            return true;
+        }
+
+        _lastSender  = from;
+        _bHaveSender = true;
+
+        uint16_t command16 = WORDFromMemory(&abHeader[0]);
+        uint32_t length32  = DWORDFromMemory(&abHeader[4]);
+
+        if (command16 == WIFI_COMMAND_PIXELDATA64)
+        {
+            // If the TCP server is in the middle of a frame, this one is just lost like any other dropped datagram
+
+            std::unique_lock<std::mutex> lock(g_producer_mutex, std::try_to_lock);
+            LEDBuffer * pBuffer = lock.owns_lock() ? BeginIncomingPixelData(abHeader) : nullptr;
+            if (!pBuffer)
+            {
+                DiscardDatagram();
+                return true;
+            }
+
+            // A short or oversized (and therefore truncated) datagram is never committed, so the buffer is reused
+
+            int cbReceived = recv(_fd, pBuffer->WireStorage(), LEDBuffer::WireStorageSize, 0);
+            if (cbReceived != STANDARD_DATA_HEADER_SIZE + length32 * LED_DATA_SIZE)
+            {
+                debugV("Expected %u bytes of pixel data but datagram was %d", STANDARD_DATA_HEADER_SIZE + length32 * LED_DATA_SIZE, cbReceived);
+                _cDropped++;
+                return true;
+            }
+
+            if (!EndIncomingPixelData(pBuffer))
+                _cDropped++;
+            return true;
+        }
+
+        int cbReceived = recv(_fd, _pBuffer.get(), MAXIUMUM_PACKET_SIZE, 0);
+
+        // Each delta names the frame it's against, so after a lost datagram the deltas that follow are refused
+        // rather than applied to the wrong frame.  The sender hears about it right away, in the keyframeMask of
+        // the response, and sends a full frame.
+
+        if (command16 == WIFI_COMMAND_PIXELDELTA64 && cbReceived == DELTA_DATA_HEADER_SIZE + length32)
+        {
+            std::unique_lock<std::mutex> lock(g_producer_mutex, std::try_to_lock);
+            if (!lock.owns_lock() || !ProcessIncomingData(_pBuffer.get(), cbReceived))
+            {
+                _cDropped++;
+                _bResponseDue = true;
+            }
+            return true;
+        }
+
+        #if ENABLE_AUDIO
+            if (command16 == WIFI_COMMAND_PEAKDATA && cbReceived == STANDARD_DATA_HEADER_SIZE + NUM_BANDS * sizeof(float))
+            {
+                ProcessIncomingData(_pBuffer.get(), cbReceived);
+                return true;
+            }
+        #endif
+
+        debugV("Ignoring UDP datagram with command %u and %d bytes", command16, cbReceived);
+        _cDropped++;
+        return true;
+    }
+
+    // SendResponseIfDue
+    //
+    // Sends the most recent sender a SocketResponse if it hasn't had one in UDP_RESPONSE_INTERVAL_MS, or if a
+    // delta was just refused
+
+    void SendResponseIfDue()
+    {
+        if (!_bHaveSender || (!_bResponseDue && millis() - _msLastResponse < UDP_RESPONSE_INTERVAL_MS))
+            return;
+
+        _msLastResponse = millis();
+        _bResponseDue   = false;
+
+        SocketResponse response = CurrentSocketResponse();
+        if (sizeof(response) != sendto(_fd, &response, sizeof(response), 0, (struct sockaddr *)&_lastSender, sizeof(_lastSender)))
+            debugW("Unable to send UDP response back to server.");
+    }
+};
+
+#endif
@@ -141,6 +141,8 @@ class CWebServer
         j["LED_FPS"]               = g_FPS;
         j["SERIAL_FPS"]            = g_Analyzer._serialFPS;
         j["AUDIO_FPS"]             = g_Analyzer._AudioFPS;
+        j["AUDIO_DROPPED_SAMPLES"] = g_Analyzer._cDroppedSamples;
+        j["AUDIO_BPM"]             = g_Analyzer.GetAudioFrame().bpm;
 
         j["HEAP_SIZE"]             = ESP.getHeapSize();
         j["HEAP_FREE"]             = ESP.getFreeHeap();
@@ -167,11 +169,89 @@ class CWebServer
         j["CPU_USED_CORE0"]        = g_TaskManager.GetCPUUsagePercent(0);
         j["CPU_USED_CORE1"]        = g_TaskManager.GetCPUUsagePercent(1);
 
+        j["INGEST_FRAMES"]         = g_cIngestFrames.load();
+        j["INGEST_COPIED_PER_FRAME"] = g_cIngestFrames ? g_cbIngestCopied / (double) g_cIngestFrames : 0.0;
+
+        #if USESTRIP
+            j["POWER_SCANS_SKIPPED"]   = g_OutputStage.ScansSkipped();
+        #endif
+
+        // How far from their due time frames were drawn, in microseconds: negative is early, positive late
+
+        static const char * const kBucketNames[FrameScheduler::BucketCount] =
+            { "<-10000", "-10000..-1001", "-1000..-101", "-100..-11", "-10..10", "11..100", "101..1000", "1001..10000", ">10000" };
+
+        j["FRAMES_PRESENTED"]      = g_FrameScheduler.FrameCount();
+        j["FRAME_MAX_EARLY_US"]    = g_FrameScheduler.MaxEarly();
+        j["FRAME_MAX_LATE_US"]     = g_FrameScheduler.MaxLate();
+        auto histogram = j.createNestedObject("FRAME_ERROR_US");
+        for (size_t i = 0; i < FrameScheduler::BucketCount; i++)
+            histogram[kBucketNames[i]] = g_FrameScheduler.BucketValue(i);
+
         response->setLength();
         response->addHeader("Access-Control-Allow-Origin", "*");
         pRequest->send(response);
     }    
 
+    // GetTaskStatistics
+    //
+    // Busy time and stack headroom for each task we started, and the mean and worst time of each draw loop stage
+    // over the last FrameTimings::Capacity frames
+
+    void GetTaskStatistics(AsyncWebServerRequest * pRequest)
+    {
+        debugV("GetTaskStatistics");
+
+        auto response = new AsyncJsonResponse(false, JSON_BUFFER_BASE_SIZE);
+        response->addHeader("Server","NightDriverStrip");
+        auto j = response->getRoot();
+
+        NightDriverTaskManager::TaskStatistics aTasks[NightDriverTaskManager::TaskCount];
+        g_TaskManager.GetTaskStatistics(aTasks);
+
+        auto tasks = j.createNestedObject("TASKS");
+        for (const auto & task : aTasks)
+        {
+            if (!task.running)
+                continue;
+            auto t = tasks.createNestedObject(task.name);
+            t["CPU_USED"]   = task.cpuPercent;
+            t["BUSY_US"]    = task.busyMicros;
+            t["STACK_FREE"] = task.stackFree;
+        }
+
+        FrameTimings::StageSummary aStages[FrameTimings::StageCount + 1];
+        j["FRAMES_TIMED"] = g_FrameTimings.Summarize(aStages);
+
+        auto stages = j.createNestedObject("STAGES_US");
+        for (int i = 0; i <= FrameTimings::StageCount; i++)
+        {
+            auto s = stages.createNestedObject(i < FrameTimings::StageCount ? FrameTimings::StageNames[i] : "Total");
+            s["MEAN"] = aStages[i].usMean;
+            s["MAX"]  = aStages[i].usMax;
+        }
+
+        // Frame scratch, summed over the channels: what the arenas hold, the most a frame has borrowed, and how
+        // often a frame had to go to the heap because it didn't fit
+
+        auto scratch = j.createNestedObject("SCRATCH_BYTES");
+        size_t cbCapacity = 0, cbHighWater = 0;
+        uint32_t cSpills = 0;
+        for (int i = 0; i < NUM_CHANNELS; i++)
+        {
+            cbCapacity  += g_aptrDevices[i]->Scratch().Capacity();
+            cbHighWater += g_aptrDevices[i]->Scratch().HighWater();
+            cSpills     += g_aptrDevices[i]->Scratch().Spills();
+        }
+        scratch["CAPACITY"]   = cbCapacity;
+        scratch["HIGH_WATER"] = cbHighWater;
+        scratch["SPILLS"]     = cSpills;
+
+        response->setLength();
+        response->addHeader("Access-Control-Allow-Origin", "*");
+        pRequest->send(response);
+    }
+
     void SetSettings(AsyncWebServerRequest * pRequest)
     {
         debugV("SetSettings");
@@ -312,6 +392,7 @@ class CWebServer
 
         _server.on("/getEffectList",         HTTP_GET, [this](AsyncWebServerRequest * pRequest) { this->GetEffectListText(pRequest); });
         _server.on("/getStatistics",         HTTP_GET, [this](AsyncWebServerRequest * pRequest) { this->GetStatistics(pRequest); });
+        _server.on("/getTaskStatistics",     HTTP_GET, [this](AsyncWebServerRequest * pRequest) { this->GetTaskStatistics(pRequest); });
         _server.on("/nextEffect",            HTTP_POST, [this](AsyncWebServerRequest * pRequest)    { this->NextEffect(pRequest); });
         _server.on("/previousEffect",        HTTP_POST, [this](AsyncWebServerRequest * pRequest)    { this->PreviousEffect(pRequest); });
 
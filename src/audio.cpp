@@ -63,9 +63,17 @@ void IRAM_ATTR AudioSamplerTaskEntry(void *)
 
     debugI(">>> Sampler Task Started");
 
+    // When streaming, each pass waits in i2s_read for its hop of samples, so the stream sets the pace instead
+
+    #if AUDIO_STREAMING_CAPTURE
+        constexpr auto msPassInterval = 0;
+    #else
+        const auto msPassInterval = g_bUpdateStarted ? 1000 : 25;
+    #endif
+
     for (;;)
     {
-        EVERY_N_MILLISECONDS(g_bUpdateStarted ? 1000 : 25)
+        EVERY_N_MILLISECONDS(msPassInterval)
         {
             static uint64_t lastFrame = millis();
             g_Analyzer._AudioFPS = FPS(lastFrame, millis());
@@ -84,20 +92,20 @@ void IRAM_ATTR AudioSamplerTaskEntry(void *)
 
             lastFrame = millis();
 
-            g_Analyzer.RunSamplerPass();
-            g_Analyzer.UpdatePeakData();        
-            g_Analyzer.DecayPeaks();
-
-            // Instantaneous VURatio
+            {
+                TaskBusyTimer busy;
 
-            g_Analyzer._VURatio = (g_Analyzer._PeakVU == g_Analyzer._MinVU) ? 0.0 : (g_Analyzer._VU-g_Analyzer._MinVU) / std::max(g_Analyzer._PeakVU - g_Analyzer._MinVU, (float) MIN_VU) * 2.0f;
+                g_Analyzer.SamplerPass();
+            }
 
             // Delay enough time to yield 25ms total used this frame, which will net 40FPS exactly (as long as the CPU keeps up)
 
-            unsigned long elapsed = millis() - lastFrame;
+            #if !AUDIO_STREAMING_CAPTURE
+                unsigned long elapsed = millis() - lastFrame;
 
-            const auto targetDelay = PERIOD_FROM_FREQ(60) * MILLIS_PER_SECOND / MICROS_PER_SECOND;
-            delay(elapsed >= targetDelay ? 1 : targetDelay - elapsed);
+                const auto targetDelay = PERIOD_FROM_FREQ(60) * MILLIS_PER_SECOND / MICROS_PER_SECOND;
+                delay(elapsed >= targetDelay ? 1 : targetDelay - elapsed);
+            #endif
         }
         yield();
     }
@@ -279,7 +287,8 @@ void IRAM_ATTR AudioSerialTaskEntry(void *)
             
         const int MAXPET = 16;                                      // Highest value that the PET can display in a bar
         data.header[0] = ((3 << 4) + 15);
-        data.vu = mapDouble(g_Analyzer._VURatioFade, 0, 2, 1, 16);           // Convert VU to a 1-16 value
+        const AudioFrame frame = g_Analyzer.GetAudioFrame();
+        data.vu = mapDouble(frame.vuRatioFade, 0, 2, 1, 16);           // Convert VU to a 1-16 value
 
         // We treat 0 as a NUL terminator and so we don't want to send it in-band.  Since a band has to be 2 before
         // it is displayed, this has no effect on the display
@@ -287,8 +296,8 @@ void IRAM_ATTR AudioSerialTaskEntry(void *)
         for (int i = 0; i < 8; i++)
         {
             int iBand = map(i, 0, 7, 0, NUM_BANDS-2);
-            uint8_t low   = g_Analyzer.g_peak2Decay[iBand] * MAXPET;
-            uint8_t high  = g_Analyzer.g_peak2Decay[iBand+1] * MAXPET;
+            uint8_t low   = frame.peak2Decay[iBand] * MAXPET;
+            uint8_t high  = frame.peak2Decay[iBand+1] * MAXPET;
             data.peaks[i] = (high << 4) + low;
         }
 
@@ -37,13 +37,20 @@
 CRGB g_SinglePixel = CRGB::Blue;
 CLEDController *g_ledSinglePixel;
 
-// The g_buffer_mutex is a global mutex used to protect access while adding or removing frames
-// from the led buffer.
-
-extern std::mutex g_buffer_mutex;
-
 DRAM_ATTR std::unique_ptr<LEDBufferManager> g_aptrBufferManager[NUM_CHANNELS];
+std::atomic<uint32_t> g_cbIngestCopied(0);
+std::atomic<uint32_t> g_cIngestFrames(0);
 DRAM_ATTR std::unique_ptr<EffectManager<GFXBase>> g_aptrEffectManager;
+FrameScheduler g_FrameScheduler;
+FrameTimings g_FrameTimings;
+
+#if USESTRIP
+    OutputStage g_OutputStage;
+#endif
+
+#if USE_SPLIT_RENDER
+    SplitRenderer g_SplitRenderer;
+#endif
 
 double volatile g_FreeDrawTime = 0.0;
 
@@ -140,7 +147,8 @@ void MatrixPreDraw()
 
 uint16_t WiFiDraw()
 {
-    std::lock_guard<std::mutex> guard(g_buffer_mutex);
+    // No lock needed; the buffer managers are lock-free with this task as their only consumer, and since nothing else
+    // takes frames out of them, the oldest buffer we peek at below stays put until we take it ourselves
 
     uint16_t pixelsDrawn = 0;
     for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
@@ -153,7 +161,7 @@ uint16_t WiFiDraw()
 
         if (false == g_aptrBufferManager[iChannel]->IsEmpty())
         {
-            std::shared_ptr<LEDBuffer> pBuffer;
+            LEDBuffer * pBuffer = nullptr;
             if (NTPTimeClient::HasClockBeenSet() == false)
             {
                 pBuffer = g_aptrBufferManager[iChannel]->GetOldestBuffer();
@@ -170,13 +178,22 @@ uint16_t WiFiDraw()
 
             if (pBuffer)
             {
+                if (NTPTimeClient::HasClockBeenSet())
+                    g_FrameScheduler.RecordPresentation((int64_t)(tv.tv_sec - pBuffer->Seconds()) * MICROS_PER_SECOND + tv.tv_usec - (int64_t) pBuffer->MicroSeconds());
+
                 g_AppTime.NewFrame();
                 g_usLastWifiDraw = micros();
                 debugV("Calling LEDBuffer::Draw from wire with %d/%d pixels.", pixelsDrawn, NUM_LEDS);
                 pBuffer->DrawBuffer();
+
+                #if USESTRIP
+                    g_OutputStage.SetChannelSums(iChannel, pBuffer->Sums());
+                #endif
+
                 // In case we drew some pixels and then drew 0 due a failure, we want to return a positive
-                // number of pixels drawn so the caller knows we did in fact render.
-                pixelsDrawn += pBuffer->Length();
+                // number of pixels drawn so the caller knows we did in fact render.  It's the longest of the
+                // channels rather than their total, since it's the count shown on each of them.
+                pixelsDrawn = std::max<uint16_t>(pixelsDrawn, pBuffer->Length());
             }
         }
     }
@@ -206,6 +223,13 @@ uint16_t LocalDraw()
             g_AppTime.NewFrame();       // Start a new frame, record the time, calc deltaTime, etc.
             g_aptrEffectManager->Update(); // Draw the current built in effect
 
+            #if USESTRIP
+                PixelSums sums;
+                for (int i = 0; i < NUM_CHANNELS; i++)
+                    if (g_aptrEffectManager->FrameSums(i, sums))
+                        g_OutputStage.SetChannelSums(i, sums);
+            #endif
+
             #if USE_MATRIX
                 auto spectrum = GetSpectrumAnalyzer(0);
                 if (g_aptrEffectManager->IsVUVisible())
@@ -230,9 +254,12 @@ uint16_t LocalDraw()
 // ShowStrip
 //
 // ShowStrip sends the data to the LED strip.  If its fewer than the size of the strip, we only send that many.
+// Returns the esp_timer_get_time() at which FastLED.show() started, or 0 if nothing was shown.
 
-void ShowStrip(uint16_t numToShow)
+int64_t ShowStrip(uint16_t numToShow)
 {
+    int64_t usShow = 0;
+
     // If we've drawn anything from either source, we can now show it
 
     if (FastLED.count() == 0)
@@ -246,69 +273,99 @@ void ShowStrip(uint16_t numToShow)
         {
             debugV("Telling FastLED that we'll be drawing %d pixels\n", numToShow);
 
+            // Gamma, white balance and the power estimate all happen in the one pass through the output stage; the
+            // brightness it comes back with covers the global brightness, the fader and the power limit
+
+            CRGB * apLEDs[NUM_CHANNELS];
             for (int i = 0; i < NUM_CHANNELS; i++)
-            {
-                LEDStripGFX *pStrip = (LEDStripGFX *)(*g_aptrEffectManager)[i].get();
-                FastLED[i].setLeds(pStrip->leds, numToShow);
-            }
+                apLEDs[i] = (*g_aptrEffectManager)[i]->leds;
 
-            FastLED.show(g_Fader);
+            uint8_t targetBrightness = scale8(g_Brightness, g_Fader);
+            uint8_t brightness = g_OutputStage.Process(apLEDs, numToShow, targetBrightness, POWER_LIMIT_MW);
+
+            #ifdef LED_BUILTIN
+                digitalWrite(LED_BUILTIN, brightness < targetBrightness ? HIGH : LOW);     // Power limit indicator
+            #endif
+
+            for (int i = 0; i < NUM_CHANNELS; i++)
+                FastLED[i].setLeds(g_OutputStage.Output(i, apLEDs[i]), numToShow);
+
+            usShow = esp_timer_get_time();
+            FastLED.show(brightness);
+            g_FrameTimings.Lap(FrameTimings::FastLEDShow, usShow);
 
             g_FPS = FastLED.getFPS();
-            g_Brite = 100.0 * calculate_max_brightness_for_power_mW(g_Brightness, POWER_LIMIT_MW) / 255;
-            g_Watts = calculate_unscaled_power_mW(((LEDStripGFX *)(*g_aptrEffectManager)[0].get())->leds, numToShow) / 1000; // 1000 for mw->W
+            g_Brite = 100.0 * g_OutputStage.LimitBrightness(g_Brightness, POWER_LIMIT_MW) / 255;
+            g_Watts = g_OutputStage.UnscaledMilliwatts() / 1000; // 1000 for mw->W
         }
         else
         {
             debugV("Draw loop ended without a draw.");
         }
     }
+    return usShow;
 }
 
-// DelayUntilNextFrame
+// MicrosUntilNextWiFiFrame
 //
-// Waits patiently until its time to draw the next frame, up to one second max
+// How long until the oldest buffer on any channel comes due, up to 1/20th second so that the caller checks back
+// now and then (to fall back to the local effect, for one).  Zero if one is due now.
 
-void DelayUntilNextFrame(double frameStartTime, uint16_t localPixelsDrawn, uint16_t wifiPixelsDrawn)
+int64_t MicrosUntilNextWiFiFrame()
 {
-    // Delay enough to slow down to the desired framerate
+    const int64_t kMaxWait = 50 * MICROS_PER_MILLI;
 
-#if MILLIS_PER_FRAME == 0
+    timeval tv;
+    gettimeofday(&tv, nullptr);
+    const int64_t usNow = (int64_t) tv.tv_sec * MICROS_PER_SECOND + tv.tv_usec;
 
-    if (localPixelsDrawn > 0)
+    int64_t usWait = kMaxWait;
+    for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
     {
-        const double minimumFrameTime = 1.0 / g_aptrEffectManager->GetCurrentEffect()->DesiredFramesPerSecond();
-        double elapsed = g_AppTime.CurrentTime() - frameStartTime;
-        if (elapsed < minimumFrameTime)
-        {
-            g_FreeDrawTime = std::min(1.0, (minimumFrameTime - elapsed));
-            delay(g_FreeDrawTime * MILLIS_PER_SECOND);
-        }
+        auto pOldest = g_aptrBufferManager[iChannel]->PeekOldestBuffer();
+        if (!pOldest)
+            continue;
+
+        // Without a clock, WiFiDraw draws frames as they come, so anything queued is due now
+
+        if (!NTPTimeClient::HasClockBeenSet())
+            return 0;
+
+        usWait = std::min(usWait, (int64_t)(pOldest->Seconds() * MICROS_PER_SECOND + pOldest->MicroSeconds()) - usNow);
     }
-    else if (wifiPixelsDrawn > 0)
-    {
-        // Sleep up to 1/20th second, depending on how far away the next frame we need to service is
+    return std::max<int64_t>(0, usWait);
+}
 
-        double t = 0.05;
-        for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
-        {
-            auto pOldest = g_aptrBufferManager[iChannel]->PeekOldestBuffer();
-            if (pOldest)
-                t = std::min(t, (pOldest->Seconds() + pOldest->MicroSeconds() / (double) MICROS_PER_SECOND) - g_AppTime.CurrentTime());
-        }
+// DelayUntilNextFrame
+//
+// Waits patiently until its time to draw the next frame.  A local effect's next frame is due one frame at its
+// DesiredFramesPerSecond after the last; otherwise we wait for the next WiFi frame to come due, or for a new one
+// to arrive, since it could be due sooner than anything already queued.
 
-        g_FreeDrawTime = t;
-        if (g_FreeDrawTime > 0.0)
-            delay(g_FreeDrawTime * MILLIS_PER_SECOND);
-        else
-            g_FreeDrawTime = 0.0;
+void DelayUntilNextFrame(uint16_t localPixelsDrawn, uint16_t wifiPixelsDrawn)
+{
+#if MILLIS_PER_FRAME == 0
+
+    const int64_t usNow = esp_timer_get_time();
+
+    if (localPixelsDrawn > 0)
+    {
+        const int64_t usPeriod = MICROS_PER_SECOND / std::max<int64_t>(1, g_aptrEffectManager->GetCurrentEffect()->DesiredFramesPerSecond());
+        const int64_t usDue = g_FrameScheduler.NextLocalFrame(usPeriod);
+
+        g_FreeDrawTime = std::max<int64_t>(0, usDue - usNow) / (double) MICROS_PER_SECOND;
+        g_FrameScheduler.WaitUntil(usDue, false);
     }
     else
     {
-        debugV("Nothing drawn this pass because neither wifi nor local rendered a frame");
-        // Nothing drawn this pass - check back soon
-        g_FreeDrawTime = .001;
-        yield();
+        if (wifiPixelsDrawn == 0)
+            debugV("Nothing drawn this pass because neither wifi nor local rendered a frame");
+
+        const int64_t usWait = MicrosUntilNextWiFiFrame();
+
+        g_FrameScheduler.CancelLocalFrame();
+        g_FreeDrawTime = usWait / (double) MICROS_PER_SECOND;
+        g_FrameScheduler.WaitUntil(usNow + usWait, true);
     }
 
 #endif
@@ -361,15 +418,12 @@ void ShowOnboardPixel()
 #endif
 }
 
-// DrawLoopTaskEntry
+// PrepareDrawLoop
 //
-// Main draw loop entry point
+// Gets the graphics devices and the first effect ready to go.  Called once before the first DrawLoopPass.
 
-void IRAM_ATTR DrawLoopTaskEntry(void *)
+void PrepareDrawLoop()
 {
-
-    debugW(">> DrawLoopTaskEntry\n");
-
     // Initialize our graphics and the first effect
 
     PrepareOnboardPixel();
@@ -387,36 +441,51 @@ void IRAM_ATTR DrawLoopTaskEntry(void *)
     auto spectrum = GetSpectrumAnalyzer(0);
 #endif
     g_aptrEffectManager->StartEffect();
+}
 
-    // Run the draw loop
+// DrawLoopPass
+//
+// One trip through the draw loop: draw from WiFi or the local effect, show it, and wait for the next frame.  Each
+// stage is timed into g_FrameTimings, and everything but the wait counts as the draw task's busy time.
 
-    debugW("Entering main draw loop!");
+void DrawLoopPass()
+{
+    // Loop through each of the channels and see if they have a current frame that needs to be drawn
+
+    uint16_t localPixelsDrawn   = 0;
+    uint16_t wifiPixelsDrawn    = 0;
 
-    for (;;)
     {
-        // Loop through each of the channels and see if they have a current frame that needs to be drawn
+        TaskBusyTimer busy;
 
-        uint16_t localPixelsDrawn   = 0;
-        uint16_t wifiPixelsDrawn    = 0;
-        double frameStartTime       = g_AppTime.CurrentTime();
+        const int64_t usStart = esp_timer_get_time();
+        int64_t us = usStart;
 
         #if USE_MATRIX
             MatrixPreDraw();
+            us = g_FrameTimings.Lap(FrameTimings::MatrixPreDraw, us);
         #endif
 
         if (WiFi.isConnected())
+        {
             wifiPixelsDrawn = WiFiDraw();
+            us = g_FrameTimings.Lap(FrameTimings::WiFiDraw, us);
+        }
 
         // If we didn't draw now, and it's been a while since we did, and we have at least one local effect, then draw the local effect instead
 
         if (wifiPixelsDrawn == 0)
+        {
             localPixelsDrawn = LocalDraw();
+            us = g_FrameTimings.Lap(FrameTimings::LocalDraw, us);
+        }
 
         #if USESTRIP
             if (wifiPixelsDrawn)
                 ShowStrip(wifiPixelsDrawn);
             else if (localPixelsDrawn)
-                ShowStrip(localPixelsDrawn);
+                g_FrameScheduler.RecordLocalPresentation(ShowStrip(localPixelsDrawn));
+            us = g_FrameTimings.Lap(FrameTimings::ShowStrip, us);
         #endif
 
         // If the module has onboard LEDs, we support a couple of different types, and we set it to be the same as whatever
@@ -425,7 +494,41 @@ void IRAM_ATTR DrawLoopTaskEntry(void *)
         ShowOnboardPixel();
         ShowOnboardRGBLED();
 
-        DelayUntilNextFrame(frameStartTime, localPixelsDrawn, wifiPixelsDrawn);
+        g_FrameTimings.EndFrame((uint32_t)(esp_timer_get_time() - usStart), wifiPixelsDrawn || localPixelsDrawn);
+    }
+
+    DelayUntilNextFrame(localPixelsDrawn, wifiPixelsDrawn);
+}
+
+// SplitRenderTaskEntry
+//
+// Split rendering worker entry point; see splitrender.h
+
+void IRAM_ATTR SplitRenderTaskEntry(void *)
+{
+    #if USE_SPLIT_RENDER
+        g_SplitRenderer.RunWorker();
+    #endif
+}
+
+// DrawLoopTaskEntry
+//
+// Main draw loop entry point
+
+void IRAM_ATTR DrawLoopTaskEntry(void *)
+{
+
+    debugW(">> DrawLoopTaskEntry\n");
+
+    PrepareDrawLoop();
+
+    // Run the draw loop
+
+    debugW("Entering main draw loop!");
+
+    for (;;)
+    {
+        DrawLoopPass();
 
         // Once an OTA flash update has started, we don't want to hog the CPU or it goes quite slowly,
         // so we'll pause to share the CPU a bit once the update has begun
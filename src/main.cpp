@@ -232,6 +232,10 @@ extern DRAM_ATTR std::unique_ptr<LEDBufferManager> g_aptrBufferManager[NUM_CHANN
     DRAM_ATTR SocketServer g_SocketServer(49152, NUM_LEDS);  // $C000 is free RAM on the C64, fwiw!
 #endif
 
+#if ENABLE_WIFI && INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+    DRAM_ATTR UDPServer g_UDPServer(INCOMING_UDP_PORT, INCOMING_UDP_MULTICAST_GROUP);
+#endif
+
 #if ENABLE_REMOTE
     DRAM_ATTR RemoteControl g_RemoteControl;
 #endif
@@ -263,6 +267,7 @@ void IRAM_ATTR DebugLoopTaskEntry(void *)
     {
         EVERY_N_MILLIS(50)
         {
+            TaskBusyTimer busy;
             Debug.handle();
         }
         
@@ -308,6 +313,7 @@ void IRAM_ATTR NetworkHandlingLoopEntry(void *)
         #if ENABLE_WIFI
             EVERY_N_SECONDS(1)
             {
+                TaskBusyTimer busy;
                 if (WiFi.isConnected() == false && ConnectToWiFi(5) == false)
                 {
                     debugE("Cannot Connect to Wifi!");
@@ -321,6 +327,7 @@ void IRAM_ATTR NetworkHandlingLoopEntry(void *)
 
             EVERY_N_SECONDS(60)
             {
+                TaskBusyTimer busy;
                 // Get Subscriber Count
 
                 if (WiFi.isConnected())
@@ -355,6 +362,7 @@ void IRAM_ATTR NetworkHandlingLoopEntry(void *)
         #if ENABLE_WIFI && ENABLE_NTP
             EVERY_N_MILLIS(TIME_CHECK_INTERVAL_MS)
             {
+                TaskBusyTimer busy;
                 if (WiFi.isConnected())
                 {
                     debugV("Refreshing Time from Server...");
@@ -390,6 +398,27 @@ void IRAM_ATTR NetworkHandlingLoopEntry(void *)
     }
 #endif
 
+// UDPServerTaskEntry
+//
+// Opens the UDP socket and handles datagrams for as long as WiFi is up
+
+#if ENABLE_WIFI && INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+    void IRAM_ATTR UDPServerTaskEntry(void *)
+    {
+        for (;;)
+        {
+            if (WiFi.isConnected())
+            {
+                g_UDPServer.release();
+                if (g_UDPServer.begin())
+                    g_UDPServer.ProcessIncomingDatagramsLoop();
+                debugW("UDP server stopped.  Retrying...\n");
+            }
+            delay(500);
+        }
+    }
+#endif
+
 
 // CheckHeap
 //
@@ -467,6 +496,7 @@ Bounce2::Button Button2;
 // RemoteLoop                   - Handles the remote control loop
 // NetworkHandlingLoopEntry     - Connects to WiFi, handles reconnects, OTA updates, web server
 // SocketServerTaskEntry        - Creates the socket and listens for incoming wifi color data
+// UDPServerTaskEntry           - Same, but for color data sent as UDP datagrams
 // AudioSamplerTaskEntry        - Listens to room audio, creates spectrum analysis, beat detection, etc.
 
 void setup()
@@ -651,8 +681,11 @@ void setup()
         uint32_t memtouse = ESP.getFreeHeap() - RESERVE_MEMORY;
     #endif
 
+    memtouse -= std::min(memtouse, EffectManager<GFXBase>::CrossFadeBufferBytes);    // InitEffectsManager allocates these later
+
     uint32_t memtoalloc = (NUM_CHANNELS * ((sizeof(LEDBuffer) + NUM_LEDS * sizeof(CRGB))));
     uint32_t cBuffers = memtouse / memtoalloc;
+    cBuffers -= std::min(cBuffers, LEDBufferManager::SpareBuffers);      // The manager keeps a few more than it queues
 
     if (cBuffers < MIN_BUFFERS)
     {
@@ -740,11 +773,11 @@ void setup()
             FastLED.addLeds<WS2812B, LED_PIN0, COLOR_ORDER>(g_aptrDevices[7].get()->leds,g_aptrDevices[7].get()->GetLEDCount());
         #endif
            
-        #ifdef POWER_LIMIT_MW
-            set_max_power_in_milliwatts(POWER_LIMIT_MW);                // Set brightness limit
-            #ifdef LED_BUILTIN
-                set_max_power_indicator_LED(LED_BUILTIN);
-            #endif
+        // POWER_LIMIT_MW is applied by the output stage in ShowStrip, so FastLED isn't given a power limit of its
+        // own; with one, every show() would walk all the LEDs again to work out the same thing
+
+        #ifdef LED_BUILTIN
+            pinMode(LED_BUILTIN, OUTPUT);                               // Lit while the power limit is holding us back
         #endif
 
             g_Brightness = 255;
@@ -776,6 +809,7 @@ void setup()
     debugI("Launching Drawing:");
     debugE("Heap before launch: %s", heap_caps_check_integrity_all(true) ? "PASS" : "FAIL");
     g_TaskManager.StartDrawThread();
+    g_TaskManager.StartRenderThread();
     CheckHeap();
 
 #if ENABLE_WIFI && WAIT_FOR_WIFI
@@ -807,6 +841,10 @@ void setup()
     g_TaskManager.StartSocketThread();
 #endif
 
+#if ENABLE_WIFI && INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+    g_TaskManager.StartUDPThread();
+#endif
+
 #if ENABLE_AUDIO
     // The audio sampler task might as well be on a different core from the LED stuff
     g_TaskManager.StartAudioThread();
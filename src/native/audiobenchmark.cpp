@@ -0,0 +1,363 @@
+//+--------------------------------------------------------------------------
+//
+// File:        audiobenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Plays audio to the real SoundAnalyzer, g_Analyzer, in place of the
+//    microphone, and runs whole sampler passes over it just as the
+//    sampler task does: RunSamplerPass with its FFT and ProcessPeaks,
+//    the PeakData min and max tracking, DecayPeaks and the rest.
+//
+//    The clock is frozen and stepped by the length of audio each pass
+//    takes in, so a replay gives the same numbers every time, and
+//    --audioreplay writes them out a pass to a line as CSV.
+//
+//    --audiobench times passes over a few test signals.  NUM_BANDS and
+//    AUDIO_MAX_SAMPLES are fixed when the analyzer is compiled, so each
+//    build reports on its own configuration, which goes in the report
+//    so that runs of differently configured builds can be lined up.
+//    First, though, it feeds fixed bin magnitudes through the analyzer's
+//    bin to band table and through the search for each bin's band that
+//    the table replaced, and fails if any band comes out different.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include "globals.h"
+#include "effectbenchmark.h"
+#include "fileaudiosource.h"
+
+#if ENABLE_AUDIO
+
+static const int64_t kStartTime = 10 * MICROS_PER_SECOND;  // Past AUDIO_PEAK_REMOTE_TIMEOUT, so the analyzer listens
+
+// MicrosPerPass
+//
+// How much audio each sampler pass takes in
+
+static int64_t MicrosPerPass()
+{
+    return (int64_t) g_Analyzer.SamplesPerPass() * MICROS_PER_SECOND / g_Analyzer.SamplingFrequency();
+}
+
+// RunAudioReplay
+//
+// See effectbenchmark.h
+
+int RunAudioReplay(const char * pszAudioFile, size_t cPasses, const char * pszCsvFile)
+{
+    const double sampleRate = g_Analyzer.SamplingFrequency();
+
+    FileAudioSource file;
+    ToneAudioSource tones(sampleRate);
+    AudioSource * pSource = &tones;
+
+    if (pszAudioFile)
+    {
+        if (!file.Open(pszAudioFile, sampleRate))
+            return -1;
+        pSource = &file;
+        if (cPasses == 0)
+            cPasses = file.Remaining() / g_Analyzer.SamplesPerPass();
+    }
+    else
+    {
+        tones.AddTone(110.0, 0.3).AddTone(880.0, 0.15).AddTone(3520.0, 0.05).SetNoise(0.05).SetPulse(120.0);
+        if (cPasses == 0)
+            cPasses = 600;
+    }
+
+    FILE * pFile = pszCsvFile ? fopen(pszCsvFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszCsvFile);
+        return -1;
+    }
+
+    fprintf(pFile, "pass,ms,vu,vu_ratio,min_vu,peak_vu,bpm,beat_phase");
+    for (int i = 0; i < NUM_BANDS; i++)
+        fprintf(pFile, ",band%d", i);
+    fprintf(pFile, "\n");
+
+    NativeClockFreeze(kStartTime);
+    g_Analyzer.SetAudioSource(pSource);
+
+    size_t iPass = 0;
+    for (; iPass < cPasses; iPass++)
+    {
+        // Stop short of a pass that would run off the end of a recording rather than analyze a partial buffer
+
+        if (pSource == &file && file.Remaining() < g_Analyzer.SamplesPerPass())
+            break;
+
+        NativeClockAdvance(MicrosPerPass());
+        g_Analyzer.SamplerPass();
+
+        const AudioFrame frame = g_Analyzer.GetAudioFrame();
+        fprintf(pFile, "%zu,%u,%.3f,%.4f,%.3f,%.3f,%.1f,%.3f", iPass, millis(), frame.vu, frame.vuRatio,
+                frame.minVU, frame.peakVU, frame.bpm, frame.beatPhase);
+        for (int i = 0; i < NUM_BANDS; i++)
+            fprintf(pFile, ",%.4f", frame.peaks[i]);
+        fprintf(pFile, "\n");
+    }
+
+    g_Analyzer.SetAudioSource(nullptr);
+    NativeClockRelease();
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    debugI("Replayed %zu passes of %s", iPass, pszAudioFile ? pszAudioFile : "test tones");
+    return 0;
+}
+
+// AddBinsToBandsBySearch
+//
+// How ProcessPeaks found the bands before BuildBinBandTable: by searching the cutoffs for each bin on every pass
+
+static void AddBinsToBandsBySearch(const std::vector<float> & bins, float * pPeaks)
+{
+    for (int i = 2; i < (int) g_Analyzer.BinCount(); i++)
+    {
+        int freq = g_Analyzer.BinFrequency(i);
+        int iBand = 0;
+        while (iBand < NUM_BANDS - 1)
+        {
+            if (freq < g_Analyzer.BandCutoff(iBand))
+                break;
+            iBand++;
+        }
+
+        if (bins[i] > NOISE_CUTOFF && bins[i] > pPeaks[iBand])
+            pPeaks[iBand] += bins[i];
+    }
+}
+
+// CheckBandTable
+//
+// Runs a few fixed sets of bin magnitudes through g_Analyzer's AddBinsToBands and the search above, and returns
+// how many of them came out with any band different
+
+static int CheckBandTable()
+{
+    const size_t cBins = g_Analyzer.BinCount();
+
+    struct BinSet
+    {
+        const char *       name;
+        std::vector<float> bins;
+    };
+
+    std::vector<BinSet> sets = { { "ramp" }, { "comb" }, { "edges" }, { "random" } };
+    for (auto & set : sets)
+        set.bins.assign(cBins, 0.0f);
+
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < cBins; i++)
+    {
+        sets[0].bins[i] = i * 8.0f;
+        sets[1].bins[i] = i % 5 ? 0.0f : 1000.0f - i;
+
+        // Loud bins either side of every place the band changes, which is where the table would go wrong
+
+        for (int iBand = 0; iBand < NUM_BANDS - 1; iBand++)
+            if (i + 1 < cBins && g_Analyzer.BinFrequency(i) < g_Analyzer.BandCutoff(iBand)
+                              && g_Analyzer.BinFrequency(i + 1) >= g_Analyzer.BandCutoff(iBand))
+                sets[2].bins[i] = sets[2].bins[i + 1] = 500.0f + i;
+
+        seed = seed * 1664525 + 1013904223;
+        sets[3].bins[i] = (seed >> 8) % 4096;
+    }
+
+    int cMismatched = 0;
+    for (const auto & set : sets)
+    {
+        float tablePeaks[NUM_BANDS] = { 0 };
+        float searchPeaks[NUM_BANDS] = { 0 };
+        g_Analyzer.AddBinsToBands(set.bins.data(), tablePeaks);
+        AddBinsToBandsBySearch(set.bins, searchPeaks);
+
+        int cBands = 0;
+        for (int iBand = 0; iBand < NUM_BANDS; iBand++)
+            if (tablePeaks[iBand] != searchPeaks[iBand])
+                cBands++;
+
+        if (cBands)
+            cMismatched++;
+
+        debugI("bands %-8s %2d of %d differ  %s", set.name, cBands, NUM_BANDS, cBands ? "MISMATCH" : "ok");
+    }
+    return cMismatched;
+}
+
+// LoopAudioSource
+//
+// Plays a buffer of samples over and over, so the benchmark times the analyzer and not the making of its input
+
+class LoopAudioSource : public AudioSource
+{
+    const std::vector<int16_t> & _samples;
+    size_t                       _iNext = 0;
+
+  public:
+
+    explicit LoopAudioSource(const std::vector<int16_t> & samples)
+        : _samples(samples)
+    {
+    }
+
+    size_t Read(int16_t * pSamples, size_t cSamples) override
+    {
+        for (size_t i = 0; i < cSamples; i++)
+        {
+            pSamples[i] = _samples[_iNext];
+            _iNext = (_iNext + 1) % _samples.size();
+        }
+        return cSamples;
+    }
+};
+
+struct AudioResult
+{
+    const char * name;
+    double       microsPerPass;
+    double       passesPerSecond;
+    double       realTimeFactor;                        // How many times faster than the audio comes in
+};
+
+// RunAudioBenchmark
+//
+// See effectbenchmark.h
+
+int RunAudioBenchmark(size_t cPasses, const char * pszJsonFile)
+{
+    if (cPasses == 0)
+        cPasses = 1;
+
+    const double sampleRate = g_Analyzer.SamplingFrequency();
+
+    struct Signal
+    {
+        const char *                               name;
+        std::function<void(ToneAudioSource &)>     setup;
+    };
+
+    const std::vector<Signal> signals =
+    {
+        { "silence", [](ToneAudioSource &)   { } },
+        { "tone",    [](ToneAudioSource & s) { s.AddTone(440.0, 0.8); } },
+        { "chord",   [](ToneAudioSource & s) { s.AddTone(110.0, 0.3).AddTone(277.2, 0.3).AddTone(1661.2, 0.3); } },
+        { "noise",   [](ToneAudioSource & s) { s.SetNoise(0.5); } },
+        { "pulse",   [](ToneAudioSource & s) { s.AddTone(110.0, 0.4).AddTone(3520.0, 0.1).SetNoise(0.1).SetPulse(128.0); } },
+    };
+
+    const int cBandMismatches = CheckBandTable();
+
+    std::vector<AudioResult> results;
+    int cSlow = 0;
+
+    NativeClockFreeze(kStartTime);
+
+    for (const auto & signal : signals)
+    {
+        // Two seconds of the signal, enough for a few beats of the pulse
+
+        ToneAudioSource tones(sampleRate);
+        signal.setup(tones);
+        std::vector<int16_t> samples((size_t)(2 * sampleRate));
+        tones.Read(samples.data(), samples.size());
+
+        LoopAudioSource source(samples);
+        g_Analyzer.SetAudioSource(&source);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < cPasses; i++)
+        {
+            NativeClockAdvance(MicrosPerPass());
+            g_Analyzer.SamplerPass();
+        }
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        AudioResult result;
+        result.name            = signal.name;
+        result.microsPerPass   = micros / cPasses;
+        result.passesPerSecond = MICROS_PER_SECOND / result.microsPerPass;
+        result.realTimeFactor  = MicrosPerPass() / result.microsPerPass;
+        results.push_back(result);
+
+        if (result.realTimeFactor < 1.0)
+            cSlow++;
+
+        debugI("%-8s %8.2lfus/pass  %9.0lf passes/s  %7.1lfx real time  %s", result.name, result.microsPerPass,
+               result.passesPerSecond, result.realTimeFactor, result.realTimeFactor < 1.0 ? "SLOW" : "ok");
+    }
+
+    g_Analyzer.SetAudioSource(nullptr);
+    NativeClockRelease();
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"num_bands\": %d,\n  \"max_samples\": %zu,\n  \"samples_per_pass\": %zu,\n  \"sample_rate\": %.0lf,\n"
+                   "  \"streaming\": %s,\n  \"arduinofft\": %s,\n  \"passes\": %zu,\n  \"signals\": [\n",
+            NUM_BANDS, (size_t) AUDIO_MAX_SAMPLES, g_Analyzer.SamplesPerPass(), sampleRate,
+            AUDIO_STREAMING_CAPTURE ? "true" : "false", USE_ARDUINOFFT ? "true" : "false", cPasses);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const AudioResult & r = results[i];
+        fprintf(pFile, "    { \"name\": ");
+        WriteJsonString(pFile, r.name);
+        fprintf(pFile, ", \"us_per_pass\": %.3lf, \"passes_per_second\": %.1lf, \"real_time_factor\": %.2lf }%s\n",
+                r.microsPerPass, r.passesPerSecond, r.realTimeFactor, i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"slow\": %d,\n  \"band_mismatches\": %d\n}\n", cSlow, cBandMismatches);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cSlow + cBandMismatches;
+}
+
+#else
+
+int RunAudioReplay(const char *, size_t, const char *)
+{
+    debugE("This project is built without ENABLE_AUDIO, so there's no sound analyzer to replay audio to");
+    return -1;
+}
+
+int RunAudioBenchmark(size_t, const char *)
+{
+    debugE("This project is built without ENABLE_AUDIO, so there's no sound analyzer to benchmark");
+    return -1;
+}
+
+#endif
@@ -0,0 +1,188 @@
+//+--------------------------------------------------------------------------
+//
+// File:        boidbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Times a frame of flocking for flocks of 20 to 500 boids on a
+//    Mesmerizer sized (64x32) field, first the original way, with
+//    separate(), align() and cohesion() each scanning the whole flock,
+//    and then with Boid::flockAll and its BoidGrid.
+//
+//    Both run from the same starting flock.  On the first frame, before
+//    float rounding has had a chance to steer them apart, the forces they
+//    come up with are compared, and the run fails if they differ.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include "globals.h"
+#include "effectbenchmark.h"
+#include "effects/matrix/Boid.h"
+
+static const int    kFieldWidth  = 64;
+static const int    kFieldHeight = 32;
+static const size_t kFlockSizes[] = { 20, 50, 100, 200, 300, 500 };
+static const float  kMaxForceError = 1e-4f;
+
+struct BoidResult
+{
+    size_t boids;
+    double scanMicros;
+    double gridMicros;
+    float  forceError;
+};
+
+// MakeFlock
+//
+// The same random flock every time for a given size
+
+static std::vector<Boid> MakeFlock(size_t cBoids)
+{
+    randomSeed(1337 + cBoids);
+
+    std::vector<Boid> flock;
+    for (size_t i = 0; i < cBoids; i++)
+        flock.emplace_back(random(kFieldWidth), random(kFieldHeight));
+    return flock;
+}
+
+// Flock by scanning the whole flock once per rule, which is what Boid::flock used to do
+
+static void ScanFlock(std::vector<Boid> & flock)
+{
+    for (auto & boid : flock)
+    {
+        PVector sep = boid.separate(flock.data(), flock.size());
+        PVector ali = boid.align(flock.data(), flock.size());
+        PVector coh = boid.cohesion(flock.data(), flock.size());
+        sep *= 1.5;
+        boid.applyForce(sep);
+        boid.applyForce(ali);
+        boid.applyForce(coh);
+    }
+}
+
+static void GridFlock(std::vector<Boid> & flock, BoidGrid & grid)
+{
+    Boid::flockAll(flock.data(), flock.size(), grid);
+}
+
+// Move every boid and wrap it around the field
+
+static void MoveFlock(std::vector<Boid> & flock)
+{
+    for (auto & boid : flock)
+    {
+        boid.update();
+        if (boid.location.x < 0)             boid.location.x += kFieldWidth;
+        if (boid.location.x >= kFieldWidth)  boid.location.x -= kFieldWidth;
+        if (boid.location.y < 0)             boid.location.y += kFieldHeight;
+        if (boid.location.y >= kFieldHeight) boid.location.y -= kFieldHeight;
+    }
+}
+
+// BenchmarkFlock
+//
+// Runs cFrames frames of a flock of cBoids both ways
+
+static BoidResult BenchmarkFlock(size_t cBoids, size_t cFrames)
+{
+    BoidResult result = { cBoids, 0.0, 0.0, 0.0f };
+
+    std::vector<Boid> scanned = MakeFlock(cBoids);
+    std::vector<Boid> gridded = MakeFlock(cBoids);
+    BoidGrid grid(gridded[0].desiredseparation, kFieldWidth, kFieldHeight);
+
+    ScanFlock(scanned);
+    GridFlock(gridded, grid);
+    for (size_t i = 0; i < cBoids; i++)
+    {
+        PVector error = scanned[i].acceleration - gridded[i].acceleration;
+        result.forceError = std::max(result.forceError, error.mag());
+    }
+    MoveFlock(scanned);
+    MoveFlock(gridded);
+
+    auto TimeMicros = [cFrames](const std::function<void()> & frame)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < cFrames; i++)
+            frame();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / cFrames;
+    };
+
+    result.scanMicros = TimeMicros([&]() { ScanFlock(scanned); MoveFlock(scanned); });
+    result.gridMicros = TimeMicros([&]() { GridFlock(gridded, grid); MoveFlock(gridded); });
+    return result;
+}
+
+// RunBoidBenchmark
+//
+// See effectbenchmark.h
+
+int RunBoidBenchmark(size_t cFrames, const char * pszJsonFile)
+{
+    if (cFrames == 0)
+        cFrames = 1;
+
+    std::vector<BoidResult> results;
+    int cFailed = 0;
+
+    for (size_t cBoids : kFlockSizes)
+    {
+        results.push_back(BenchmarkFlock(cBoids, cFrames));
+        const BoidResult & r = results.back();
+        bool bFailed = r.forceError > kMaxForceError;
+        if (bFailed)
+            cFailed++;
+
+        debugI("%3zu boids  scan %9.2lfus  grid %8.2lfus  (%5.1lfx)  force error %.2e  %s",
+               r.boids, r.scanMicros, r.gridMicros, r.scanMicros / r.gridMicros, r.forceError, bFailed ? "MISMATCH" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %zu,\n  \"flocks\": [\n", kFieldWidth, kFieldHeight, cFrames);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BoidResult & r = results[i];
+        fprintf(pFile, "    { \"boids\": %zu, \"scan_us\": %.3lf, \"grid_us\": %.3lf, \"speedup\": %.2lf, \"force_error\": %.3e }%s\n",
+                r.boids, r.scanMicros, r.gridMicros, r.scanMicros / r.gridMicros, r.forceError,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"mismatched\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
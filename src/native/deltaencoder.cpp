@@ -0,0 +1,151 @@
+//+--------------------------------------------------------------------------
+//
+// File:        deltaencoder.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Greedy span encoder for WIFI_COMMAND_PIXELDELTA64; see deltaencoder.h
+//    and LEDBuffer::UpdateFromDelta for the format.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <string.h>
+#include "deltaencoder.h"
+
+static const uint16_t kCommandPixelDelta64 = 5;
+
+enum : uint8_t
+{
+    OpSkip    = 0,
+    OpLiteral = 1,
+    OpRun     = 2
+};
+
+static const size_t kMaxInlineCount = 0x3F;
+static const size_t kMaxCount       = 0xFFFF;
+static const size_t kMinRun         = 3;        // A run of two costs the same as two literal pixels, so don't bother
+
+static void PutLE(std::vector<uint8_t> & out, uint64_t value, size_t cb)
+{
+    for (size_t i = 0; i < cb; i++)
+        out.push_back((uint8_t)(value >> (8 * i)));
+}
+
+static void PutTag(std::vector<uint8_t> & out, uint8_t op, size_t count)
+{
+    if (count <= kMaxInlineCount)
+    {
+        out.push_back((uint8_t)(op << 6 | count));
+    }
+    else
+    {
+        out.push_back((uint8_t)(op << 6));
+        PutLE(out, count, 2);
+    }
+}
+
+// PixelsEqual
+//
+// Compares pixel i of the frame with pixel i of the reference, which is black past its end
+
+static inline bool PixelsEqual(const uint8_t * pFrame, const uint8_t * pPrevious, size_t cPrevious, size_t i)
+{
+    static const uint8_t black[3] = { 0, 0, 0 };
+    const uint8_t * pRef = i < cPrevious ? &pPrevious[i * 3] : black;
+    return !memcmp(&pFrame[i * 3], pRef, 3);
+}
+
+size_t EncodeDeltaFrame(std::vector<uint8_t> & packet,
+                        const uint8_t * pFrame, size_t cPixels,
+                        const uint8_t * pPrevious, size_t cPrevious,
+                        uint16_t channel16, uint64_t seconds, uint64_t micros,
+                        uint64_t baseSeconds, uint64_t baseMicros)
+{
+    size_t iStart = packet.size();
+
+    PutLE(packet, kCommandPixelDelta64, 2);
+    PutLE(packet, channel16, 2);
+    size_t iLength = packet.size();
+    PutLE(packet, 0, 4);                                    // Span byte count, filled in at the end
+    PutLE(packet, seconds, 8);
+    PutLE(packet, micros, 8);
+    PutLE(packet, baseSeconds, 8);
+    PutLE(packet, baseMicros, 8);
+
+    size_t iSpans = packet.size();
+    size_t i = 0;
+
+    auto SkipLength = [&](size_t at)
+    {
+        size_t n = 0;
+        while (at + n < cPixels && n < kMaxCount && PixelsEqual(pFrame, pPrevious, cPrevious, at + n))
+            n++;
+        return n;
+    };
+
+    auto RunLength = [&](size_t at)
+    {
+        size_t n = 1;
+        while (at + n < cPixels && n < kMaxCount && !memcmp(&pFrame[(at + n) * 3], &pFrame[at * 3], 3))
+            n++;
+        return n;
+    };
+
+    while (i < cPixels)
+    {
+        size_t cSkip = SkipLength(i);
+        size_t cRun  = RunLength(i);
+
+        if (cSkip > 0 && cSkip >= cRun)
+        {
+            PutTag(packet, OpSkip, cSkip);
+            i += cSkip;
+        }
+        else if (cRun >= kMinRun)
+        {
+            PutTag(packet, OpRun, cRun);
+            packet.insert(packet.end(), &pFrame[i * 3], &pFrame[i * 3 + 3]);
+            i += cRun;
+        }
+        else
+        {
+            // Literal until something cheaper starts
+
+            size_t cLiteral = 1;
+            while (i + cLiteral < cPixels && cLiteral < kMaxCount
+                   && !PixelsEqual(pFrame, pPrevious, cPrevious, i + cLiteral)
+                   && RunLength(i + cLiteral) < kMinRun)
+                cLiteral++;
+
+            PutTag(packet, OpLiteral, cLiteral);
+            packet.insert(packet.end(), &pFrame[i * 3], &pFrame[(i + cLiteral) * 3]);
+            i += cLiteral;
+        }
+    }
+
+    uint32_t cbSpans = packet.size() - iSpans;
+    for (size_t b = 0; b < 4; b++)
+        packet[iLength + b] = (uint8_t)(cbSpans >> (8 * b));
+
+    return packet.size() - iStart;
+}
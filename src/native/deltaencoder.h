@@ -0,0 +1,57 @@
+//+--------------------------------------------------------------------------
+//
+// File:        deltaencoder.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Reference encoder for WIFI_COMMAND_PIXELDELTA64 packets, the sending
+//    side of LEDBuffer::UpdateFromDelta.  Plain C++ with no dependencies
+//    on the rest of the tree so a server can lift it as is.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// EncodeDeltaFrame
+//
+// Appends a complete PIXELDELTA64 packet (40 byte header plus spans) to packet, encoding pFrame against
+// pPrevious, the last frame sent on the same channel, whose timestamp was baseSeconds.baseMicros.  cPrevious
+// may be smaller than cPixels, in which case the missing reference pixels count as black.  Both arrays are
+// packed RGB.
+//
+// Returns the size of the packet.  If that's bigger than the raw PIXELDATA64 packet would be, the caller
+// should just send the raw one instead.
+//
+// The receiver refuses a delta unless its base is the last frame it queued on that channel, and says so in
+// the keyframeMask of its SocketResponse.  The first frame, and the next one after any refusal, has to be
+// sent raw.
+
+size_t EncodeDeltaFrame(std::vector<uint8_t> & packet,
+                        const uint8_t * pFrame, size_t cPixels,
+                        const uint8_t * pPrevious, size_t cPrevious,
+                        uint16_t channel16, uint64_t seconds, uint64_t micros,
+                        uint64_t baseSeconds, uint64_t baseMicros);
@@ -0,0 +1,310 @@
+//+--------------------------------------------------------------------------
+//
+// File:        effectbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Per-effect frame time benchmark; see effectbenchmark.h.
+//
+//    Each effect gets the same treatment: the clock is frozen at the same
+//    starting point, every RNG the effects use (FastLED's random8/16,
+//    Arduino random(), and rand()) is reseeded, the effect is started,
+//    and then for each frame the clock is stepped by exactly one frame at
+//    the effect's DesiredFramesPerSecond() before Draw() is timed against
+//    the real steady clock.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include "globals.h"
+#include "effectbenchmark.h"
+
+extern DRAM_ATTR std::unique_ptr<EffectManager<GFXBase>> g_aptrEffectManager;
+
+static const uint16_t kRandomSeed       = 1337;
+static const int64_t  kStartTime        = 10 * MICROS_PER_SECOND;     // Arbitrary, but not zero so "time since" math is sane
+static const size_t   kWarmupFrames     = 16;
+
+// Allocation counting
+//
+// Replacing the global operator new is the one hook that sees every container, make_unique and
+// new[] an effect does without touching the effects themselves
+
+static std::atomic<size_t> s_cbAllocated(0);
+static std::atomic<size_t> s_cAllocations(0);
+
+void * operator new(size_t cb)
+{
+    s_cbAllocated += cb;
+    s_cAllocations++;
+
+    void * p = malloc(cb ? cb : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void * operator new[](size_t cb)
+{
+    return operator new(cb);
+}
+
+void operator delete(void * p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void * p, size_t) noexcept
+{
+    free(p);
+}
+
+size_t NativeBytesAllocated()
+{
+    return s_cbAllocated;
+}
+
+size_t NativeAllocationCount()
+{
+    return s_cAllocations;
+}
+
+// EffectResult
+//
+// What we measured for one effect
+
+struct EffectResult
+{
+    size_t  index;
+    String  name;
+    size_t  fps;
+    double  budgetMicros;
+    double  meanMicros;
+    double  p99Micros;
+    double  maxMicros;
+    double  bytesPerFrame;
+    double  allocsPerFrame;
+    size_t  steadyAllocs;
+    bool    overBudget;
+};
+
+// WriteJsonString
+//
+// See effectbenchmark.h
+
+void WriteJsonString(FILE * pFile, const char * psz)
+{
+    fputc('"', pFile);
+    for (; *psz; psz++)
+    {
+        if (*psz == '"' || *psz == '\\')
+            fprintf(pFile, "\\%c", *psz);
+        else if ((unsigned char) *psz < 0x20)
+            fprintf(pFile, "\\u%04x", *psz);
+        else
+            fputc(*psz, pFile);
+    }
+    fputc('"', pFile);
+}
+
+// StartRepeatableEffect
+//
+// See effectbenchmark.h
+
+LEDStripEffect * StartRepeatableEffect(size_t iEffect)
+{
+    NativeClockFreeze(kStartTime);
+    random16_set_seed(kRandomSeed);
+    randomSeed(kRandomSeed);
+
+    for (int i = 0; i < NUM_CHANNELS; i++)
+        (*g_aptrEffectManager)[i]->Clear();
+
+    g_aptrEffectManager->SetCurrentEffectIndex(iEffect);
+    LEDStripEffect * pEffect = g_aptrEffectManager->GetCurrentEffect();
+
+    for (size_t i = 0; i < kWarmupFrames; i++)
+        DrawRepeatableFrame(pEffect);
+
+    return pEffect;
+}
+
+// NewFrame
+//
+// What EffectManager::Update does between frames before the effect draws: advance the frame clock and take
+// back the frame scratch
+
+static void NewFrame()
+{
+    g_AppTime.NewFrame();
+    for (int i = 0; i < NUM_CHANNELS; i++)
+        g_aptrDevices[i]->Scratch().Reset();
+}
+
+// DrawRepeatableFrame
+//
+// See effectbenchmark.h
+
+void DrawRepeatableFrame(LEDStripEffect * pEffect)
+{
+    NativeClockAdvance(MICROS_PER_SECOND / std::max<size_t>(1, pEffect->DesiredFramesPerSecond()));
+    NewFrame();
+    pEffect->Draw();
+}
+
+// BenchmarkEffect
+//
+// Runs one effect from a clean, repeatable start and measures its Draw()
+
+static EffectResult BenchmarkEffect(size_t iEffect, size_t cFrames)
+{
+    LEDStripEffect * pEffect = StartRepeatableEffect(iEffect);
+
+    EffectResult result;
+    result.index        = iEffect;
+    result.name         = pEffect->FriendlyName();
+    result.fps          = std::max<size_t>(1, pEffect->DesiredFramesPerSecond());
+    result.budgetMicros = MICROS_PER_SECOND / (double) result.fps;
+
+    const int64_t usPerFrame = MICROS_PER_SECOND / result.fps;
+
+    std::vector<double> samples;
+    samples.reserve(cFrames);
+
+    size_t cbStart      = NativeBytesAllocated();
+    size_t cAllocStart  = NativeAllocationCount();
+    size_t cAllocSteady = cAllocStart;
+    double total        = 0.0;
+
+    for (size_t i = 0; i < cFrames; i++)
+    {
+        // Pools and caches that size themselves to what the effect needs should be done growing by the
+        // second half of the run, so anything allocated after that is per-frame heap traffic
+
+        if (i == cFrames / 2)
+            cAllocSteady = NativeAllocationCount();
+
+        NativeClockAdvance(usPerFrame);
+        NewFrame();
+
+        auto start = std::chrono::steady_clock::now();
+        pEffect->Draw();
+        auto end = std::chrono::steady_clock::now();
+
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        samples.push_back(us);
+        total += us;
+    }
+
+    // The samples vector was reserved up front, so nothing we did in the loop is in these totals
+
+    size_t cbUsed     = NativeBytesAllocated() - cbStart;
+    size_t cAllocUsed = NativeAllocationCount() - cAllocStart;
+
+    std::sort(samples.begin(), samples.end());
+    size_t iP99 = std::min(samples.size() - 1, (size_t) ceil(samples.size() * 0.99) - 1);
+
+    result.meanMicros     = total / cFrames;
+    result.p99Micros      = samples[iP99];
+    result.maxMicros      = samples.back();
+    result.bytesPerFrame  = cbUsed / (double) cFrames;
+    result.allocsPerFrame = cAllocUsed / (double) cFrames;
+    result.steadyAllocs   = NativeAllocationCount() - cAllocSteady;
+    result.overBudget     = result.meanMicros > result.budgetMicros;
+
+    NativeClockRelease();
+    return result;
+}
+
+// RunEffectBenchmark
+//
+// See effectbenchmark.h
+
+int RunEffectBenchmark(size_t cFrames, const char * pszJsonFile)
+{
+    if (cFrames == 0)
+        cFrames = 1;
+
+    std::vector<EffectResult> results;
+    int cOverBudget = 0;
+    int cAllocating = 0;
+
+    for (size_t i = 0; i < g_aptrEffectManager->EffectCount(); i++)
+    {
+        results.push_back(BenchmarkEffect(i, cFrames));
+        const EffectResult & r = results.back();
+
+        debugI("%3zu %-32s mean %9.2lfus  p99 %9.2lfus  budget %9.2lfus  %8.1lf B/frame  %s%s",
+               r.index, r.name.c_str(), r.meanMicros, r.p99Micros, r.budgetMicros, r.bytesPerFrame, r.overBudget ? "OVER" : "ok",
+               r.steadyAllocs ? "  HEAP" : "");
+
+        if (r.overBudget)
+            cOverBudget++;
+        if (r.steadyAllocs)
+            cAllocating++;
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"project\": ");
+    WriteJsonString(pFile, PROJECT_NAME);
+    fprintf(pFile, ",\n  \"channels\": %d,\n  \"leds\": %d,\n  \"frames\": %zu,\n  \"seed\": %u,\n  \"effects\": [\n",
+            NUM_CHANNELS, NUM_LEDS, cFrames, kRandomSeed);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const EffectResult & r = results[i];
+        fprintf(pFile, "    { \"index\": %zu, \"name\": ", r.index);
+        WriteJsonString(pFile, r.name.c_str());
+        fprintf(pFile, ", \"fps\": %zu, \"budget_us\": %.2lf, \"mean_us\": %.2lf, \"p99_us\": %.2lf, \"max_us\": %.2lf, "
+                       "\"bytes_per_frame\": %.1lf, \"allocs_per_frame\": %.3lf, \"steady_allocs\": %zu, \"over_budget\": %s }%s\n",
+                r.fps, r.budgetMicros, r.meanMicros, r.p99Micros, r.maxMicros,
+                r.bytesPerFrame, r.allocsPerFrame, r.steadyAllocs, r.overBudget ? "true" : "false",
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"over_budget\": %d,\n  \"allocating\": %d\n}\n", cOverBudget, cAllocating);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cOverBudget;
+}
@@ -0,0 +1,152 @@
+//+--------------------------------------------------------------------------
+//
+// File:        effectbenchmark.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Per-effect frame time benchmark for the native build.  Runs Draw()
+//    on every effect in the project's table against a frozen, manually
+//    stepped clock and a fixed RNG seed, and reports the cost per frame
+//    as JSON so runs can be diffed from one commit to the next.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <utility>
+#include <vector>
+
+// Allocation counters
+//
+// Global operator new is replaced in the native build so the benchmark can charge heap traffic
+// to the effect that caused it.  Totals are since process start; take deltas.
+
+size_t NativeBytesAllocated();
+size_t NativeAllocationCount();
+
+// StartRepeatableEffect, DrawRepeatableFrame
+//
+// Make an effect's output the same on every run: StartRepeatableEffect freezes the clock, reseeds the RNGs,
+// clears the channels, starts the effect and draws a few warm-up frames.  Each DrawRepeatableFrame then steps
+// the clock by one frame at the effect's own rate and draws.  Call NativeClockRelease() when finished.
+
+class LEDStripEffect;
+
+LEDStripEffect * StartRepeatableEffect(size_t iEffect);
+void DrawRepeatableFrame(LEDStripEffect * pEffect);
+
+// RunEffectBenchmark
+//
+// Benchmarks every effect for cFrames frames each and writes the JSON report to pszJsonFile
+// (or stdout if null).  Returns the number of effects whose mean frame time blew their
+// DesiredFramesPerSecond() budget, so zero means pass.  Effects that still allocate in the
+// second half of the run are listed with steady_allocs and counted in "allocating", but
+// don't fail it.
+
+int RunEffectBenchmark(size_t cFrames, const char * pszJsonFile);
+
+// RunSPSCBenchmark
+//
+// Runs cFrames numbered frames through LEDBufferManagers of a few depths, producing on one thread and drawing on
+// another, and checks each frame drawn for pixels from some other frame, for frames out of order, and for frames
+// other than the one the drawing side peeked at just before.  Returns the number of depths where any of those
+// turned up, so zero means pass.  Lives in spscbenchmark.cpp.
+
+int RunSPSCBenchmark(size_t cFrames, const char * pszJsonFile);
+
+// RunWireBenchmark
+//
+// Renders cFrames frames of every effect and sends each one raw, zlib compressed and as a PIXELDELTA64,
+// reporting the mean bytes per frame and decode time of each.  Every decoded frame is checked against the
+// original, and deltas against a frame that never arrived must be refused; returns the number of effects where
+// either went wrong, so zero means pass.  Lives in wirebenchmark.cpp.
+
+int RunWireBenchmark(size_t cFrames, const char * pszJsonFile);
+
+// RunFFTBenchmark
+//
+// Runs arduinoFFT and RealFFT cPasses times each over a set of synthetic signals and reports the time per pass
+// and how far apart their bins and bands are.  Returns the number of signals where they disagree by more than
+// rounding.  Lives in fftbenchmark.cpp.
+
+int RunFFTBenchmark(size_t cPasses, const char * pszJsonFile);
+
+// RunBoidBenchmark
+//
+// Times cFrames frames of flocking for flocks of 20 to 500 boids, scanning the whole flock for each rule and
+// then through a BoidGrid, and checks that both steer the same.  Returns the number of flock sizes where the
+// forces disagree.  Lives in boidbenchmark.cpp.
+
+int RunBoidBenchmark(size_t cFrames, const char * pszJsonFile);
+
+// RunSplitBenchmark
+//
+// Times cFrames frames of 8 channels of strip and of a 64x32 matrix drawn on one thread and then through a
+// SplitRenderer, and checks the split frames against the whole ones.  Returns the number of layouts where any
+// frame differs.  Lives in splitbenchmark.cpp.
+
+int RunSplitBenchmark(size_t cFrames, const char * pszJsonFile);
+
+// RunKernelBenchmark
+//
+// Checks the span kernels in colorkernels.h against the same FastLED operations done a pixel at a time, and then
+// times cPasses passes of each both ways over a 64x32 frame.  Returns the number of kernels whose output differs
+// at all.  Lives in kernelbenchmark.cpp.
+
+int RunKernelBenchmark(size_t cPasses, const char * pszJsonFile);
+
+// RunTempoBenchmark
+//
+// Runs each recording, a WAV file paired with a file of annotated beat times, through the sound analyzer's
+// FFT and bands into a TempoTracker, and scores the beats it ticks against the annotated ones.  With no
+// recordings it makes drum patterns at a range of tempos instead.  Returns the number of tracks scoring
+// under an F-measure of 0.7.  Lives in tempobenchmark.cpp.
+
+int RunTempoBenchmark(const std::vector<std::pair<const char *, const char *>> & recordings, const char * pszJsonFile);
+
+// RunAudioReplay
+//
+// Plays a recording (anything ReadAudioFile can load), or a mix of test tones if pszAudioFile is null, to
+// g_Analyzer for cPasses sampler passes, or to the end of the recording if cPasses is 0, and writes the VU and
+// PeakData of each pass to pszCsvFile (or stdout) as CSV.  The clock is stepped rather than read, so the same
+// input always gives the same rows.  Returns 0, or -1 if a file couldn't be opened.  Lives in audiobenchmark.cpp.
+
+int RunAudioReplay(const char * pszAudioFile, size_t cPasses, const char * pszCsvFile);
+
+// RunAudioBenchmark
+//
+// Checks g_Analyzer's bin to band table against the per-bin band search it replaced on fixed bin magnitudes,
+// then times cPasses sampler passes over each of a few test signals and reports passes per second for the
+// NUM_BANDS and AUDIO_MAX_SAMPLES this build was compiled with.  Returns the number of magnitude sets where any
+// band differs plus the number of signals it couldn't keep up with in real time.  Lives in audiobenchmark.cpp.
+
+int RunAudioBenchmark(size_t cPasses, const char * pszJsonFile);
+
+// WriteJsonString
+//
+// Writes a quoted, escaped JSON string
+
+void WriteJsonString(FILE * pFile, const char * psz);
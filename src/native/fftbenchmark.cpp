@@ -0,0 +1,243 @@
+//+--------------------------------------------------------------------------
+//
+// File:        fftbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Runs the sound analyzer's arduinoFFT sequence and RealFFT side by
+//    side on the same synthetic sample buffers.  For each signal it
+//    reports the time per pass of each, the worst bin and band difference
+//    between them (relative to the loudest one), and exits nonzero if
+//    they disagree by more than float rounding.
+//
+//    The times are the host's, so only the ratio between them means
+//    much; the gap on the ESP32, with no double precision FPU, is wider.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include "globals.h"
+#include "effectbenchmark.h"
+#include "fftengine.h"
+#include <arduinoFFT.h>
+
+static const size_t kSamples          = 512;            // Same as SoundAnalyzer's MAX_SAMPLES and SAMPLING_FREQUENCY
+static const double kSampleRate       = 24000.0;
+static const size_t kBands            = 16;
+static const double kMaxRelativeError = 1e-4;
+
+// A signal is a function of the sample index, in the int16 range the I2S driver delivers
+
+struct TestSignal
+{
+    const char *                    name;
+    std::function<double(size_t)>   sample;
+};
+
+static double Tone(size_t i, double hz)
+{
+    return sin(2 * M_PI * hz * i / kSampleRate);
+}
+
+static double Noise()
+{
+    return (random(0, 65536) - 32768) / 32768.0;
+}
+
+// BandCutoffs
+//
+// The same log spaced cutoffs, from 200Hz to Nyquist, as SoundAnalyzer::CalculateBandCutoffs
+
+static std::vector<double> BandCutoffs()
+{
+    std::vector<double> cutoffs;
+    double freq = 200.0, df = pow(kSampleRate / 2.0 / freq, 1.0 / (kBands - 1));
+    for (size_t i = 0; i < kBands; i++, freq *= df)
+        cutoffs.push_back(freq);
+    return cutoffs;
+}
+
+// BandLevels
+//
+// Loudest bin in each band, skipping bins 0 and 1 like ProcessPeaks does
+
+template <typename T>
+static std::vector<double> BandLevels(const T * pMagnitudes, const std::vector<double> & cutoffs)
+{
+    std::vector<double> bands(kBands, 0.0);
+    for (size_t i = 2; i < kSamples / 2; i++)
+    {
+        double freq = (i - 2) * (kSampleRate / 2) / (kSamples / 2);
+        size_t iBand = 0;
+        while (iBand < kBands - 1 && freq >= cutoffs[iBand])
+            iBand++;
+        bands[iBand] = std::max(bands[iBand], (double) pMagnitudes[i]);
+    }
+    return bands;
+}
+
+static double MaxRelativeError(const std::vector<double> & a, const std::vector<double> & b)
+{
+    double peak = 0.0, error = 0.0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        peak  = std::max(peak, fabs(a[i]));
+        error = std::max(error, fabs(a[i] - b[i]));
+    }
+    return peak > 0.0 ? error / peak : error;
+}
+
+struct FFTResult
+{
+    const char * name;
+    double       arduinoMicros;
+    double       realMicros;
+    double       binError;
+    double       bandError;
+};
+
+// BenchmarkSignal
+//
+// Times both engines from the int16 samples to the magnitudes, including the copy into (and for arduinoFFT,
+// the clearing of) their work arrays, since that's part of what each costs per pass in the analyzer
+
+static FFTResult BenchmarkSignal(const TestSignal & signal, size_t cPasses, RealFFT & realFFT, const std::vector<double> & cutoffs)
+{
+    std::vector<int16_t> samples(kSamples);
+    for (size_t i = 0; i < kSamples; i++)
+        samples[i] = (int16_t) constrain(signal.sample(i) * 32767.0, -32768.0, 32767.0);
+
+    std::vector<double> vReal(kSamples), vImaginary(kSamples);
+    std::vector<float>  magnitudes(kSamples);
+
+    auto RunArduinoFFT = [&]()
+    {
+        for (size_t i = 0; i < kSamples; i++)
+        {
+            vReal[i] = samples[i];
+            vImaginary[i] = 0.0;
+        }
+        arduinoFFT fft(vReal.data(), vImaginary.data(), kSamples, kSampleRate);
+        fft.DCRemoval();
+        fft.Windowing(FFT_WIN_TYP_FLT_TOP, FFT_FORWARD);
+        fft.Compute(FFT_FORWARD);
+        fft.ComplexToMagnitude();
+    };
+
+    auto RunRealFFT = [&]()
+    {
+        for (size_t i = 0; i < kSamples; i++)
+            magnitudes[i] = samples[i];
+        realFFT.Magnitudes(magnitudes.data(), magnitudes.data());
+    };
+
+    auto TimeMicros = [&](const std::function<void()> & f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < cPasses; i++)
+            f();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / cPasses;
+    };
+
+    FFTResult result;
+    result.name          = signal.name;
+    result.arduinoMicros = TimeMicros(RunArduinoFFT);
+    result.realMicros    = TimeMicros(RunRealFFT);
+
+    std::vector<double> arduinoBins(vReal.begin(), vReal.begin() + kSamples / 2);
+    std::vector<double> realBins(magnitudes.begin(), magnitudes.begin() + kSamples / 2);
+    arduinoBins[0] = realBins[0] = 0.0;                 // DC is whatever rounding left behind after DCRemoval
+
+    result.binError  = MaxRelativeError(arduinoBins, realBins);
+    result.bandError = MaxRelativeError(BandLevels(vReal.data(), cutoffs), BandLevels(magnitudes.data(), cutoffs));
+    return result;
+}
+
+// RunFFTBenchmark
+//
+// See effectbenchmark.h
+
+int RunFFTBenchmark(size_t cPasses, const char * pszJsonFile)
+{
+    if (cPasses == 0)
+        cPasses = 1;
+
+    randomSeed(1337);
+
+    const std::vector<TestSignal> signals =
+    {
+        { "silence",      [](size_t)   { return 0.0; } },
+        { "noise",        [](size_t)   { return 0.5 * Noise(); } },
+        { "tone_440",     [](size_t i) { return 0.8 * Tone(i, 440.0); } },
+        { "tone_5k_dc",   [](size_t i) { return 0.25 + 0.5 * Tone(i, 5000.0); } },
+        { "chord",        [](size_t i) { return 0.3 * (Tone(i, 110.0) + Tone(i, 277.2) + Tone(i, 1661.2)); } },
+        { "sweep",        [](size_t i) { return 0.7 * sin(2 * M_PI * (50.0 + 11000.0 * i / (2.0 * kSamples)) * i / kSampleRate); } },
+        { "tone_noise",   [](size_t i) { return 0.6 * Tone(i, 2500.0) + 0.1 * Noise(); } },
+    };
+
+    RealFFT realFFT(kSamples);
+    const std::vector<double> cutoffs = BandCutoffs();
+
+    std::vector<FFTResult> results;
+    int cFailed = 0;
+
+    for (const auto & signal : signals)
+    {
+        results.push_back(BenchmarkSignal(signal, cPasses, realFFT, cutoffs));
+        const FFTResult & r = results.back();
+        bool bFailed = r.binError > kMaxRelativeError || r.bandError > kMaxRelativeError;
+        if (bFailed)
+            cFailed++;
+
+        debugI("%-12s arduinoFFT %8.2lfus  RealFFT %8.2lfus  (%4.1lfx)  bin error %.2e  band error %.2e  %s",
+               r.name, r.arduinoMicros, r.realMicros, r.arduinoMicros / r.realMicros, r.binError, r.bandError, bFailed ? "MISMATCH" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"samples\": %zu,\n  \"sample_rate\": %.0lf,\n  \"bands\": %zu,\n  \"passes\": %zu,\n  \"signals\": [\n",
+            kSamples, kSampleRate, kBands, cPasses);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const FFTResult & r = results[i];
+        fprintf(pFile, "    { \"name\": ");
+        WriteJsonString(pFile, r.name);
+        fprintf(pFile, ", \"arduinofft_us\": %.3lf, \"realfft_us\": %.3lf, \"speedup\": %.2lf, \"bin_error\": %.3e, \"band_error\": %.3e }%s\n",
+                r.arduinoMicros, r.realMicros, r.arduinoMicros / r.realMicros, r.binError, r.bandError,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"mismatched\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
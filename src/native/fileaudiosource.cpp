@@ -0,0 +1,154 @@
+//+--------------------------------------------------------------------------
+//
+// File:        fileaudiosource.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Loads WAV and raw PCM recordings for FileAudioSource and the tempo
+//    benchmark.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+#include "fileaudiosource.h"
+
+// ReadFile
+//
+// The whole of a file
+
+static bool ReadFile(const char * pszFile, std::vector<uint8_t> & data)
+{
+    FILE * pFile = fopen(pszFile, "rb");
+    if (!pFile)
+    {
+        debugE("Could not open %s", pszFile);
+        return false;
+    }
+
+    uint8_t buffer[4096];
+    for (size_t cb; (cb = fread(buffer, 1, sizeof(buffer), pFile)) > 0; )
+        data.insert(data.end(), buffer, buffer + cb);
+    fclose(pFile);
+    return true;
+}
+
+// ReadWav
+//
+// Mixes a WAV file down to mono and resamples it to sampleRate
+
+static bool ReadWav(const char * pszFile, const std::vector<uint8_t> & data, double sampleRate, std::vector<int16_t> & samples)
+{
+    auto U16 = [&](size_t i) { return (uint32_t) data[i] | (uint32_t) data[i + 1] << 8; };
+    auto U32 = [&](size_t i) { return U16(i) | U16(i + 2) << 16; };
+
+    if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) || memcmp(&data[8], "WAVE", 4))
+    {
+        debugE("%s is not a WAV file", pszFile);
+        return false;
+    }
+
+    uint32_t format = 0, cChannels = 0, rate = 0, cBits = 0;
+    size_t   iData = 0, cbData = 0;
+    for (size_t i = 12; i + 8 <= data.size(); )
+    {
+        size_t cbChunk = std::min<size_t>(U32(i + 4), data.size() - i - 8);
+        if (!memcmp(&data[i], "fmt ", 4) && cbChunk >= 16)
+        {
+            format    = U16(i + 8);
+            cChannels = U16(i + 10);
+            rate      = U32(i + 12);
+            cBits     = U16(i + 22);
+            if (format == 0xFFFE && cbChunk >= 26)      // WAVE_FORMAT_EXTENSIBLE, whose subformat says which
+                format = U16(i + 32);
+        }
+        else if (!memcmp(&data[i], "data", 4))
+        {
+            iData  = i + 8;
+            cbData = cbChunk;
+        }
+        i += 8 + cbChunk + (cbChunk & 1);
+    }
+
+    const bool bPCM16   = format == 1 && cBits == 16;
+    const bool bFloat32 = format == 3 && cBits == 32;
+    if (!(bPCM16 || bFloat32) || cChannels == 0 || rate == 0 || iData == 0)
+    {
+        debugE("%s must be 16 bit PCM or 32 bit float", pszFile);
+        return false;
+    }
+
+    const size_t cbFrame = cChannels * cBits / 8;
+    const size_t cFrames = cbData / cbFrame;
+    std::vector<float> mono(cFrames);
+    for (size_t i = 0; i < cFrames; i++)
+    {
+        float sum = 0.0f;
+        for (size_t c = 0; c < cChannels; c++)
+        {
+            size_t iSample = iData + i * cbFrame + c * cBits / 8;
+            if (bPCM16)
+            {
+                sum += (int16_t) U16(iSample) / 32768.0f;
+            }
+            else
+            {
+                uint32_t bits = U32(iSample);
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                sum += value;
+            }
+        }
+        mono[i] = sum / cChannels;
+    }
+
+    samples.resize((size_t)(cFrames * sampleRate / rate));
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        double position = i * (double) rate / sampleRate;
+        size_t iFrame = (size_t) position;
+        float  fraction = position - iFrame;
+        float  a = mono[std::min(iFrame, cFrames - 1)], b = mono[std::min(iFrame + 1, cFrames - 1)];
+        samples[i] = (int16_t) constrain((a + (b - a) * fraction) * 32767.0f, -32768.0f, 32767.0f);
+    }
+    return true;
+}
+
+// ReadAudioFile
+//
+// See fileaudiosource.h
+
+bool ReadAudioFile(const char * pszFile, double sampleRate, std::vector<int16_t> & samples)
+{
+    std::vector<uint8_t> data;
+    if (!ReadFile(pszFile, data))
+        return false;
+
+    size_t cchFile = strlen(pszFile);
+    if (cchFile >= 4 && !strcasecmp(pszFile + cchFile - 4, ".wav"))
+        return ReadWav(pszFile, data, sampleRate, samples);
+
+    samples.resize(data.size() / sizeof(int16_t));
+    for (size_t i = 0; i < samples.size(); i++)
+        samples[i] = (int16_t) (data[2 * i] | data[2 * i + 1] << 8);
+    return true;
+}
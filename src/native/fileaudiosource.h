@@ -0,0 +1,76 @@
+//+--------------------------------------------------------------------------
+//
+// File:        fileaudiosource.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Recordings on disk, for the native build to play to the sound
+//    analyzer in place of a microphone.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "audiosource.h"
+
+// ReadAudioFile
+//
+// Loads a recording as mono 16 bit samples at sampleRate.  A .wav file can be 16 bit PCM or 32 bit float, at any
+// rate and with any number of channels, which are mixed down and resampled.  Anything else is taken as raw mono 16
+// bit little endian PCM already at sampleRate.  Returns false, having said why, if it can't.
+
+bool ReadAudioFile(const char * pszFile, double sampleRate, std::vector<int16_t> & samples);
+
+// FileAudioSource
+//
+// Plays a recording loaded by ReadAudioFile, once
+
+class FileAudioSource : public AudioSource
+{
+    std::vector<int16_t> _samples;
+    size_t               _iNext = 0;
+
+  public:
+
+    bool Open(const char * pszFile, double sampleRate)
+    {
+        _iNext = 0;
+        return ReadAudioFile(pszFile, sampleRate, _samples);
+    }
+
+    size_t Read(int16_t * pSamples, size_t cSamples) override
+    {
+        size_t cRead = std::min(cSamples, _samples.size() - _iNext);
+        std::copy(_samples.begin() + _iNext, _samples.begin() + _iNext + cRead, pSamples);
+        _iNext += cRead;
+        return cRead;
+    }
+
+    size_t Remaining() const
+    {
+        return _samples.size() - _iNext;
+    }
+};
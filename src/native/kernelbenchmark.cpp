@@ -0,0 +1,284 @@
+//+--------------------------------------------------------------------------
+//
+// File:        kernelbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Checks each of the span kernels in colorkernels.h against doing the
+//    same thing a pixel at a time with FastLED, byte for byte, over
+//    random spans of every length up to a few words, starting at every
+//    alignment and with every scale or blend amount.  Then times both
+//    ways over a Mesmerizer sized (64x32) frame.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include "globals.h"
+#include "effectbenchmark.h"
+
+static const size_t kMaxSpan     = 37;
+static const int    kFrameWidth  = 64;
+static const int    kFrameHeight = 32;
+
+struct KernelResult
+{
+    const char * name;
+    size_t       mismatches;
+    double       scalarMicros;
+    double       spanMicros;
+};
+
+static void RandomFill(CRGB * p, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        p[i] = CRGB(random8(), random8(), random8());
+
+    // Plenty of saturated channels too, so the adds overflow
+    if (count && random8() < 64)
+        for (size_t i = 0; i < count; i += 2)
+            p[i].r = 255;
+}
+
+// The scalar versions, one pixel at a time through FastLED
+
+static void ScalarBlurColumns(CRGB * pLines, size_t cLines, size_t cPixels, size_t stride, size_t first, fract8 amount)
+{
+    uint8_t keep = 255 - amount;
+    uint8_t seep = amount >> 1;
+    for (size_t col = 0; col < cPixels; col++)
+    {
+        CRGB carryover = CRGB::Black;
+        for (size_t i = first; i < cLines; i++)
+        {
+            CRGB cur = pLines[i * stride + col];
+            CRGB part = cur;
+            part.nscale8(seep);
+            cur.nscale8(keep);
+            cur += carryover;
+            if (i)
+                pLines[(i - 1) * stride + col] += part;
+            pLines[i * stride + col] = cur;
+            carryover = part;
+        }
+    }
+}
+
+// CompareKernel
+//
+// Runs a span kernel and its scalar equivalent over the same random source and destination for every length up to
+// kMaxSpan, every alignment of the two and every amount, and counts the runs where the results differ
+
+static size_t CompareKernel(const std::function<void(CRGB *, const CRGB *, size_t, uint8_t)> & span,
+                            const std::function<void(CRGB *, const CRGB *, size_t, uint8_t)> & scalar)
+{
+    // Byte buffers, so that the spans can start off a word boundary
+
+    std::vector<uint8_t> srcBytes((kMaxSpan + 2) * sizeof(CRGB));
+    std::vector<uint8_t> spanBytes(srcBytes.size());
+    std::vector<uint8_t> scalarBytes(srcBytes.size());
+    std::vector<CRGB>    dst(kMaxSpan);
+
+    size_t cMismatches = 0;
+    for (size_t count = 0; count <= kMaxSpan; count++)
+    {
+        for (size_t srcOffset = 0; srcOffset < 4; srcOffset++)
+        {
+            for (size_t dstOffset = 0; dstOffset < 4; dstOffset++)
+            {
+                CRGB * pSrc    = (CRGB *) (srcBytes.data() + srcOffset);
+                CRGB * pSpan   = (CRGB *) (spanBytes.data() + dstOffset);
+                CRGB * pScalar = (CRGB *) (scalarBytes.data() + dstOffset);
+
+                for (int amount = 0; amount < 256; amount++)
+                {
+                    RandomFill(pSrc, count);
+                    RandomFill(dst.data(), count);
+                    memcpy(pSpan, dst.data(), count * sizeof(CRGB));
+                    memcpy(pScalar, dst.data(), count * sizeof(CRGB));
+
+                    span(pSpan, pSrc, count, amount);
+                    scalar(pScalar, pSrc, count, amount);
+
+                    if (memcmp(pSpan, pScalar, count * sizeof(CRGB)))
+                        cMismatches++;
+                }
+            }
+        }
+    }
+    return cMismatches;
+}
+
+// CompareBlur
+//
+// BlurLines against blurring each column a pixel at a time, for a range of block shapes, starting lines and amounts
+
+static size_t CompareBlur()
+{
+    size_t cMismatches = 0;
+    for (size_t cLines = 1; cLines <= 9; cLines += 2)
+    {
+        for (size_t cPixels = 1; cPixels <= 21; cPixels += 4)
+        {
+            for (size_t first = 0; first < 3; first++)
+            {
+                for (int amount = 0; amount < 256; amount += 3)
+                {
+                    size_t stride = cPixels + 1;
+                    std::vector<CRGB> span(cLines * stride), scalar, scratch(2 * cPixels);
+                    RandomFill(span.data(), span.size());
+                    scalar = span;
+
+                    BlurLines(span.data(), cLines, cPixels, stride, first, amount, scratch.data());
+                    ScalarBlurColumns(scalar.data(), cLines, cPixels, stride, first, amount);
+
+                    if (span != scalar)
+                        cMismatches++;
+                }
+            }
+        }
+    }
+    return cMismatches;
+}
+
+// TimeMicros
+//
+// Mean time of cPasses calls to pass
+
+static double TimeMicros(size_t cPasses, const std::function<void()> & pass)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cPasses; i++)
+        pass();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / cPasses;
+}
+
+// RunKernelBenchmark
+//
+// See effectbenchmark.h
+
+int RunKernelBenchmark(size_t cPasses, const char * pszJsonFile)
+{
+    if (cPasses == 0)
+        cPasses = 1;
+
+    random16_set_seed(1337);
+
+    const size_t cFrame = kFrameWidth * kFrameHeight;
+    std::vector<CRGB> frame(cFrame), other(cFrame), scratch(2 * kFrameWidth);
+    std::vector<uint8_t> indices(cFrame);
+    RandomFill(frame.data(), cFrame);
+    RandomFill(other.data(), cFrame);
+    for (auto & index : indices)
+        index = random8();
+
+    const CRGBPalette16  palette16 = RainbowColors_p;
+    const CRGBPalette256 palette256 = palette16;
+
+    std::vector<KernelResult> results;
+
+    // Scale
+
+    results.push_back({ "scale",
+        CompareKernel([](CRGB * d, const CRGB * s, size_t n, uint8_t a) { ScaleSpan(d, s, n, a); },
+                      [](CRGB * d, const CRGB * s, size_t n, uint8_t a) { for (size_t i = 0; i < n; i++) { d[i] = s[i]; d[i].nscale8(a); } }),
+        TimeMicros(cPasses, [&]() { for (auto & c : frame) c.nscale8(250); }),
+        TimeMicros(cPasses, [&]() { ScaleSpan(frame.data(), cFrame, 250); }) });
+
+    // Fade to black
+
+    results.push_back({ "fade",
+        CompareKernel([](CRGB * d, const CRGB *, size_t n, uint8_t a) { FadeSpanToBlackBy(d, n, a); },
+                      [](CRGB * d, const CRGB *, size_t n, uint8_t a) { for (size_t i = 0; i < n; i++) d[i].fadeToBlackBy(a); }),
+        TimeMicros(cPasses, [&]() { for (auto & c : frame) c.fadeToBlackBy(5); }),
+        TimeMicros(cPasses, [&]() { FadeSpanToBlackBy(frame.data(), cFrame, 5); }) });
+
+    // Saturating add
+
+    results.push_back({ "add",
+        CompareKernel([](CRGB * d, const CRGB * s, size_t n, uint8_t) { AddSpan(d, s, n); },
+                      [](CRGB * d, const CRGB * s, size_t n, uint8_t) { for (size_t i = 0; i < n; i++) d[i] += s[i]; }),
+        TimeMicros(cPasses, [&]() { for (size_t i = 0; i < cFrame; i++) frame[i] += other[i]; ScaleSpan(frame.data(), cFrame, 128); }),
+        TimeMicros(cPasses, [&]() { AddSpan(frame.data(), other.data(), cFrame); ScaleSpan(frame.data(), cFrame, 128); }) });
+
+    // Blend
+
+    results.push_back({ "blend",
+        CompareKernel([](CRGB * d, const CRGB * s, size_t n, uint8_t a) { BlendSpan(d, s, n, a); },
+                      [](CRGB * d, const CRGB * s, size_t n, uint8_t a) { for (size_t i = 0; i < n; i++) nblend(d[i], s[i], a); }),
+        TimeMicros(cPasses, [&]() { for (size_t i = 0; i < cFrame; i++) nblend(frame[i], other[i], 100); }),
+        TimeMicros(cPasses, [&]() { BlendSpan(frame.data(), other.data(), cFrame, 100); }) });
+
+    // Palette lookup, through a CRGBPalette16 expanded to 256 entries
+
+    std::vector<CRGB> mapped(cFrame);
+    size_t cMapMismatches = 0;
+    MapSpan(mapped.data(), indices.data(), cFrame, &palette256[0]);
+    for (size_t i = 0; i < cFrame; i++)
+        if (mapped[i] != ColorFromPalette(palette16, indices[i]))
+            cMapMismatches++;
+
+    results.push_back({ "palette", cMapMismatches,
+        TimeMicros(cPasses, [&]() { for (size_t i = 0; i < cFrame; i++) mapped[i] = ColorFromPalette(palette16, indices[i]); }),
+        TimeMicros(cPasses, [&]() { MapSpan(mapped.data(), indices.data(), cFrame, &palette256[0]); }) });
+
+    // Column blur
+
+    results.push_back({ "blur", CompareBlur(),
+        TimeMicros(cPasses, [&]() { ScalarBlurColumns(frame.data(), kFrameHeight, kFrameWidth, kFrameWidth, 1, 64); }),
+        TimeMicros(cPasses, [&]() { BlurLines(frame.data(), kFrameHeight, kFrameWidth, kFrameWidth, 1, 64, scratch.data()); }) });
+
+    int cFailed = 0;
+    for (const auto & r : results)
+    {
+        if (r.mismatches)
+            cFailed++;
+
+        debugI("%-8s  scalar %8.2lfus  span %8.2lfus  (%5.2lfx)  %s",
+               r.name, r.scalarMicros, r.spanMicros, r.scalarMicros / r.spanMicros, r.mismatches ? "MISMATCH" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"passes\": %zu,\n  \"kernels\": [\n", kFrameWidth, kFrameHeight, cPasses);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const KernelResult & r = results[i];
+        fprintf(pFile, "    { \"name\": \"%s\", \"scalar_us\": %.3lf, \"span_us\": %.3lf, \"speedup\": %.2lf, \"mismatches\": %zu }%s\n",
+                r.name, r.scalarMicros, r.spanMicros, r.scalarMicros / r.spanMicros, r.mismatches,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"mismatched\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
@@ -0,0 +1,301 @@
+//+--------------------------------------------------------------------------
+//
+// File:        nativemain.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Entry point for the native (desktop host) build.  Stands in for
+//    main.cpp: it owns the globals that main.cpp, network.cpp and
+//    screen.cpp would normally define, sets up the same LEDStripGFX
+//    devices and buffer managers, and then runs the regular draw loop
+//    on the main thread for a fixed number of frames.
+//
+//    Instead of a WS2812B driver, each channel gets a VirtualLEDSink, so
+//    the pixels FastLED would have clocked out end up in memory (and
+//    optionally in a file of raw RGB frames for inspection).
+//
+//    Usage:  program [--frames N] [--effect I] [--dump file.rgb] [--list]
+//            program --benchmark [--frames N] [--json file.json]
+//            program --wirebench [--frames N] [--json file.json]
+//            program --spscbench [--frames N] [--json file.json]
+//            program --fftbench [--frames N] [--json file.json]
+//            program --boidbench [--frames N] [--json file.json]
+//            program --splitbench [--frames N] [--json file.json]
+//            program --kernelbench [--frames N] [--json file.json]
+//            program --tempobench [--wav file.wav --beats file.txt]... [--json file.json]
+//            program --audioreplay [--wav file.wav] [--frames N] [--csv file.csv]
+//            program --audiobench [--frames N] [--json file.json]
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#include "globals.h"
+#include "virtualledsink.h"
+#include "effectbenchmark.h"
+
+// Globals that main.cpp, network.cpp, and screen.cpp define on the chip
+
+DRAM_ATTR uint32_t g_FPS = 0;
+DRAM_ATTR bool g_bUpdateStarted = false;
+DRAM_ATTR AppTime g_AppTime;
+DRAM_ATTR bool NTPTimeClient::_bClockSet = false;
+DRAM_ATTR std::mutex NTPTimeClient::_clockMutex;
+DRAM_ATTR std::shared_ptr<GFXBase> g_aptrDevices[NUM_CHANNELS];
+DRAM_ATTR RemoteDebug Debug;
+DRAM_ATTR std::mutex Screen::_screenMutex;
+DRAM_ATTR uint8_t giInfoPage = 0;
+NightDriverTaskManager g_TaskManager;
+double g_Brite;
+uint32_t g_Watts;
+
+DRAM_ATTR const int g_aRingSizeTable[MAX_RINGS] =
+{
+    RING_SIZE_0,
+    RING_SIZE_1,
+    RING_SIZE_2,
+    RING_SIZE_3,
+    RING_SIZE_4
+};
+
+extern DRAM_ATTR std::unique_ptr<LEDBufferManager> g_aptrBufferManager[NUM_CHANNELS];
+extern DRAM_ATTR std::unique_ptr<EffectManager<GFXBase>> g_aptrEffectManager;
+
+static VirtualLEDSink g_aSinks[NUM_CHANNELS];
+
+// PrintUsage
+//
+// Command line help
+
+static void PrintUsage(const char * pszProgram)
+{
+    printf("Usage: %s [--frames N] [--effect I] [--dump file.rgb] [--list]\n", pszProgram);
+    printf("       %s --benchmark [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --wirebench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --spscbench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --fftbench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --boidbench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --splitbench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --kernelbench [--frames N] [--json file.json]\n", pszProgram);
+    printf("       %s --tempobench [--wav file.wav --beats file.txt]... [--json file.json]\n", pszProgram);
+    printf("       %s --audioreplay [--wav file.wav] [--frames N] [--csv file.csv]\n", pszProgram);
+    printf("       %s --audiobench [--frames N] [--json file.json]\n", pszProgram);
+    printf("  --frames N     Number of draw loop passes to run (default 600, or 2000 per effect when benchmarking)\n");
+    printf("  --effect I     Start at effect index I rather than 0\n");
+    printf("  --dump FILE    Append each shown frame of channel 0 to FILE as raw RGB\n");
+    printf("  --list         List the effects in this project's table and exit\n");
+    printf("  --benchmark    Time Draw() for every effect and exit nonzero if any is over its frame budget\n");
+    printf("  --wirebench    Compare raw, zlib and delta frames on the wire and exit nonzero if any fails to decode\n");
+    printf("  --spscbench    Pass N frames between two threads through the LED buffer queue and exit nonzero on a torn or out of order frame\n");
+    printf("  --fftbench     Compare RealFFT with arduinoFFT for N passes per signal and exit nonzero if they disagree\n");
+    printf("  --boidbench    Time N frames of flocking for 20 to 500 boids with and without the neighbor grid\n");
+    printf("  --splitbench   Time N frames of 8 strip channels and a 64x32 matrix drawn on one thread and split across two\n");
+    printf("  --kernelbench  Check the CRGB span kernels against FastLED a pixel at a time and time N passes of each\n");
+    printf("  --tempobench   Score the tempo tracker's beats against annotated ones, for each recording or made up drums\n");
+    printf("  --audioreplay  Play a recording, or test tones, to the sound analyzer and write its peaks each pass as CSV\n");
+    printf("  --audiobench   Check the analyzer's bin to band table, then time N passes for this build's bands and samples\n");
+    printf("  --wav FILE     A recording for --tempobench or --audioreplay, 16 bit PCM or 32 bit float, or raw PCM\n");
+    printf("  --beats FILE   The beat times in the recording before it, in seconds, one per line\n");
+    printf("  --csv FILE     Write the --audioreplay rows to FILE rather than stdout\n");
+    printf("  --json FILE    Write the benchmark report to FILE rather than stdout\n");
+}
+
+// main
+//
+// Sets up the strip devices and effects the same way setup() does on the chip and then pumps the draw loop
+
+int main(int argc, char * argv[])
+{
+    size_t cFrames = 0;
+    long   iEffect = -1;
+    bool   bList = false;
+    bool   bBenchmark = false;
+    bool   bWireBench = false;
+    bool   bSPSCBench = false;
+    bool   bFFTBench = false;
+    bool   bBoidBench = false;
+    bool   bSplitBench = false;
+    bool   bKernelBench = false;
+    bool   bTempoBench = false;
+    bool   bAudioReplay = false;
+    bool   bAudioBench = false;
+    std::vector<std::pair<const char *, const char *>> recordings;
+    const char * pszDump = nullptr;
+    const char * pszJson = nullptr;
+    const char * pszCsv = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            cFrames = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--effect") && i + 1 < argc)
+            iEffect = strtol(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--dump") && i + 1 < argc)
+            pszDump = argv[++i];
+        else if (!strcmp(argv[i], "--list"))
+            bList = true;
+        else if (!strcmp(argv[i], "--benchmark"))
+            bBenchmark = true;
+        else if (!strcmp(argv[i], "--wirebench"))
+            bWireBench = true;
+        else if (!strcmp(argv[i], "--spscbench"))
+            bSPSCBench = true;
+        else if (!strcmp(argv[i], "--fftbench"))
+            bFFTBench = true;
+        else if (!strcmp(argv[i], "--boidbench"))
+            bBoidBench = true;
+        else if (!strcmp(argv[i], "--splitbench"))
+            bSplitBench = true;
+        else if (!strcmp(argv[i], "--kernelbench"))
+            bKernelBench = true;
+        else if (!strcmp(argv[i], "--tempobench"))
+            bTempoBench = true;
+        else if (!strcmp(argv[i], "--audioreplay"))
+            bAudioReplay = true;
+        else if (!strcmp(argv[i], "--audiobench"))
+            bAudioBench = true;
+        else if (!strcmp(argv[i], "--wav") && i + 1 < argc)
+            recordings.push_back({ argv[++i], nullptr });
+        else if (!strcmp(argv[i], "--beats") && i + 1 < argc && !recordings.empty() && !recordings.back().second)
+            recordings.back().second = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc)
+            pszJson = argv[++i];
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc)
+            pszCsv = argv[++i];
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    debugI("NightDriverStrip native build: %s, %d channel(s) of %d LEDs", PROJECT_NAME, NUM_CHANNELS, NUM_LEDS);
+
+    if (bFFTBench)                                              // Doesn't need any LEDs or effects
+        return RunFFTBenchmark(cFrames ? cFrames : 2000, pszJson) == 0 ? 0 : 2;
+
+    if (bSPSCBench)
+        return RunSPSCBenchmark(cFrames ? cFrames : 200000, pszJson) == 0 ? 0 : 2;
+
+    if (bBoidBench)
+        return RunBoidBenchmark(cFrames ? cFrames : 200, pszJson) == 0 ? 0 : 2;
+
+    if (bSplitBench)
+        return RunSplitBenchmark(cFrames ? cFrames : 2000, pszJson) == 0 ? 0 : 2;
+
+    if (bKernelBench)
+        return RunKernelBenchmark(cFrames ? cFrames : 2000, pszJson) == 0 ? 0 : 2;
+
+    if (bTempoBench)
+    {
+        for (const auto & recording : recordings)
+        {
+            if (!recording.second)
+            {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        }
+        return RunTempoBenchmark(recordings, pszJson) == 0 ? 0 : 2;
+    }
+
+    if (bAudioReplay)
+    {
+        if (recordings.size() > 1)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        return RunAudioReplay(recordings.empty() ? nullptr : recordings[0].first, cFrames, pszCsv) == 0 ? 0 : 2;
+    }
+
+    if (bAudioBench)
+        return RunAudioBenchmark(cFrames ? cFrames : 2000, pszJson) == 0 ? 0 : 2;
+
+    for (int i = 0; i < NUM_CHANNELS; i++)
+        g_aptrDevices[i] = std::make_shared<LEDStripGFX>(MATRIX_WIDTH, MATRIX_HEIGHT);
+
+    for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
+        g_aptrBufferManager[iChannel] = std::make_unique<LEDBufferManager>(MIN_BUFFERS, g_aptrDevices[iChannel]);
+
+    for (int i = 0; i < NUM_CHANNELS; i++)
+        FastLED.addLeds(&g_aSinks[i], ((LEDStripGFX *)g_aptrDevices[i].get())->leds, g_aptrDevices[i]->GetLEDCount());
+
+    FastLED.setDither(DISABLE_DITHER);                          // Keep frames repeatable between runs
+    g_Brightness = 255;
+
+    InitEffectsManager();
+
+    if (bList)
+    {
+        for (size_t i = 0; i < g_aptrEffectManager->EffectCount(); i++)
+            printf("%3zu  %s\n", i, g_aptrEffectManager->EffectsList()[i]->FriendlyName().c_str());
+        return 0;
+    }
+
+    if (bBenchmark)
+        return RunEffectBenchmark(cFrames ? cFrames : 2000, pszJson) == 0 ? 0 : 2;
+
+    if (bWireBench)
+        return RunWireBenchmark(cFrames ? cFrames : 600, pszJson) == 0 ? 0 : 2;
+    if (cFrames == 0)
+        cFrames = 600;
+
+    if (iEffect >= 0)
+    {
+        if ((size_t) iEffect >= g_aptrEffectManager->EffectCount())
+        {
+            fprintf(stderr, "Effect index %ld out of range, table has %zu effects\n", iEffect, g_aptrEffectManager->EffectCount());
+            return 1;
+        }
+        g_aptrEffectManager->SetCurrentEffectIndex(iEffect);
+    }
+
+    FILE * pDump = nullptr;
+    if (pszDump)
+    {
+        pDump = fopen(pszDump, "wb");
+        if (!pDump)
+        {
+            fprintf(stderr, "Could not open %s for writing\n", pszDump);
+            return 1;
+        }
+        g_aSinks[0].DumpTo(pDump);
+    }
+
+    PrepareDrawLoop();
+
+    double startTime = AppTime::CurrentTime();
+    for (size_t i = 0; i < cFrames; i++)
+        DrawLoopPass();
+    double elapsed = AppTime::CurrentTime() - startTime;
+
+    if (pDump)
+        fclose(pDump);
+
+    debugI("Drew %zu frames in %.3lf seconds (%.1lf FPS), last effect was %s",
+           g_aSinks[0].FrameCount(),
+           elapsed,
+           elapsed > 0 ? g_aSinks[0].FrameCount() / elapsed : 0.0,
+           g_aptrEffectManager->GetCurrentEffectName().c_str());
+
+    return 0;
+}
@@ -0,0 +1,358 @@
+//+--------------------------------------------------------------------------
+//
+// File:        nativeshim.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Out-of-line parts of the Arduino/FreeRTOS shim in include/native:
+//    the clock, the RNG, task creation, and the global hardware objects.
+//
+//    The timing functions are weak so that if the FastLED stub platform
+//    brings its own millis() and friends, theirs win and there's only one
+//    clock in the process.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <atomic>
+
+#undef gettimeofday                                 // We need the real one in here
+
+HardwareSerial Serial;
+EspClass       ESP;
+WiFiClass      WiFi;
+
+// Clock
+//
+// Everything is relative to the first time anyone asks, which is close enough to "boot"
+
+static const std::chrono::steady_clock::time_point s_bootTime = std::chrono::steady_clock::now();
+
+// While frozen, both clocks read from s_usFrozen.  The wall clock is pinned to a fixed epoch so that
+// anything derived from the time of day is repeatable too.
+
+static const time_t         kFrozenEpoch = 1600000000;
+static std::atomic<bool>    s_bClockFrozen(false);
+static std::atomic<int64_t> s_usFrozen(0);
+
+void NativeClockFreeze(int64_t usSinceBoot)
+{
+    s_usFrozen = usSinceBoot;
+    s_bClockFrozen = true;
+}
+
+void NativeClockAdvance(int64_t us)
+{
+    s_usFrozen += us;
+}
+
+void NativeClockRelease()
+{
+    s_bClockFrozen = false;
+}
+
+int64_t esp_timer_get_time()
+{
+    if (s_bClockFrozen)
+        return s_usFrozen;
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_bootTime).count();
+}
+
+int NativeGetTimeOfDay(struct timeval * tv, void * tz)
+{
+    if (!s_bClockFrozen)
+        return gettimeofday(tv, (struct timezone *) tz);
+
+    int64_t us = s_usFrozen;
+    tv->tv_sec  = kFrozenEpoch + us / 1000000;
+    tv->tv_usec = us % 1000000;
+    return 0;
+}
+
+__attribute__((weak)) uint32_t millis()
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+__attribute__((weak)) uint32_t micros()
+{
+    return (uint32_t) esp_timer_get_time();
+}
+
+__attribute__((weak)) void delay(int ms)
+{
+    if (ms > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    else
+        std::this_thread::yield();
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+__attribute__((weak)) void yield()
+{
+    std::this_thread::yield();
+}
+
+// get_millisecond_timer
+//
+// FastLED's beat and timer helpers call this (we build with USE_GET_MILLISECOND_TIMER) so that they
+// run off the same, possibly virtual, clock as everything else
+
+uint32_t get_millisecond_timer()
+{
+    return millis();
+}
+
+// random
+//
+// Arduino's random() is [min, max).  Seeded with a constant so that runs are repeatable unless
+// someone calls randomSeed().
+
+static std::mt19937 s_rng(0x4E445331);
+
+void randomSeed(unsigned long seed)
+{
+    s_rng.seed(seed);
+    srand(seed);
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+    return (long)(s_rng() % (unsigned long) howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+        return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+// Heap
+//
+// The host has no meaningful heap limit, so report the ESP32's internal RAM size as a
+// stand-in.  Code that sizes its buffers off free memory then behaves like it does on a chip.
+
+static const size_t kNominalHeapSize = 320 * 1024;
+
+size_t heap_caps_get_free_size(uint32_t)
+{
+    return kNominalHeapSize;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t)
+{
+    return kNominalHeapSize;
+}
+
+size_t heap_caps_get_total_size(uint32_t)
+{
+    return kNominalHeapSize;
+}
+
+// Tasks
+//
+// Each task is a detached thread.  The handle is just a small record so that callers holding
+// one have something non-null to compare against.
+
+struct NativeTask
+{
+    const char *            name;
+    UBaseType_t             priority;
+    BaseType_t              core;
+
+    std::mutex              notifyMutex;
+    std::condition_variable notifyCondition;
+    uint32_t                notifyCount = 0;
+};
+
+static thread_local NativeTask * s_pCurrentTask = nullptr;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
+                                   const char * pcName,
+                                   uint32_t,
+                                   void * pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * pvCreatedTask,
+                                   BaseType_t xCoreID)
+{
+    auto pTask = new NativeTask { pcName, uxPriority, xCoreID };
+    if (pvCreatedTask)
+        *pvCreatedTask = pTask;
+
+    std::thread([pvTaskCode, pvParameters, pTask]()
+    {
+        s_pCurrentTask = pTask;
+        pvTaskCode(pvParameters);
+    }).detach();
+
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks * portTICK_PERIOD_MS);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // A FreeRTOS task deleting itself never returns, so park the thread forever
+
+    if (task == nullptr || task == s_pCurrentTask)
+        for (;;)
+            std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+BaseType_t xPortGetCoreID()
+{
+    return s_pCurrentTask ? s_pCurrentTask->core : 1;
+}
+
+// xTaskGetCurrentTaskHandle
+//
+// Threads that weren't started as tasks (like main) get a record the first time they ask, so they
+// have something to be notified through
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    if (!s_pCurrentTask)
+        s_pCurrentTask = new NativeTask { "thread", 1, 1 };
+    return s_pCurrentTask;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    auto pTask = (NativeTask *) task;
+    {
+        std::lock_guard<std::mutex> lock(pTask->notifyMutex);
+        pTask->notifyCount++;
+    }
+    pTask->notifyCondition.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t ticksToWait)
+{
+    auto pTask = (NativeTask *) xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(pTask->notifyMutex);
+
+    auto bNotified = [pTask]() { return pTask->notifyCount > 0; };
+    if (ticksToWait == portMAX_DELAY)
+        pTask->notifyCondition.wait(lock, bNotified);
+    else
+        pTask->notifyCondition.wait_for(lock, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), bNotified);
+
+    uint32_t count = pTask->notifyCount;
+    if (count)
+        pTask->notifyCount = xClearCountOnExit ? 0 : count - 1;
+    return count;
+}
+
+// esp_timer
+//
+// Each timer gets a thread that sleeps until it's due and then runs the callback, much like the
+// esp_timer task does on the chip.  Timers run on the real clock even when the virtual one is frozen.
+
+struct NativeTimer
+{
+    esp_timer_cb_t          callback;
+    void *                  arg;
+    std::mutex              mutex;
+    std::condition_variable condition;
+    bool                    bArmed = false;
+    std::chrono::steady_clock::time_point due;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t * pArgs, esp_timer_handle_t * pHandle)
+{
+    auto pTimer = new NativeTimer { pArgs->callback, pArgs->arg };
+    *pHandle = pTimer;
+
+    std::thread([pTimer]()
+    {
+        std::unique_lock<std::mutex> lock(pTimer->mutex);
+        for (;;)
+        {
+            if (!pTimer->bArmed)
+            {
+                pTimer->condition.wait(lock);
+            }
+            else if (pTimer->condition.wait_until(lock, pTimer->due) == std::cv_status::timeout && pTimer->bArmed
+                     && std::chrono::steady_clock::now() >= pTimer->due)
+            {
+                pTimer->bArmed = false;
+                lock.unlock();
+                pTimer->callback(pTimer->arg);
+                lock.lock();
+            }
+        }
+    }).detach();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t handle, uint64_t timeout_us)
+{
+    auto pTimer = (NativeTimer *) handle;
+    {
+        std::lock_guard<std::mutex> lock(pTimer->mutex);
+        if (pTimer->bArmed)
+            return ESP_ERR_INVALID_STATE;
+        pTimer->bArmed = true;
+        pTimer->due = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+    }
+    pTimer->condition.notify_one();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t handle)
+{
+    auto pTimer = (NativeTimer *) handle;
+    {
+        std::lock_guard<std::mutex> lock(pTimer->mutex);
+        if (!pTimer->bArmed)
+            return ESP_ERR_INVALID_STATE;
+        pTimer->bArmed = false;
+    }
+    pTimer->condition.notify_one();
+    return ESP_OK;
+}
@@ -0,0 +1,225 @@
+//+--------------------------------------------------------------------------
+//
+// File:        splitbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Times a frame drawn whole on one thread against the same frame
+//    drawn through a SplitRenderer, with its worker on a second thread,
+//    for 8 channels of strip and for a 64x32 matrix.
+//
+//    The native build only has the one channel the strip project it
+//    builds gives it, so rather than the real effects the frames come
+//    from a stand-in effect that owns its own buffers and spends about
+//    what PaletteEffect and PatternMunch do per pixel: a palette lookup
+//    and a little arithmetic.  Two copies of it are run side by side
+//    and their frames compared, and the run fails if they ever differ.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include "globals.h"
+#include "effectbenchmark.h"
+
+static const int kStripChannels = 8;
+static const int kStripLEDs     = 600;
+static const int kMatrixWidth   = 64;
+static const int kMatrixHeight  = 32;
+
+// SplitBenchEffect
+//
+// channels x rows x columns of pixels, each a function of where it is and the frame number
+
+class SplitBenchEffect : public LEDStripEffect
+{
+    const int                           _cChannels;
+    const int                           _cRows;
+    const int                           _cColumns;
+    std::vector<std::vector<CRGB>>      _channels;
+    uint8_t                             _frame = 0;
+    uint8_t                             _drawFrame = 0;
+
+  public:
+
+    SplitBenchEffect(int cChannels, int cRows, int cColumns)
+      : LEDStripEffect("Split Bench"),
+        _cChannels(cChannels),
+        _cRows(cRows),
+        _cColumns(cColumns),
+        _channels(cChannels, std::vector<CRGB>(cRows * cColumns))
+    {
+    }
+
+    virtual bool CanDrawSplit() const
+    {
+        return true;
+    }
+
+    virtual FramePart WholeFrame() const
+    {
+        return FramePart { 0, _cChannels, 0, _cRows };
+    }
+
+    virtual void Draw()
+    {
+        PrepareFrame();
+        DrawPart(WholeFrame());
+    }
+
+    virtual void PrepareFrame()
+    {
+        _drawFrame = _frame++;
+    }
+
+    virtual void DrawPart(const FramePart & part)
+    {
+        for (int channel = part.channelBegin; channel < part.channelEnd; channel++)
+        {
+            CRGB * pRow = _channels[channel].data() + part.rowBegin * _cColumns;
+            for (int y = part.rowBegin; y < part.rowEnd; y++, pRow += _cColumns)
+            {
+                for (int x = 0; x < _cColumns; x++)
+                {
+                    uint8_t index = sin8(x * 7 + _drawFrame) + cos8(y * 11 + channel * 32 - _drawFrame);
+                    pRow[x] = ColorFromPalette(RainbowColors_p, index, 255, LINEARBLEND);
+                }
+            }
+        }
+    }
+
+    bool SameFrameAs(const SplitBenchEffect & other) const
+    {
+        return _channels == other._channels;
+    }
+};
+
+struct SplitResult
+{
+    const char * name;
+    int          channels;
+    int          rows;
+    int          columns;
+    double       wholeMicros;
+    double       splitMicros;
+    size_t       mismatches;
+};
+
+// StartWorker
+//
+// The worker thread parks itself in the renderer for the life of the process, so the renderer is never freed
+
+static SplitRenderer * StartWorker()
+{
+    static SplitRenderer renderer;
+
+    if (!renderer.IsRunning())
+    {
+        xTaskCreatePinnedToCore(SplitRenderer::WorkerEntry, "Split Render", STACK_SIZE, &renderer, DRAWING_PRIORITY, nullptr, RENDER_CORE);
+        while (!renderer.IsRunning())
+            delay(1);
+    }
+    return &renderer;
+}
+
+// BenchmarkSplit
+//
+// Runs cFrames frames of the shape given, once whole and once split, checking each split frame against the whole one
+
+static SplitResult BenchmarkSplit(const char * pszName, int cChannels, int cRows, int cColumns, size_t cFrames)
+{
+    SplitResult result = { pszName, cChannels, cRows, cColumns, 0.0, 0.0, 0 };
+
+    SplitRenderer * pRenderer = StartWorker();
+    SplitBenchEffect whole(cChannels, cRows, cColumns);
+    SplitBenchEffect split(cChannels, cRows, cColumns);
+
+    for (size_t i = 0; i < cFrames; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        whole.Draw();
+        auto middle = std::chrono::steady_clock::now();
+        pRenderer->Draw(&split);
+        auto end = std::chrono::steady_clock::now();
+
+        result.wholeMicros += std::chrono::duration<double, std::micro>(middle - start).count();
+        result.splitMicros += std::chrono::duration<double, std::micro>(end - middle).count();
+
+        if (!whole.SameFrameAs(split))
+            result.mismatches++;
+    }
+
+    result.wholeMicros /= cFrames;
+    result.splitMicros /= cFrames;
+    return result;
+}
+
+// RunSplitBenchmark
+//
+// See effectbenchmark.h
+
+int RunSplitBenchmark(size_t cFrames, const char * pszJsonFile)
+{
+    if (cFrames == 0)
+        cFrames = 1;
+
+    SplitResult results[] =
+    {
+        BenchmarkSplit("strip", kStripChannels, 1, kStripLEDs, cFrames),
+        BenchmarkSplit("matrix", 1, kMatrixHeight, kMatrixWidth, cFrames)
+    };
+
+    int cFailed = 0;
+    for (const auto & r : results)
+    {
+        if (r.mismatches)
+            cFailed++;
+
+        debugI("%-6s  %d x %2d x %3d  whole %8.2lfus  split %8.2lfus  (%4.2lfx)  %s",
+               r.name, r.channels, r.rows, r.columns, r.wholeMicros, r.splitMicros, r.wholeMicros / r.splitMicros,
+               r.mismatches ? "MISMATCH" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"frames\": %zu,\n  \"layouts\": [\n", cFrames);
+
+    for (size_t i = 0; i < ARRAYSIZE(results); i++)
+    {
+        const SplitResult & r = results[i];
+        fprintf(pFile, "    { \"name\": \"%s\", \"channels\": %d, \"rows\": %d, \"columns\": %d, \"whole_us\": %.3lf, \"split_us\": %.3lf, \"speedup\": %.2lf, \"mismatched_frames\": %zu }%s\n",
+                r.name, r.channels, r.rows, r.columns, r.wholeMicros, r.splitMicros, r.wholeMicros / r.splitMicros, r.mismatches,
+                i + 1 < ARRAYSIZE(results) ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"mismatched\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
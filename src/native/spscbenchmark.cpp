@@ -0,0 +1,259 @@
+//+--------------------------------------------------------------------------
+//
+// File:        spscbenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Hammers an LEDBufferManager from two threads, one standing in for
+//    the socket task and one for the draw task, and checks every frame
+//    the consumer gets.
+//
+//    Each frame is numbered, and the number is written into its
+//    timestamp and into every one of its pixels.  The consumer checks
+//    that all the pixels agree with the timestamp, over and over for as
+//    long as it holds the buffer, so that a producer writing into a
+//    buffer the consumer still has shows up as a torn frame.  The
+//    numbers must never go backwards, either.  Every so often the
+//    producer sends a frame twice, as a resend would, to keep the path
+//    that drops the duplicate busy too.
+//
+//    Like the draw task, the consumer peeks at the oldest frame and waits
+//    a bit before taking it, and the frame it gets must be the one it saw.
+//
+//    The producer sends in bursts, so the queue both fills, dropping the
+//    frames that don't fit, and drains.  Runs with queue depths from 1
+//    up, since a shallow queue is the one that fills most.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include "globals.h"
+#include "effectbenchmark.h"
+
+static const uint32_t kQueueDepths[] = { 1, 2, 4, 8 };
+static const int      kMaxWaitMicros  = 40;                 // Longest either side goes between frames
+
+struct SPSCResult
+{
+    uint32_t depth;
+    size_t   produced;
+    size_t   consumed;
+    size_t   torn;
+    size_t   outOfOrder;
+    size_t   moved;
+    double   framesPerSecond;
+};
+
+// FrameColor
+//
+// What every pixel of frame number iFrame is set to
+
+static CRGB FrameColor(uint32_t iFrame)
+{
+    return CRGB(iFrame & 0xFF, (iFrame >> 8) & 0xFF, (iFrame >> 16) & 0xFF);
+}
+
+// FillFrame
+//
+// Numbers a frame: the seconds of its timestamp, and every pixel, say which one it is.  The microseconds are left
+// nonzero, since a zero timestamp is never treated as a resend.
+
+static void FillFrame(LEDBuffer * pBuffer, uint32_t iFrame)
+{
+    uint8_t header[LEDBuffer::WireHeaderSize] = { };
+    const uint32_t cPixels = NUM_LEDS;
+    const uint64_t seconds = iFrame;
+    const uint64_t micros  = 1;
+
+    memcpy(&header[4], &cPixels, sizeof(cPixels));
+    memcpy(&header[8], &seconds, sizeof(seconds));
+    memcpy(&header[16], &micros, sizeof(micros));
+    pBuffer->SetFromWireHeader(header);
+
+    CRGB color = FrameColor(iFrame);
+    CRGB * pPixels = pBuffer->Pixels();
+    for (uint32_t i = 0; i < cPixels; i++)
+        pPixels[i] = color;
+}
+
+// IsFrameWhole
+//
+// Whether every pixel still belongs to the frame the timestamp says this is
+
+static bool IsFrameWhole(LEDBuffer * pBuffer)
+{
+    CRGB color = FrameColor((uint32_t) pBuffer->Seconds());
+    const CRGB * pPixels = pBuffer->Pixels();
+    for (uint32_t i = 0; i < pBuffer->Length(); i++)
+        if (pPixels[i] != color)
+            return false;
+    return true;
+}
+
+// Wait
+//
+// Spins for about usWait microseconds; a sleep would take far longer than asked
+
+static void Wait(int usWait)
+{
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(usWait);
+    while (std::chrono::steady_clock::now() < until)
+        std::this_thread::yield();
+}
+
+// StressQueue
+//
+// Pushes cFrames frames through a queue cDepth deep with the producer and consumer on their own threads
+
+static SPSCResult StressQueue(uint32_t cDepth, size_t cFrames)
+{
+    SPSCResult result = { cDepth, 0, 0, 0, 0, 0, 0.0 };
+    LEDBufferManager manager(cDepth, nullptr);
+    std::atomic<bool> bDone(false);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Both sides keep their own seeded RNG for how long they go between frames, so that over a run the producer
+    // sometimes finds the queue full and drops frames and sometimes finds it drained
+
+    std::thread producer([&]()
+    {
+        std::mt19937 rng(cDepth);
+        for (uint32_t iFrame = 1; iFrame <= cFrames; iFrame++)
+        {
+            int cCopies = (iFrame % 7 == 0) ? 2 : 1;
+            for (int i = 0; i < cCopies; i++)
+            {
+                FillFrame(manager.GetNewBuffer(), iFrame);
+                if (manager.CommitNewBuffer())
+                    result.produced++;
+            }
+            Wait(rng() % kMaxWaitMicros);
+        }
+        bDone = true;
+    });
+
+    std::mt19937 rng(cDepth + 1);
+    uint32_t iLastFrame = 0;
+    for (;;)
+    {
+        bool bFinished = bDone;                                 // Read before looking, so nothing queued is missed
+
+        // Look at the oldest frame and give the producer a moment before taking it, as the draw task does when it
+        // checks whether that frame is due yet
+
+        const LEDBuffer * pPeeked = manager.PeekOldestBuffer();
+        uint32_t iPeeked = pPeeked ? (uint32_t) pPeeked->Seconds() : 0;
+        if (pPeeked)
+            Wait(rng() % kMaxWaitMicros);
+
+        LEDBuffer * pBuffer = manager.GetOldestBuffer();
+        if (!pBuffer)
+        {
+            if (bFinished)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        result.consumed++;
+
+        uint32_t iFrame = (uint32_t) pBuffer->Seconds();
+        if (iFrame < iLastFrame)
+            result.outOfOrder++;
+        if (pPeeked && iFrame != iPeeked)
+            result.moved++;
+        iLastFrame = iFrame;
+
+        // Hang on to the buffer for a bit, as the draw task would, checking all the while that it's still whole and
+        // still the same frame
+
+        auto hold = std::chrono::steady_clock::now() + std::chrono::microseconds(rng() % kMaxWaitMicros);
+        bool bWhole;
+        do
+        {
+            bWhole = IsFrameWhole(pBuffer) && pBuffer->Seconds() == iFrame;
+            std::this_thread::yield();                          // Give the producer its chance even on one core
+        } while (bWhole && std::chrono::steady_clock::now() < hold);
+
+        if (!bWhole)
+            result.torn++;
+    }
+
+    producer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.framesPerSecond = seconds > 0 ? result.produced / seconds : 0.0;
+    return result;
+}
+
+// RunSPSCBenchmark
+//
+// See effectbenchmark.h
+
+int RunSPSCBenchmark(size_t cFrames, const char * pszJsonFile)
+{
+    if (cFrames == 0)
+        cFrames = 1;
+
+    std::vector<SPSCResult> results;
+    for (uint32_t cDepth : kQueueDepths)
+        results.push_back(StressQueue(cDepth, cFrames));
+
+    int cFailed = 0;
+    for (const auto & r : results)
+    {
+        bool bFailed = r.torn || r.outOfOrder || r.moved;
+        if (bFailed)
+            cFailed++;
+
+        debugI("depth %u  %8zu produced  %8zu consumed  %8.0lf frames/s  %zu torn  %zu out of order  %zu moved  %s",
+               r.depth, r.produced, r.consumed, r.framesPerSecond, r.torn, r.outOfOrder, r.moved, bFailed ? "FAILED" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"frames\": %zu,\n  \"leds\": %d,\n  \"queues\": [\n", cFrames, NUM_LEDS);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const SPSCResult & r = results[i];
+        fprintf(pFile, "    { \"depth\": %u, \"produced\": %zu, \"consumed\": %zu, \"frames_per_sec\": %.0lf, \"torn\": %zu, \"out_of_order\": %zu, \"moved\": %zu }%s\n",
+                r.depth, r.produced, r.consumed, r.framesPerSecond, r.torn, r.outOfOrder, r.moved,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"failed\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
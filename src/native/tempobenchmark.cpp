@@ -0,0 +1,318 @@
+//+--------------------------------------------------------------------------
+//
+// File:        tempobenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Runs recordings through the same steps the sound analyzer takes in
+//    streaming mode (512 sample windows at 24kHz, a hop of 256, RealFFT
+//    and the loudest bin over NOISE_CUTOFF in each of 16 log spaced
+//    bands) and into a TempoTracker, then scores the beats its clock
+//    ticks against annotated ones.
+//
+//    A beat counts as found if one was annotated within kTolerance of
+//    it, each annotated beat matching at most once, and the score for a
+//    track is the F-measure of those matches.  The first kWarmupSeconds
+//    aren't scored, since the tracker needs that long to lock on.
+//
+//    Recordings are anything ReadAudioFile can load, each with a text
+//    file of beat times in seconds, one per line (anything after the
+//    first number on a line is ignored, so most annotation formats will
+//    do).  Without any, it makes its own drum patterns at a range of
+//    tempos.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+#include "globals.h"
+#include "effectbenchmark.h"
+#include "fftengine.h"
+#include "tempotracker.h"
+#include "fileaudiosource.h"
+
+static const size_t kSamples       = 512;               // Same as SoundAnalyzer's MAX_SAMPLES...
+static const size_t kHop           = 256;               // ...the default AUDIO_HOP_SAMPLES...
+static const double kSampleRate    = 24000.0;           // ...SAMPLING_FREQUENCY...
+static const size_t kBands         = 16;
+static const float  kNoiseCutoff   = 50.0f;             // ...and NOISE_CUTOFF
+static const double kTolerance     = 0.07;              // Seconds either side of an annotated beat
+static const double kWarmupSeconds = 8.0;
+static const double kPassFMeasure  = 0.7;
+
+struct TempoTrack
+{
+    std::string          name;
+    std::vector<int16_t> samples;                       // Mono, at kSampleRate
+    std::vector<double>  beats;                         // Annotated, in seconds
+};
+
+struct TempoResult
+{
+    std::string name;
+    double      annotatedBPM;
+    double      trackedBPM;
+    double      confidence;
+    size_t      cAnnotated;
+    size_t      cTracked;
+    size_t      cMatched;
+    double      fMeasure;
+    double      microsPerPass;
+};
+
+// ReadBeats
+//
+// The first number on each line of an annotation file
+
+static bool ReadBeats(const char * pszFile, std::vector<double> & beats)
+{
+    FILE * pFile = fopen(pszFile, "r");
+    if (!pFile)
+    {
+        debugE("Could not open %s", pszFile);
+        return false;
+    }
+
+    char szLine[256];
+    while (fgets(szLine, sizeof(szLine), pFile))
+    {
+        double seconds;
+        if (sscanf(szLine, "%lf", &seconds) == 1)
+            beats.push_back(seconds);
+    }
+    fclose(pFile);
+
+    std::sort(beats.begin(), beats.end());
+    return true;
+}
+
+// DrumTrack
+//
+// cSeconds of a kick on every beat, a snare on two and four, a hi-hat on every eighth, and a bass note that
+// changes each bar, over a little noise
+
+static TempoTrack DrumTrack(double bpm, double cSeconds)
+{
+    TempoTrack track;
+    track.name = "drums_" + std::to_string((int) bpm);
+
+    const double beatSeconds = 60.0 / bpm;
+    for (double t = 0.0; t < cSeconds; t += beatSeconds)
+        track.beats.push_back(t);
+
+    track.samples.resize((size_t)(cSeconds * kSampleRate));
+    for (size_t i = 0; i < track.samples.size(); i++)
+    {
+        const double t      = i / kSampleRate;
+        const double beat   = t / beatSeconds;
+        const int    iBeat  = (int) beat;
+        const double sinceBeat   = (beat - iBeat) * beatSeconds;
+        const double sinceEighth = fmod(beat * 2.0, 1.0) * beatSeconds / 2.0;
+
+        double sample = 0.0;
+        sample += 0.6 * exp(-sinceBeat * 25.0) * sin(2 * M_PI * (50.0 + 80.0 * exp(-sinceBeat * 40.0)) * sinceBeat);
+        if (iBeat % 2 == 1)
+            sample += 0.3 * exp(-sinceBeat * 18.0) * (random(0, 65536) - 32768) / 32768.0;
+        sample += 0.1 * exp(-sinceEighth * 60.0) * (random(0, 65536) - 32768) / 32768.0;
+        sample += 0.1 * sin(2 * M_PI * (55.0 * (1 + (iBeat / 4) % 3)) * t);
+        sample += 0.02 * (random(0, 65536) - 32768) / 32768.0;
+
+        track.samples[i] = (int16_t) constrain(sample * 32767.0, -32768.0, 32767.0);
+    }
+    return track;
+}
+
+// BandCutoffs
+//
+// The same log spaced cutoffs, from 200Hz to Nyquist, as SoundAnalyzer::CalculateBandCutoffs
+
+static std::vector<float> BandCutoffs()
+{
+    std::vector<float> cutoffs;
+    double freq = 200.0, df = pow(kSampleRate / 2.0 / freq, 1.0 / (kBands - 1));
+    for (size_t i = 0; i < kBands; i++, freq *= df)
+        cutoffs.push_back(freq);
+    return cutoffs;
+}
+
+// MedianBPM
+//
+// The tempo of the median gap between annotated beats
+
+static double MedianBPM(const std::vector<double> & beats)
+{
+    std::vector<double> gaps;
+    for (size_t i = 1; i < beats.size(); i++)
+        gaps.push_back(beats[i] - beats[i - 1]);
+    if (gaps.empty())
+        return 0.0;
+    std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2, gaps.end());
+    return 60.0 / gaps[gaps.size() / 2];
+}
+
+// TrackTempo
+//
+// Runs a track through the analyzer's steps and the tracker and scores the beats it ticks
+
+static TempoResult TrackTempo(const TempoTrack & track, RealFFT & fft, const std::vector<float> & cutoffs)
+{
+    TempoTracker tracker(kNoiseCutoff);
+    std::vector<float> magnitudes(kSamples), levels(kBands);
+    std::vector<double> ticked;
+
+    size_t cPasses = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t iEnd = kSamples; iEnd <= track.samples.size(); iEnd += kHop, cPasses++)
+    {
+        for (size_t i = 0; i < kSamples; i++)
+            magnitudes[i] = track.samples[iEnd - kSamples + i];
+        fft.Magnitudes(magnitudes.data(), magnitudes.data());
+
+        std::fill(levels.begin(), levels.end(), 0.0f);
+        for (size_t i = 2; i < kSamples / 2; i++)
+        {
+            float freq = (i - 2) * (kSampleRate / 2) / (kSamples / 2);
+            size_t iBand = 0;
+            while (iBand < kBands - 1 && freq >= cutoffs[iBand])
+                iBand++;
+            if (magnitudes[i] > kNoiseCutoff)
+                levels[iBand] = std::max(levels[iBand], magnitudes[i]);
+        }
+
+        const double seconds = iEnd / kSampleRate;
+        const uint32_t cBeats = tracker.BeatCount();
+        tracker.Update(levels.data(), kBands, seconds);
+        if (tracker.BeatCount() != cBeats)
+            ticked.push_back(seconds);
+    }
+
+    const double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // Match each ticked beat to the nearest unmatched annotated one within the tolerance
+
+    std::vector<double> annotated;
+    for (double beat : track.beats)
+        if (beat >= kWarmupSeconds)
+            annotated.push_back(beat);
+    ticked.erase(std::remove_if(ticked.begin(), ticked.end(), [](double t) { return t < kWarmupSeconds; }), ticked.end());
+
+    std::vector<bool> bUsed(annotated.size(), false);
+    size_t cMatched = 0;
+    for (double tick : ticked)
+    {
+        auto it = std::lower_bound(annotated.begin(), annotated.end(), tick - kTolerance);
+        for (; it != annotated.end() && *it <= tick + kTolerance; ++it)
+        {
+            size_t i = it - annotated.begin();
+            if (!bUsed[i])
+            {
+                bUsed[i] = true;
+                cMatched++;
+                break;
+            }
+        }
+    }
+
+    TempoResult result;
+    result.name          = track.name;
+    result.annotatedBPM  = MedianBPM(track.beats);
+    result.trackedBPM    = tracker.BPM();
+    result.confidence    = tracker.Confidence();
+    result.cAnnotated    = annotated.size();
+    result.cTracked      = ticked.size();
+    result.cMatched      = cMatched;
+    result.fMeasure      = annotated.empty() || ticked.empty() ? 0.0 : 2.0 * cMatched / (annotated.size() + ticked.size());
+    result.microsPerPass = cPasses ? micros / cPasses : 0.0;
+    return result;
+}
+
+// RunTempoBenchmark
+//
+// See effectbenchmark.h
+
+int RunTempoBenchmark(const std::vector<std::pair<const char *, const char *>> & recordings, const char * pszJsonFile)
+{
+    randomSeed(1337);
+
+    std::vector<TempoTrack> tracks;
+    for (const auto & recording : recordings)
+    {
+        TempoTrack track;
+        track.name = recording.first;
+        if (!ReadAudioFile(recording.first, kSampleRate, track.samples) || !ReadBeats(recording.second, track.beats))
+            return -1;
+        tracks.push_back(std::move(track));
+    }
+
+    if (tracks.empty())
+        for (double bpm : { 84.0, 96.0, 110.0, 120.0, 128.0, 140.0 })
+            tracks.push_back(DrumTrack(bpm, 40.0));
+
+    RealFFT fft(kSamples);
+    const std::vector<float> cutoffs = BandCutoffs();
+
+    std::vector<TempoResult> results;
+    int cFailed = 0;
+
+    for (const auto & track : tracks)
+    {
+        results.push_back(TrackTempo(track, fft, cutoffs));
+        const TempoResult & r = results.back();
+        bool bFailed = r.fMeasure < kPassFMeasure;
+        if (bFailed)
+            cFailed++;
+
+        debugI("%-24s annotated %6.1lf BPM  tracked %6.1lf BPM (confidence %.2lf)  beats %3zu/%3zu/%3zu  F %.3lf  %6.2lfus/pass  %s",
+               r.name.c_str(), r.annotatedBPM, r.trackedBPM, r.confidence, r.cMatched, r.cTracked, r.cAnnotated,
+               r.fMeasure, r.microsPerPass, bFailed ? "FAIL" : "ok");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"sample_rate\": %.0lf,\n  \"hop\": %zu,\n  \"tolerance_s\": %.3lf,\n  \"tracks\": [\n",
+            kSampleRate, kHop, kTolerance);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const TempoResult & r = results[i];
+        fprintf(pFile, "    { \"name\": ");
+        WriteJsonString(pFile, r.name.c_str());
+        fprintf(pFile, ", \"annotated_bpm\": %.2lf, \"tracked_bpm\": %.2lf, \"confidence\": %.3lf, \"annotated\": %zu, "
+                       "\"tracked\": %zu, \"matched\": %zu, \"f_measure\": %.3lf, \"us_per_pass\": %.3lf }%s\n",
+                r.annotatedBPM, r.trackedBPM, r.confidence, r.cAnnotated, r.cTracked, r.cMatched, r.fMeasure,
+                r.microsPerPass, i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"failed\": %d\n}\n", cFailed);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cFailed;
+}
@@ -0,0 +1,97 @@
+//+--------------------------------------------------------------------------
+//
+// File:        virtualledsink.h
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    A FastLED controller with no wire on the other end.  It gets added to
+//    FastLED in place of the WS2812B clockless driver, so FastLED.show()
+//    hands it the final, brightness-scaled pixels exactly as they would
+//    have gone out to the strip, and it keeps them in memory.
+//
+// History:     Oct-16-2026         Davepl      Created for the native build
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdio.h>
+#include <vector>
+#include "globals.h"
+
+class VirtualLEDSink : public CPixelLEDController<RGB>
+{
+    std::vector<CRGB> _frame;
+    size_t            _cFrames = 0;
+    FILE *            _pDump   = nullptr;
+
+  protected:
+
+    virtual void init() override
+    {
+    }
+
+    // showPixels
+    //
+    // Called by FastLED.show() with the pixels already scaled by brightness and color correction
+
+    virtual void showPixels(PixelController<RGB> & pixels) override
+    {
+        _frame.resize(pixels.size());
+
+        CRGB * pOut = _frame.data();
+        while (pixels.has(1))
+        {
+            pOut->r = pixels.loadAndScale0();
+            pOut->g = pixels.loadAndScale1();
+            pOut->b = pixels.loadAndScale2();
+            pixels.advanceData();
+            pixels.stepDithering();
+            pOut++;
+        }
+
+        if (_pDump)
+            fwrite(_frame.data(), sizeof(CRGB), _frame.size(), _pDump);
+
+        _cFrames++;
+    }
+
+  public:
+
+    // DumpTo
+    //
+    // Appends every frame shown from now on to the given file as raw RGB triplets
+
+    void DumpTo(FILE * pFile)
+    {
+        _pDump = pFile;
+    }
+
+    const std::vector<CRGB> & Frame() const
+    {
+        return _frame;
+    }
+
+    size_t FrameCount() const
+    {
+        return _cFrames;
+    }
+};
@@ -0,0 +1,311 @@
+//+--------------------------------------------------------------------------
+//
+// File:        wirebenchmark.cpp
+//
+// NightDriverStrip - (c) 2018 Plummer's Software LLC.  All Rights Reserved.
+//
+// This file is part of the NightDriver software project.
+//
+//    NightDriver is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    NightDriver is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with Nightdriver.  It is normally found in copying.txt
+//    If not, see <https://www.gnu.org/licenses/>.
+//
+// Description:
+//
+//    Compares the ways a frame can travel over the wire: raw PIXELDATA64,
+//    zlib compressed (the COMPRESSED_HEADER path), and PIXELDELTA64 spans.
+//    The frames are the project's own effects, rendered repeatably, and
+//    for each we report bytes on the air per frame and how long the
+//    receiving side spends decoding it.
+//
+//    The delta stream is sent the way a sender would: the first frame,
+//    and any whose delta comes out bigger, go raw.  Every frame decoded
+//    is checked against the original, and so are the power totals it
+//    picked up on the way in, since the output stage limits the power
+//    from those alone without scanning the LEDs.  Now and then a delta
+//    against a frame that never arrived is sent too, and it has to be
+//    refused.
+//
+//    The zlib numbers use uzlib's own compressor, which is quicker and a
+//    little weaker than real zlib, so treat those sizes as an upper bound.
+//
+// History:     Oct-16-2026         Davepl      Created
+//
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include "globals.h"
+#include "effectbenchmark.h"
+#include "deltaencoder.h"
+
+extern "C"
+{
+    #include "uzlib/src/uzlib.h"
+}
+
+extern DRAM_ATTR std::unique_ptr<EffectManager<GFXBase>> g_aptrEffectManager;
+
+// CompressZlib
+//
+// Wraps uzlib's raw deflate output in the zlib header and Adler-32 trailer that the receiver expects
+
+static void CompressZlib(const std::vector<uint8_t> & input, std::vector<uint8_t> & output)
+{
+    struct uzlib_comp comp = { 0 };
+    comp.dict_size = 32768;
+    comp.hash_bits = 12;
+
+    std::vector<uzlib_hash_entry_t> hashTable(1 << comp.hash_bits);
+    comp.hash_table = hashTable.data();
+
+    zlib_start_block(&comp.out);
+    uzlib_compress(&comp, input.data(), input.size());
+    zlib_finish_block(&comp.out);
+
+    uint32_t adler = uzlib_adler32(input.data(), input.size(), 1);
+
+    output.assign({ 0x78, 0x01 });
+    output.insert(output.end(), comp.out.outbuf, comp.out.outbuf + comp.out.outlen);
+    for (int shift = 24; shift >= 0; shift -= 8)
+        output.push_back((uint8_t)(adler >> shift));
+
+    free(comp.out.outbuf);
+}
+
+// InflateZlib
+//
+// What the socket server does with a compressed packet, minus the socket
+
+static bool InflateZlib(const std::vector<uint8_t> & input, uint8_t * pOutput, size_t cbOutput)
+{
+    struct uzlib_uncomp d = { 0 };
+    uzlib_uncompress_init(&d, NULL, 0);
+
+    d.source         = input.data();
+    d.source_limit   = input.data() + input.size();
+    d.source_read_cb = nullptr;
+    d.dest_start     = pOutput;
+    d.dest           = pOutput;
+    d.dest_limit     = pOutput + cbOutput + 1;
+
+    return uzlib_zlib_parse_header(&d) >= 0 && uzlib_uncompress_chksum(&d) == TINF_DONE && (size_t)(d.dest - pOutput) == cbOutput;
+}
+
+struct WireResult
+{
+    String  name;
+    double  rawBytes    = 0;
+    double  zlibBytes   = 0;
+    double  deltaBytes  = 0;
+    double  zlibMicros  = 0;
+    double  deltaMicros = 0;
+    size_t  cMismatches = 0;
+};
+
+static void PutLE(std::vector<uint8_t> & out, uint64_t value, size_t cb)
+{
+    for (size_t i = 0; i < cb; i++)
+        out.push_back((uint8_t)(value >> (8 * i)));
+}
+
+template <typename F> static double TimeMicros(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// SumsMatchScan
+//
+// Whether the totals a frame picked up while it was decoded are those of its pixels, and give the output stage the
+// same power limit and wattage as its own scan would.  With the totals, nothing on the draw task looks at the pixels
+// before FastLED clocks them out, so they had better be right.
+
+static bool SumsMatchScan(LEDBuffer * pBuffer)
+{
+    static OutputStage scanned, summed;
+
+    PixelSums scan;
+    scan.Add(pBuffer->Pixels(), pBuffer->Length());
+
+    const PixelSums & sums = pBuffer->Sums();
+    if (sums.red != scan.red || sums.green != scan.green || sums.blue != scan.blue || sums.count != scan.count)
+        return false;
+
+    CRGB * apLEDs[NUM_CHANNELS];
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        apLEDs[i] = pBuffer->Pixels();
+        summed.SetChannelSums(i, sums);
+    }
+
+    uint8_t scannedBrightness = scanned.Process(apLEDs, pBuffer->Length(), 255, POWER_LIMIT_MW);
+    uint8_t summedBrightness  = summed.Process(apLEDs, pBuffer->Length(), 255, POWER_LIMIT_MW);
+
+    return scannedBrightness == summedBrightness
+        && scanned.UnscaledMilliwatts() == summed.UnscaledMilliwatts();
+}
+
+// BenchmarkEffectOnWire
+//
+// Renders cFrames frames of one effect and sends each of them all three ways
+
+static WireResult BenchmarkEffectOnWire(size_t iEffect, size_t cFrames)
+{
+    LEDStripEffect * pEffect = StartRepeatableEffect(iEffect);
+    const CRGB * pLEDs = ((LEDStripGFX *)g_aptrDevices[0].get())->leds;
+    const size_t cPixels = g_aptrDevices[0]->GetLEDCount();
+
+    WireResult result;
+    result.name = pEffect->FriendlyName();
+
+    // The frames go through a buffer manager, as they would on the chip, so that each delta is checked against the
+    // last frame queued.  The consumer takes each frame straight back out to compare it with what was sent.
+
+    LEDBufferManager manager(1, g_aptrDevices[0]);
+
+    std::vector<uint8_t> previous, raw, compressed, delta, stale;
+    std::vector<uint8_t> inflated(LEDBuffer::WireStorageSize);
+    uint64_t baseSeconds = 0, baseMicros = 0;
+
+    for (size_t iFrame = 0; iFrame < cFrames; iFrame++)
+    {
+        DrawRepeatableFrame(pEffect);
+
+        const uint8_t * pFrame = (const uint8_t *) pLEDs;
+        uint64_t seconds = iFrame / 60, micros = (iFrame % 60) * 16667;
+
+        raw.clear();
+        PutLE(raw, WIFI_COMMAND_PIXELDATA64, 2);
+        PutLE(raw, 1, 2);
+        PutLE(raw, cPixels, 4);
+        PutLE(raw, seconds, 8);
+        PutLE(raw, micros, 8);
+        raw.insert(raw.end(), pFrame, pFrame + cPixels * sizeof(CRGB));
+
+        CompressZlib(raw, compressed);
+
+        delta.clear();
+        size_t cbDelta = EncodeDeltaFrame(delta, pFrame, cPixels, previous.data(), previous.size() / sizeof(CRGB), 1, seconds, micros, baseSeconds, baseMicros);
+
+        // The first frame has nothing to be a delta against, and the sender falls back to raw if the delta is bigger
+
+        bool bSendRaw = iFrame == 0 || cbDelta >= raw.size();
+
+        result.rawBytes   += raw.size();
+        result.zlibBytes  += STANDARD_DATA_HEADER_SIZE + compressed.size();        // The compressed header takes the first 24 bytes
+        result.deltaBytes += bSendRaw ? raw.size() : cbDelta;
+
+        result.zlibMicros += TimeMicros([&]() { InflateZlib(compressed, inflated.data(), raw.size()); });
+
+        // Now and then, a delta against a frame that never arrived here, as if a datagram had been lost, which has to
+        // be refused.  The channel then asks for a full frame until the next one is queued.
+
+        if (!bSendRaw && iFrame % 16 == 0)
+        {
+            stale.clear();
+            EncodeDeltaFrame(stale, pFrame, cPixels, previous.data(), previous.size() / sizeof(CRGB), 1, seconds, micros, baseSeconds, baseMicros + 1);
+            if (manager.DeltaBase(stale.data(), stale.size()))
+                result.cMismatches++;
+            manager.RequestKeyframe();
+        }
+
+        LEDBuffer * pBuffer = manager.GetNewBuffer();
+        bool bDecoded = false;
+        if (bSendRaw)
+        {
+            result.deltaMicros += TimeMicros([&]() { bDecoded = pBuffer->UpdateFromWire(raw.data(), raw.size()); });
+        }
+        else
+        {
+            auto pBase = manager.DeltaBase(delta.data(), delta.size());
+            result.deltaMicros += TimeMicros([&]() { bDecoded = pBase && pBuffer->UpdateFromDelta(delta.data(), delta.size(), pBase); });
+        }
+
+        bDecoded = bDecoded && manager.CommitNewBuffer() && !manager.KeyframeWanted();
+        pBuffer = manager.GetOldestBuffer();
+
+        if (!bDecoded || !pBuffer || pBuffer->Length() != cPixels || memcmp(pBuffer->Pixels(), pFrame, cPixels * sizeof(CRGB))
+            || !SumsMatchScan(pBuffer))
+            result.cMismatches++;
+
+        previous.assign(pFrame, pFrame + cPixels * sizeof(CRGB));
+        baseSeconds = seconds;
+        baseMicros  = micros;
+    }
+
+    NativeClockRelease();
+
+    result.rawBytes    /= cFrames;
+    result.zlibBytes   /= cFrames;
+    result.deltaBytes  /= cFrames;
+    result.zlibMicros  /= cFrames;
+    result.deltaMicros /= cFrames;
+    return result;
+}
+
+// RunWireBenchmark
+//
+// See effectbenchmark.h
+
+int RunWireBenchmark(size_t cFrames, const char * pszJsonFile)
+{
+    if (cFrames == 0)
+        cFrames = 1;
+
+    uzlib_init();
+
+    std::vector<WireResult> results;
+    int cMismatched = 0;
+
+    for (size_t i = 0; i < g_aptrEffectManager->EffectCount(); i++)
+    {
+        results.push_back(BenchmarkEffectOnWire(i, cFrames));
+        const WireResult & r = results.back();
+        if (r.cMismatches)
+            cMismatched++;
+
+        debugI("%3zu %-32s raw %7.0lf  zlib %7.0lf (%7.1lfus)  delta %7.0lf (%7.1lfus)%s",
+               i, r.name.c_str(), r.rawBytes, r.zlibBytes, r.zlibMicros, r.deltaBytes, r.deltaMicros,
+               r.cMismatches ? "  DECODE MISMATCH" : "");
+    }
+
+    FILE * pFile = pszJsonFile ? fopen(pszJsonFile, "w") : stdout;
+    if (!pFile)
+    {
+        debugE("Could not open %s for writing", pszJsonFile);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n  \"project\": ");
+    WriteJsonString(pFile, PROJECT_NAME);
+    fprintf(pFile, ",\n  \"leds\": %d,\n  \"frames\": %zu,\n  \"effects\": [\n", NUM_LEDS, cFrames);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const WireResult & r = results[i];
+        fprintf(pFile, "    { \"index\": %zu, \"name\": ", i);
+        WriteJsonString(pFile, r.name.c_str());
+        fprintf(pFile, ", \"raw_bytes\": %.1lf, \"zlib_bytes\": %.1lf, \"delta_bytes\": %.1lf, "
+                       "\"zlib_decode_us\": %.2lf, \"delta_decode_us\": %.2lf, \"mismatches\": %zu }%s\n",
+                r.rawBytes, r.zlibBytes, r.deltaBytes, r.zlibMicros, r.deltaMicros, r.cMismatches,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ],\n  \"mismatched\": %d\n}\n", cMismatched);
+
+    if (pFile != stdout)
+        fclose(pFile);
+
+    return cMismatched;
+}
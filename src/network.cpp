@@ -45,7 +45,8 @@ DRAM_ATTR ESP_WiFiManager g_WifiManager("NightDriverWiFi");
 
 extern DRAM_ATTR std::unique_ptr<LEDBufferManager> g_aptrBufferManager[NUM_CHANNELS];
 
-std::mutex g_buffer_mutex;
+std::mutex g_producer_mutex;
+
 String WiFi_ssid;
 String WiFi_password;
 
@@ -59,7 +60,8 @@ extern uint32_t g_FPS;
 // processRemoteDebugCmd
 // 
 // Callback function that the debug library (which exposes a little console over telnet and serial) calls
-// in order to allow us to add custom commands.  I've added a clock reset and stats command, for example.
+// in order to allow us to add custom commands.  I've added a clock reset and stats command, for example, and
+// "tasks" prints the per-task busy time, draw stage timings and frame scratch use that /getTaskStatistics serves.
 
 #if ENABLE_WIFI
     void processRemoteDebugCmd() 
@@ -81,6 +83,7 @@ extern uint32_t g_FPS;
             debugI("%sdB:%s\n",String(WiFi.RSSI()).substring(1).c_str(), WiFi.isConnected() ? WiFi.localIP().toString().c_str() : "None");
             debugI("BUFR:%02d/%02d [%dfps]\n", g_aptrBufferManager[0]->Depth(), g_aptrBufferManager[0]->BufferCount(), g_FPS);
             debugI("DATA:%+04.2lf-%+04.2lf\n", g_aptrBufferManager[0]->AgeOfOldestBuffer(), g_aptrBufferManager[0]->AgeOfNewestBuffer());
+            debugI("COPY:%u frames, %.1lf bytes copied per frame\n", g_cIngestFrames.load(), g_cIngestFrames ? g_cbIngestCopied / (double) g_cIngestFrames : 0.0);
 
             #if ENABLE_AUDIO
                 debugI("g_Analyzer._VU: %.2f, g_Analyzer._MinVU: %.2f, g_Analyzer.g_Analyzer._PeakVU: %.2f, g_Analyzer.gVURatio: %.2f", g_Analyzer._VU, g_Analyzer._MinVU, g_Analyzer._PeakVU, g_Analyzer._VURatio);
@@ -90,17 +93,46 @@ extern uint32_t g_FPS;
                 debugI("Socket Buffer _cbReceived: %d", g_SocketServer._cbReceived);
             #endif
 
+            #if INCOMING_WIFI_ENABLED && INCOMING_UDP_ENABLED
+                debugI("UDP Datagrams: %zu, dropped: %zu", g_UDPServer._cDatagrams, g_UDPServer._cDropped);
+            #endif
+
             // Print out a buffer log with timestamps and deltas 
             
             for (size_t i = 0; i < g_aptrBufferManager[0]->Depth(); i++)
             {
                 auto pBufferManager = g_aptrBufferManager[0].get();
-                std::shared_ptr<LEDBuffer> pBuffer = (*pBufferManager)[i];
+                auto pBuffer = (*pBufferManager)[i];
+                if (!pBuffer)
+                    break;
                 double t = pBuffer->Seconds() + (double) pBuffer->MicroSeconds() / MICROS_PER_SECOND;
                 debugI("Frame: %03d, Clock: %lf, Offset: %lf", i, t, g_AppTime.CurrentTime() - t);
             }
 
         }
+        else if (str.equalsIgnoreCase("tasks"))
+        {
+            NightDriverTaskManager::TaskStatistics aTasks[NightDriverTaskManager::TaskCount];
+            g_TaskManager.GetTaskStatistics(aTasks);
+
+            debugI("Task        CPU%%      Busy (ms)  Stack free");
+            for (const auto & task : aTasks)
+                if (task.running)
+                    debugI("%-8s  %6.2f  %12llu  %10u", task.name, task.cpuPercent, (unsigned long long)(task.busyMicros / 1000), task.stackFree);
+
+            FrameTimings::StageSummary aStages[FrameTimings::StageCount + 1];
+            size_t cFrames = g_FrameTimings.Summarize(aStages);
+
+            debugI("Draw stages over the last %zu frames (us):", cFrames);
+            for (int i = 0; i <= FrameTimings::StageCount; i++)
+                debugI("%-14s  mean %7u  max %7u", i < FrameTimings::StageCount ? FrameTimings::StageNames[i] : "Total", aStages[i].usMean, aStages[i].usMax);
+
+            for (int i = 0; i < NUM_CHANNELS; i++)
+            {
+                auto & scratch = g_aptrDevices[i]->Scratch();
+                debugI("Channel %d scratch: %zu bytes, high water %zu, %u spills", i, scratch.Capacity(), scratch.HighWater(), scratch.Spills());
+            }
+        }
     }
 #endif
 
@@ -198,7 +230,10 @@ void IRAM_ATTR RemoteLoopEntry(void *)
     g_RemoteControl.begin();
     while (true)
     {
-        g_RemoteControl.handle();
+        {
+            TaskBusyTimer busy;
+            g_RemoteControl.handle();
+        }
         delay(20);        
     }
 }
@@ -298,6 +333,92 @@ void IRAM_ATTR RemoteLoopEntry(void *)
     
 #endif
 
+// ChannelMaskFromHeader
+//
+// The very old original implementation used channel numbers, not a mask, and only channel 0 was supported at that
+// time, so if we see a Channel 0 asked for, it must be very old, and we massage it into the mask for Channel0 instead.
+// Another option here would be to draw on all channels (0xff) instead of just one (0x01) if 0 is specified.
+
+static uint16_t ChannelMaskFromHeader(const uint8_t * pHeader)
+{
+    uint16_t channel16 = WORDFromMemory(&pHeader[2]);
+    return channel16 == 0 ? 1 : channel16;
+}
+
+static int FirstChannelInMask(uint16_t channel16)
+{
+    for (int iChannel = 0; iChannel < NUM_CHANNELS; iChannel++)
+        if (channel16 & (1 << iChannel))
+            return iChannel;
+    return -1;
+}
+
+// ManagerForHeader
+//
+// The buffer manager of the first channel in a pixel header's mask, which is the one that gets decoded into
+
+static LEDBufferManager * ManagerForHeader(const uint8_t * pHeader)
+{
+    int iChannel = FirstChannelInMask(ChannelMaskFromHeader(pHeader));
+    if (iChannel < 0)
+    {
+        debugW("Pixel data addressed to channel mask %04x, but we only have %d channels", ChannelMaskFromHeader(pHeader), NUM_CHANNELS);
+        return nullptr;
+    }
+    return g_aptrBufferManager[iChannel].get();
+}
+
+// BeginIncomingPixelData
+//
+// Given a WIFI_COMMAND_PIXELDATA64 header, returns the buffer the pixels should be written into: the next free
+// buffer of the first channel in the mask.  The caller fills its Pixels() with Length() CRGBs, straight from the
+// socket or the decompressor, and then calls EndIncomingPixelData.  Returns nullptr if the header is no good.
+
+LEDBuffer * BeginIncomingPixelData(const uint8_t * pHeader)
+{
+    auto pManager = ManagerForHeader(pHeader);
+    if (!pManager)
+        return nullptr;
+
+    auto pBuffer = pManager->GetNewBuffer();
+    return pBuffer->SetFromWireHeader(pHeader) ? pBuffer : nullptr;
+}
+
+// EndIncomingPixelData
+//
+// Queues a buffer filled after BeginIncomingPixelData.  Go through the channel mask to see which bits are set
+// in the channel16 specifier, and send the data to each and every channel that matches the mask.  So if they send
+// channel 7, that means the lowest 3 channels will be set.  Only the extra channels cost a copy.
+
+bool EndIncomingPixelData(LEDBuffer * pBuffer)
+{
+    TaskBusyTimer busy;
+
+    uint16_t channel16 = ChannelMaskFromHeader(pBuffer->WireHeader());
+    int iFirst = FirstChannelInMask(channel16);
+
+    // Frames that went straight from the socket into the buffer are added up here, before any copies are made,
+    // so that the draw task doesn't have to
+
+    pBuffer->SumPixels();
+
+    for (int iChannel = iFirst + 1; iChannel < NUM_CHANNELS; iChannel++)
+    {
+        if (channel16 & (1 << iChannel))
+        {
+            debugV("Copying frame to Channel %d", iChannel);
+            g_aptrBufferManager[iChannel]->GetNewBuffer()->CopyFrom(*pBuffer);
+            g_aptrBufferManager[iChannel]->CommitNewBuffer();
+        }
+    }
+
+    // Queued last, since the copies above read from it and it's ours only until it's committed
+
+    bool bCommitted = g_aptrBufferManager[iFirst]->CommitNewBuffer();
+    g_FrameScheduler.NotifyFrameArrived();
+    return bCommitted;
+}
+
 // ProcessIncomingData
 //
 // Code that actually handles whatever comes in on the socket.  Must be known good data
@@ -306,6 +427,8 @@ void IRAM_ATTR RemoteLoopEntry(void *)
 
 bool ProcessIncomingData(uint8_t *payloadData, size_t payloadLength)
 {
+    TaskBusyTimer busy;
+
     #if !INCOMING_WIFI_ENABLED
         return false;
     #else
@@ -358,47 +481,39 @@ bool ProcessIncomingData(uint8_t *payloadData, size_t payloadLength)
                    seconds, 
                    micros);
 
-            // Another option here would be to draw on all channels (0xff) instead of just one (0x01) if 0 is specified
-            
-            if (channel16 == 0)
-                channel16 = 1;
+            //if (!heap_caps_check_integrity_all(true))
+            //    debugW("### Corrupt heap detected in WIFI_COMMAND_PIXELDATA64");
 
-            // Go through the channel mask to see which bits are set in the channel16 specifier, and send the data to each and every
-            // channel that matches the mask.  So if the send channel 7, that means the lowest 3 channels will be set.
+            // The buffer isn't visible to the draw task until it's committed, so a bad packet never reaches the
+            // queue.  A resend of a frame that's already queued (same timestamp) is queued again, and the draw
+            // side keeps only the newest copy.
 
-            std::lock_guard<std::mutex> guard(g_buffer_mutex);
+            auto pBuffer = BeginIncomingPixelData(payloadData);
+            if (!pBuffer || !pBuffer->UpdateFromWire(payloadData, payloadLength))
+                return false;
 
-            //if (!heap_caps_check_integrity_all(true))
-            //    debugW("### Corrupt heap detected in WIFI_COMMAND_PIXELDATA64");
+            return EndIncomingPixelData(pBuffer);
+        }
 
-            for (int iChannel = 0, channelMask = 1; iChannel < NUM_CHANNELS; iChannel++, channelMask <<= 1)
+        // WIFI_COMMAND_PIXELDELTA64 has a header, the timestamp of the frame it's against, and length32 bytes of spans
+        // to apply to that frame.  If that isn't the channel's last frame, or the spans don't decode, the delta is
+        // refused and the channel asks for a full frame, since every delta after it would be against the wrong one.
+
+        case WIFI_COMMAND_PIXELDELTA64:
+        {
+            auto pManager = ManagerForHeader(payloadData);
+            if (!pManager)
+                return false;
+
+            auto pBase   = pManager->DeltaBase(payloadData, payloadLength);
+            auto pBuffer = pManager->GetNewBuffer();
+            if (!pBase || !pBuffer->UpdateFromDelta(payloadData, payloadLength, pBase))
             {
-                if ((channelMask & channel16) != 0)
-                {
-                    debugV("Processing for Channel %d", iChannel);
-                    
-                    bool bDone = false;
-                    if (!g_aptrBufferManager[iChannel]->IsEmpty())
-                    {
-                        auto pNewestBuffer = g_aptrBufferManager[iChannel]->PeekNewestBuffer();
-                        if (micros != 0 && pNewestBuffer->MicroSeconds() == micros && pNewestBuffer->Seconds() == seconds)
-                        {
-                            debugV("Updating existing buffer");
-                            if (!pNewestBuffer->UpdateFromWire(payloadData, payloadLength))
-                                return false;
-                            bDone = true;
-                        }
-                    }
-                    if (!bDone)
-                    {
-                        debugV("No match so adding new buffer");
-                        auto pNewBuffer = g_aptrBufferManager[iChannel]->GetNewBuffer();
-                        if (!pNewBuffer->UpdateFromWire(payloadData, payloadLength))
-                            return false;
-                    }
-                }
+                pManager->RequestKeyframe();
+                return false;
             }
-            return true;
+
+            return EndIncomingPixelData(pBuffer);
         }
 
         default:
@@ -329,7 +329,8 @@ void CurrentEffectSummary(bool bRedraw)
     float ySizeVU = Screen::screenHeight() / 16; // vu is 1/20th the screen height, height of each block
     int cPixels = 16;
     float xSize = xHalf / cPixels + 1;               // xSize is count of pixels in each block
-    int litBlocks = (g_Analyzer._VURatioFade / 2.0f) * cPixels; // litPixels is number that are lit
+    const AudioFrame frame = g_Analyzer.GetAudioFrame();
+    int litBlocks = (frame.vuRatioFade / 2.0f) * cPixels; // litPixels is number that are lit
 
     for (int iPixel = 0; iPixel < cPixels; iPixel++) // For each pixel
     {
@@ -348,10 +349,10 @@ void CurrentEffectSummary(bool bRedraw)
         CRGB bandColor = ColorFromPalette(RainbowColors_p, (::map(iBand, 0, NUM_BANDS, 0, 255) + 0) % 256);
         int bandWidth = Screen::screenWidth() / NUM_BANDS;
         auto color16 = Screen::to16bit(bandColor);
-        auto topSection = bandHeight - bandHeight * g_Analyzer.g_peak2Decay[iBand];
+        auto topSection = bandHeight - bandHeight * frame.peak2Decay[iBand];
         if (topSection > 0)
             Screen::fillRect(iBand * bandWidth, spectrumTop, bandWidth - 1, topSection, BLACK16);
-        auto val = min(1.0f, g_Analyzer.g_peak2Decay[iBand]);
+        auto val = min(1.0f, frame.peak2Decay[iBand]);
         assert(bandHeight * val <= bandHeight);
         Screen::fillRect(iBand * bandWidth, spectrumTop + topSection, bandWidth - 1, bandHeight - topSection, color16);
     }
@@ -435,6 +436,9 @@ void IRAM_ATTR ScreenUpdateLoopEntry(void *)
     bool bRedraw = true;                            
     for (;;)
     {
+        {
+            TaskBusyTimer busy;
+
             // bRedraw is set when the page changes so that it can get a full redraw.  It is also set initially as
             // nothing has been drawn for any page yet
             
@@ -461,11 +465,13 @@ void IRAM_ATTR ScreenUpdateLoopEntry(void *)
             #endif
 
             UpdateScreen(bRedraw);
-            if (g_bUpdateStarted)
-                delay(200);
-            else
-                delay(50);
-            
-            bRedraw = false;
+        }
+
+        if (g_bUpdateStarted)
+            delay(200);
+        else
+            delay(50);
+
+        bRedraw = false;
     }
 }